@@ -15,6 +15,22 @@
 #define VECTOR4_ALIGN( v )			__declspec( align( 16 ) ) v
 #endif
 
+#if defined( __GNUC__ )
+#define LIBNOISE2_THREAD_LOCAL		__thread
+#elif defined( _MSC_VER )
+#define LIBNOISE2_THREAD_LOCAL		__declspec( thread )
+#endif
+
+// Increment and decrement a volatile long and give the new value, atomically
+#if defined( __GNUC__ )
+#define LIBNOISE2_ATOMIC_INCREMENT( v )		__sync_add_and_fetch( &(v), 1L )
+#define LIBNOISE2_ATOMIC_DECREMENT( v )		__sync_sub_and_fetch( &(v), 1L )
+#elif defined( _MSC_VER )
+#include <intrin.h>
+#define LIBNOISE2_ATOMIC_INCREMENT( v )		_InterlockedIncrement( &(v) )
+#define LIBNOISE2_ATOMIC_DECREMENT( v )		_InterlockedDecrement( &(v) )
+#endif
+
 
 #if defined( LIBNOISE2_USE_SSE1 )
 #define LIBNOISE2_AT_LEAST_SSE1
@@ -54,3 +70,13 @@
 #define LIBNOISE2_AT_LEAST_SSE4_1
 #define LIBNOISE2_AT_LEAST_AVX1
 #endif
+
+#if defined( LIBNOISE2_USE_AVX2 )
+#define LIBNOISE2_AT_LEAST_SSE1
+#define LIBNOISE2_AT_LEAST_SSE2
+#define LIBNOISE2_AT_LEAST_SSE3
+#define LIBNOISE2_AT_LEAST_SSSE3
+#define LIBNOISE2_AT_LEAST_SSE4_1
+#define LIBNOISE2_AT_LEAST_AVX1
+#define LIBNOISE2_AT_LEAST_AVX2
+#endif
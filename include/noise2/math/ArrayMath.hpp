@@ -0,0 +1,163 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace math
+	{
+
+		// Element-wise operations over arrays of values, Width lanes at a time. Arrays have to
+		// be aligned as for loadFromMemory, output may alias an input.
+		template< typename ValueType, uint32 Width = NativeWidth< ValueType >::Value >
+		class ArrayMath
+		{
+
+		public:
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+			typedef Math< ValueType, Width >		M;
+#endif
+
+
+
+		public:
+
+			static inline
+			void
+			add( const ValueType* l, const ValueType* r, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, M::add( M::loadFromMemory( l + i ), M::loadFromMemory( r + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = l[ i ] + r[ i ];
+				}
+			}
+
+			static inline
+			void
+			multiply( const ValueType* l, const ValueType* r, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, M::multiply( M::loadFromMemory( l + i ), M::loadFromMemory( r + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = l[ i ] * r[ i ];
+				}
+			}
+
+			static inline
+			void
+			min( const ValueType* l, const ValueType* r, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, M::min( M::loadFromMemory( l + i ), M::loadFromMemory( r + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = std::min( l[ i ], r[ i ] );
+				}
+			}
+
+			static inline
+			void
+			max( const ValueType* l, const ValueType* r, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, M::max( M::loadFromMemory( l + i ), M::loadFromMemory( r + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = std::max( l[ i ], r[ i ] );
+				}
+			}
+
+			// std::pow of every pair, including negative bases with integer exponents
+			static inline
+			void
+			pow( const ValueType* l, const ValueType* r, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, M::pow( M::loadFromMemory( l + i ), M::loadFromMemory( r + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = std::pow( l[ i ], r[ i ] );
+				}
+			}
+
+			// Linear interpolation from l to r by ( control + 1 ) / 2
+			static inline
+			void
+			blend( const ValueType* l, const ValueType* r, const ValueType* control, ValueType* output, size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				for( ; i + Width <= count; i += Width )
+				{
+					typename M::VectorF	alphaV = M::multiply( M::add( M::loadFromMemory( control + i ), M::constOneF() ), M::constHalfF() );
+					typename M::VectorF	lV = M::multiply( M::subtract( M::constOneF(), alphaV ), M::loadFromMemory( l + i ) );
+					M::storeToMemory( output + i, M::add( lV, M::multiply( alphaV, M::loadFromMemory( r + i ) ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					ValueType	alpha = (control[ i ] + ValueType( 1.0 )) * ValueType( 0.5 );
+					output[ i ] = ((ValueType( 1.0 ) - alpha) * l[ i ]) + (alpha * r[ i ]);
+				}
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace math
+	{
+
+		// In-place radix-2 complex FFT of a fixed power of two size, with a 2D variant for
+		// square size x size arrays stored row by row. The inverse transform is not scaled.
+		template< typename ValueT >
+		class Fft
+		{
+
+		public:
+
+			typedef ValueT							ValueType;
+			typedef std::complex< ValueType >		Complex;
+
+
+
+		private:
+
+			uint32							size;
+			std::vector< uint32 >			reversed;
+			// exp( -2 * pi * i * k / size ) for k < size / 2
+			std::vector< Complex >			twiddles;
+			mutable std::vector< Complex >	column;
+
+
+
+		public:
+
+			explicit
+			Fft( uint32 newSize ):
+			  size( newSize ),
+			  reversed( newSize ),
+			  twiddles( newSize / 2 ),
+			  column( newSize )
+			{
+				uint32	bits = 0;
+				while( (1u << bits) < size )
+				{
+					++bits;
+				}
+
+				for( uint32 k = 0; k < size; ++k )
+				{
+					uint32	r = 0;
+
+					for( uint32 b = 0; b < bits; ++b )
+					{
+						r |= ((k >> b) & 1u) << (bits - 1 - b);
+					}
+
+					reversed[ k ] = r;
+				}
+
+				for( uint32 k = 0; k < size / 2; ++k )
+				{
+					double	angle = -2.0 * Math< double >::Pi() * double( k ) / double( size );
+
+					twiddles[ k ] = Complex( ValueType( std::cos( angle ) ), ValueType( std::sin( angle ) ) );
+				}
+			}
+
+			inline
+			uint32
+			getSize() const
+			{
+				return size;
+			}
+
+			void
+			transform( Complex* data, bool inverse ) const
+			{
+				for( uint32 k = 0; k < size; ++k )
+				{
+					if( k < reversed[ k ] )
+					{
+						std::swap( data[ k ], data[ reversed[ k ] ] );
+					}
+				}
+
+				for( uint32 half = 1; half < size; half *= 2 )
+				{
+					uint32	twiddleStep = size / (half * 2);
+
+					for( uint32 start = 0; start < size; start += half * 2 )
+					{
+						for( uint32 k = 0; k < half; ++k )
+						{
+							Complex		w = twiddles[ k * twiddleStep ];
+
+							if( inverse == true )
+							{
+								w = std::conj( w );
+							}
+
+							Complex		even = data[ start + k ];
+							Complex		odd = data[ start + k + half ] * w;
+
+							data[ start + k ] = even + odd;
+							data[ start + k + half ] = even - odd;
+						}
+					}
+				}
+			}
+
+			// Not thread safe, columns go through a shared buffer
+			void
+			transform2D( Complex* data, bool inverse ) const
+			{
+				for( uint32 row = 0; row < size; ++row )
+				{
+					transform( data + (size_t( row ) * size), inverse );
+				}
+
+				for( uint32 c = 0; c < size; ++c )
+				{
+					for( uint32 row = 0; row < size; ++row )
+					{
+						column[ row ] = data[ (size_t( row ) * size) + c ];
+					}
+
+					transform( &column[ 0 ], inverse );
+
+					for( uint32 row = 0; row < size; ++row )
+					{
+						data[ (size_t( row ) * size) + c ] = column[ row ];
+					}
+				}
+			}
+
+		};
+
+	}
+
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 
+#include <noise2/BasicTypes.hpp>
+
+
 
 
 namespace noise2
@@ -9,7 +12,7 @@ namespace noise2
 	namespace math
 	{
 	
-		template< typename ValueType >
+		template< typename ValueType, uint32 Width = 4 >
 		class Interpolations;
 
 	}
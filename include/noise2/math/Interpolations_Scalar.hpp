@@ -9,7 +9,7 @@ namespace noise2
 	namespace math
 	{
 
-		template< typename ValueType >
+		template< typename ValueType, uint32 Width >
 		class Interpolations
 		{
 
@@ -13,14 +13,14 @@ namespace noise2
 	namespace math
 	{
 
-		template< typename ValueType >
+		template< typename ValueType, uint32 Width >
 		class Interpolations
 		{
 
 			public:
 			
-			typedef Math< ValueType >		M;
-			typedef typename M::Vector4F	Vector4F;
+			typedef Math< ValueType, Width >	M;
+			typedef typename M::VectorF		VectorF;
 
 
 
@@ -52,6 +52,22 @@ namespace noise2
 				return p * a * a * a + q * a * a + r * a + s;
 			}
 
+			static inline
+			VectorF
+			CubicInterpV( const VectorF& n0V, const VectorF& n1V, const VectorF& n2V, const VectorF& n3V, const VectorF& aV )
+			{
+				VectorF	pV = M::subtract( M::subtract( n3V, n2V ), M::subtract( n0V, n1V ) );
+				VectorF	qV = M::subtract( M::subtract( n0V, n1V ), pV );
+				VectorF	rV = M::subtract( n2V, n0V );
+
+				// Horner form of p * a^3 + q * a^2 + r * a + s
+				VectorF	resultV = M::add( M::multiply( pV, aV ), qV );
+				resultV = M::add( M::multiply( resultV, aV ), rV );
+				resultV = M::add( M::multiply( resultV, aV ), n1V );
+
+				return resultV;
+			}
+
 			/// Performs linear interpolation between two values.
 			///
 			/// @param n0 The first value.
@@ -71,11 +87,11 @@ namespace noise2
 			}
 			
 			static inline
-			Vector4F
-			LinearInterpV( Vector4F& n0V, Vector4F& n1V, Vector4F& aV )
+			VectorF
+			LinearInterpV( VectorF& n0V, VectorF& n1V, VectorF& aV )
 			{
-				Vector4F		l = M::vectorizeOne( ValueType( 1.0 ) );
-				Vector4F		r;
+				VectorF		l = M::vectorizeOne( ValueType( 1.0 ) );
+				VectorF		r;
 				
 				l = M::subtract( l, aV );
 				l = M::multiply( l, n0V );
@@ -103,11 +119,11 @@ namespace noise2
 			}
 			
 			static inline
-			Vector4F
-			SCurve3V( Vector4F aV )
+			VectorF
+			SCurve3V( VectorF aV )
 			{
-				Vector4F	tmpV;
-				Vector4F	constantsV = M::vectorizeOne( ValueType( 2.0 ) );
+				VectorF	tmpV;
+				VectorF	constantsV = M::vectorizeOne( ValueType( 2.0 ) );
 				
 				tmpV = M::multiply( constantsV, aV );
 				
@@ -145,13 +161,13 @@ namespace noise2
 			}
 			
 			static inline
-			Vector4F
-			SCurve5V( Vector4F aV )
+			VectorF
+			SCurve5V( VectorF aV )
 			{
-				Vector4F	tmpV;
-				Vector4F	constantsV;
-				Vector4F	a3, a4, a5;
-				Vector4F	resultV;
+				VectorF	tmpV;
+				VectorF	constantsV;
+				VectorF	a3, a4, a5;
+				VectorF	resultV;
 				
 				a3 = M::multiply( aV, aV );
 				a3 = M::multiply( a3, aV );
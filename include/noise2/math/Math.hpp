@@ -37,17 +37,79 @@
 #define LIBNOISE2_SUPPORT_MATH_IMPL		Math_SSE4_1
 #endif
 
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+#include <noise2/math/Math_Wide.hpp>
+#endif
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+#include <noise2/math/Math_AVX2.hpp>
+#endif
+
 namespace noise2
 {
 	
 	namespace math
 	{
 
+		// Width is the lane count of VectorF and VectorI. Four lanes are native, as are eight
+		// float lanes with AVX2; other widths are composed of four lane parts (see Math_Wide).
+		template< typename ValueType, uint32 Width = 4 >
+		class Math;
+
+		template< typename ValueType >
+		class Math< ValueType, 4 >: public LIBNOISE2_SUPPORT_MATH_IMPL< ValueType >
+		{
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+
+		public:
+
+			typedef typename LIBNOISE2_SUPPORT_MATH_IMPL< ValueType >::Vector4F	VectorF;
+			typedef typename LIBNOISE2_SUPPORT_MATH_IMPL< ValueType >::Vector4I	VectorI;
+
+			enum
+			{
+				LaneCount = 4
+			};
+#endif
+		};
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+		template< typename ValueType, uint32 Width >
+		class Math: public Math_Wide< LIBNOISE2_SUPPORT_MATH_IMPL< ValueType >, Width >
+		{
+		};
+#endif
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+		template<>
+		class Math< float, 8 >: public Math_AVX2< float >
+		{
+		};
+#endif
+
+
+
+		// Widest lane count with native registers
 		template< typename ValueType >
-		class Math: public LIBNOISE2_SUPPORT_MATH_IMPL< ValueType >
+		struct NativeWidth
 		{
+			enum
+			{
+				Value = 4
+			};
 		};
 
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+		template<>
+		struct NativeWidth< float >
+		{
+			enum
+			{
+				Value = 8
+			};
+		};
+#endif
+
 	}
 	
 }
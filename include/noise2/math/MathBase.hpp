@@ -671,6 +671,41 @@ namespace noise2
 				}
 			}
 
+			// Lanes set in a four lane mask (see moveMask) in ascending order, padded with lane 0
+			static inline
+			const uint8*
+			maskLanes( int32 mask )
+			{
+				static const uint8	lanes[ 16 ][ 4 ] = {
+					{ 0, 0, 0, 0 },
+					{ 0, 0, 0, 0 },
+					{ 1, 0, 0, 0 },
+					{ 0, 1, 0, 0 },
+					{ 2, 0, 0, 0 },
+					{ 0, 2, 0, 0 },
+					{ 1, 2, 0, 0 },
+					{ 0, 1, 2, 0 },
+					{ 3, 0, 0, 0 },
+					{ 0, 3, 0, 0 },
+					{ 1, 3, 0, 0 },
+					{ 0, 1, 3, 0 },
+					{ 2, 3, 0, 0 },
+					{ 0, 2, 3, 0 },
+					{ 1, 2, 3, 0 },
+					{ 0, 1, 2, 3 } };
+
+				return lanes[ mask ];
+			}
+
+			static inline
+			uint32
+			maskLaneCount( int32 mask )
+			{
+				static const uint8	counts[ 16 ] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+				return counts[ mask ];
+			}
+
 			static inline
 			ValueType
 			clamp( ValueType value, ValueType lowerBound, ValueType upperBound )
@@ -726,6 +761,29 @@ namespace noise2
 			}
 
 
+			// Logarithm and power
+			static inline
+			ValueType
+			log2( ValueType v )
+			{
+				return std::log( v ) * ValueType( 1.44269504088896340736 );
+			}
+
+			static inline
+			ValueType
+			exp2( ValueType v )
+			{
+				return std::pow( ValueType( 2.0 ), v );
+			}
+
+			static inline
+			ValueType
+			pow( ValueType base, ValueType exponent )
+			{
+				return std::pow( base, exponent );
+			}
+
+
 			// Order
 			template< uint8 _1, uint8 _2, uint8 _3, uint8 _4 >
 			struct Order
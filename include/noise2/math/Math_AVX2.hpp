@@ -0,0 +1,469 @@
+#pragma once
+
+
+#include <immintrin.h>
+
+
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math_SSE4_1.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace math
+	{
+
+		template< typename ValueType >
+		class Math_AVX2;
+
+
+
+		// Eight float lanes in one register, the native Math< float, 8 >. Operations without an
+		// eight lane form (exp, cos, makeInt32Range, ...) run on the two four lane halves, so
+		// they give the same results as Math< float, 4 >.
+		template<>
+		class Math_AVX2< float >: public Math_SSE4_1< float >
+		{
+
+		public:
+
+			typedef Math_SSE4_1< float >	Math4;
+			typedef __m256					VectorF;
+			typedef __m256i					VectorI;
+
+			enum
+			{
+				LaneCount = 8
+			};
+
+
+
+		public:
+
+			// Memory operations, unaligned since buffers are only guaranteed VECTOR4_ALIGN
+			static inline
+			VectorF
+			loadFromMemory( const ScalarF* memoryLocation )
+			{
+				return _mm256_loadu_ps( memoryLocation );
+			}
+
+			static inline
+			VectorI
+			loadFromMemory( const ScalarI* memoryLocation )
+			{
+				return _mm256_loadu_si256( (const VectorI*) memoryLocation );
+			}
+
+			static inline
+			void
+			storeToMemory( ScalarF* memoryLocation, const VectorF& v )
+			{
+				_mm256_storeu_ps( memoryLocation, v );
+			}
+
+			static inline
+			void
+			storeToMemory( ScalarI* memoryLocation, const VectorI& v )
+			{
+				_mm256_storeu_si256( (VectorI*) memoryLocation, v );
+			}
+
+			static inline
+			void
+			storeToMemory( ScalarUI* memoryLocation, const VectorI& v )
+			{
+				_mm256_storeu_si256( (VectorI*) memoryLocation, v );
+			}
+
+			// Lanes table[ index ]
+			static inline
+			VectorF
+			gather( const ScalarF* table, const VectorI& index )
+			{
+				return _mm256_i32gather_ps( table, index, 4 );
+			}
+
+
+			// Constants
+			static inline
+			VectorF
+			constZeroF()
+			{
+				return _mm256_setzero_ps();
+			}
+
+			static inline
+			VectorF
+			constHalfF()
+			{
+				return _mm256_set1_ps( 0.5f );
+			}
+
+			static inline
+			VectorF
+			constOneF()
+			{
+				return _mm256_set1_ps( 1.0f );
+			}
+
+			static inline
+			VectorF
+			constTwoF()
+			{
+				return _mm256_set1_ps( 2.0f );
+			}
+
+			static inline
+			VectorI
+			constZeroI()
+			{
+				return _mm256_setzero_si256();
+			}
+
+			static inline
+			VectorI
+			constOneI()
+			{
+				return _mm256_set1_epi32( 1 );
+			}
+
+			static inline
+			VectorI
+			constFourI()
+			{
+				return _mm256_set1_epi32( 4 );
+			}
+
+
+			// Vectorization
+			static inline
+			VectorF
+			vectorizeOne( const ScalarF& f )
+			{
+				return _mm256_set1_ps( f );
+			}
+
+			static inline
+			VectorI
+			vectorizeOne( const ScalarI& i )
+			{
+				return _mm256_set1_epi32( i );
+			}
+
+			static inline
+			VectorI
+			vectorizeOne( const ScalarUI& ui )
+			{
+				return _mm256_set1_epi32( ui );
+			}
+
+
+			// Arithmetic operations
+			static inline
+			VectorF
+			add( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_add_ps( l, r );
+			}
+
+			static inline
+			VectorI
+			add( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_add_epi32( l, r );
+			}
+
+			static inline
+			VectorF
+			subtract( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_sub_ps( l, r );
+			}
+
+			static inline
+			VectorI
+			subtract( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_sub_epi32( l, r );
+			}
+
+			static inline
+			VectorF
+			multiply( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_mul_ps( l, r );
+			}
+
+			static inline
+			VectorI
+			multiply( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_mullo_epi32( l, r );
+			}
+
+			static inline
+			VectorF
+			divide( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_div_ps( l, r );
+			}
+
+			static inline
+			VectorF
+			abs( const VectorF& v )
+			{
+				return _mm256_castsi256_ps( _mm256_and_si256( _mm256_castps_si256( v ), _mm256_set1_epi32( 0x7fffffff ) ) );
+			}
+
+
+			// Comparison
+			static inline
+			VectorF
+			greaterThan( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_cmp_ps( l, r, _CMP_GT_OQ );
+			}
+
+			static inline
+			VectorF
+			lowerThan( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_cmp_ps( l, r, _CMP_LT_OQ );
+			}
+
+			static inline
+			VectorF
+			equalGreaterThan( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_cmp_ps( l, r, _CMP_GE_OQ );
+			}
+
+			static inline
+			VectorF
+			equalLowerThan( const VectorF& l, const VectorF& r )
+			{
+				return _mm256_cmp_ps( l, r, _CMP_LE_OQ );
+			}
+
+
+			// MinMax
+			static inline
+			VectorF
+			min( const VectorF& a, const VectorF& b )
+			{
+				return _mm256_min_ps( a, b );
+			}
+
+			static inline
+			VectorF
+			max( const VectorF& a, const VectorF& b )
+			{
+				return _mm256_max_ps( a, b );
+			}
+
+
+			// Logical
+			static inline
+			VectorI
+			bitAnd( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_and_si256( l, r );
+			}
+
+			static inline
+			VectorI
+			bitOr( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_or_si256( l, r );
+			}
+
+			static inline
+			VectorI
+			bitXor( const VectorI& l, const VectorI& r )
+			{
+				return _mm256_xor_si256( l, r );
+			}
+
+
+			// Shift operations
+			static inline
+			VectorI
+			shiftRightLogical( const VectorI& v, int bitCount )
+			{
+				return _mm256_srli_epi32( v, bitCount );
+			}
+
+			static inline
+			VectorI
+			shiftLeftLogical( const VectorI& v, int bitCount )
+			{
+				return _mm256_slli_epi32( v, bitCount );
+			}
+
+
+			// Conversions
+			static inline
+			VectorI
+			floatToIntTruncated( const VectorF& v )
+			{
+				return _mm256_cvttps_epi32( v );
+			}
+
+			static inline
+			VectorF
+			intToFloat( const VectorI& v )
+			{
+				return _mm256_cvtepi32_ps( v );
+			}
+
+
+			// Casts
+			static inline
+			VectorI
+			castToInt( const VectorF& v )
+			{
+				return _mm256_castps_si256( v );
+			}
+
+
+			// Misc operations
+			using Math4::floor;
+
+			static inline
+			VectorF
+			blend( const VectorF& a, const VectorF& b, const VectorI& blendMask )
+			{
+				return _mm256_blendv_ps( a, b, _mm256_castsi256_ps( blendMask ) );
+			}
+
+			static inline
+			VectorF
+			select( const VectorF& v, const VectorI& mask )
+			{
+				return _mm256_and_ps( v, _mm256_castsi256_ps( mask ) );
+			}
+
+			static inline
+			VectorF
+			floor( const VectorF& v )
+			{
+				return _mm256_floor_ps( v );
+			}
+
+			static inline
+			VectorI
+			signToOne( const VectorF& v )
+			{
+				return _mm256_srli_epi32( _mm256_castps_si256( v ), 31 );
+			}
+
+			static inline
+			VectorF
+			makeInt32Range( const VectorF& input )
+			{
+				return combine( Math4::makeInt32Range( lowHalf( input ) ), Math4::makeInt32Range( highHalf( input ) ) );
+			}
+
+			// Eight bit mask made of the sign bits of the lanes
+			static inline
+			uint32
+			moveMask( const VectorI& mask )
+			{
+				return uint32( _mm256_movemask_ps( _mm256_castsi256_ps( mask ) ) );
+			}
+
+
+			// Exponential
+			using Math4::exp;
+			using Math4::exp2;
+			using Math4::log2;
+			using Math4::pow;
+
+			static inline
+			VectorF
+			exp( const VectorF& v )
+			{
+				return combine( Math4::exp( lowHalf( v ) ), Math4::exp( highHalf( v ) ) );
+			}
+
+			static inline
+			VectorF
+			exp2( const VectorF& v )
+			{
+				return combine( Math4::exp2( lowHalf( v ) ), Math4::exp2( highHalf( v ) ) );
+			}
+
+			static inline
+			VectorF
+			log2( const VectorF& v )
+			{
+				return combine( Math4::log2( lowHalf( v ) ), Math4::log2( highHalf( v ) ) );
+			}
+
+			static inline
+			VectorF
+			pow( const VectorF& base, const VectorF& exponent )
+			{
+				return combine( Math4::pow( lowHalf( base ), lowHalf( exponent ) ),
+								Math4::pow( highHalf( base ), highHalf( exponent ) ) );
+			}
+
+
+			// Trigonometric
+			using Math4::cos;
+			using Math4::sinCos;
+
+			static inline
+			VectorF
+			cos( const VectorF& v )
+			{
+				return combine( Math4::cos( lowHalf( v ) ), Math4::cos( highHalf( v ) ) );
+			}
+
+			static inline
+			void
+			sinCos( const VectorF& v, VectorF& sinV, VectorF& cosV )
+			{
+				Vector4F	sinLo, cosLo, sinHi, cosHi;
+
+				Math4::sinCos( lowHalf( v ), sinLo, cosLo );
+				Math4::sinCos( highHalf( v ), sinHi, cosHi );
+				sinV = combine( sinLo, sinHi );
+				cosV = combine( cosLo, cosHi );
+			}
+
+
+
+		private:
+
+			static inline
+			Vector4F
+			lowHalf( const VectorF& v )
+			{
+				return _mm256_castps256_ps128( v );
+			}
+
+			static inline
+			Vector4F
+			highHalf( const VectorF& v )
+			{
+				return _mm256_extractf128_ps( v, 1 );
+			}
+
+			static inline
+			VectorF
+			combine( const Vector4F& lo, const Vector4F& hi )
+			{
+				return _mm256_insertf128_ps( _mm256_castps128_ps256( lo ), hi, 1 );
+			}
+
+		};
+
+	}
+
+}
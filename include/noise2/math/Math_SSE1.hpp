@@ -54,6 +54,13 @@ namespace noise2
 				_mm_store_ps( memoryLocation, v );
 			}
 
+			static inline
+			void
+			storeToMemoryUnaligned( ScalarF* memoryLocation, const Vector4F& v )
+			{
+				_mm_storeu_ps( memoryLocation, v );
+			}
+
 
 			// Constants
 			static inline
@@ -245,6 +252,20 @@ namespace noise2
 				return _mm_sqrt_ps( v );
 			}
 
+			// 1 / sqrt( v ), the 12 bit estimate refined by one Newton-Raphson step
+			static inline
+			Vector4F
+			reciprocalSqrt( const Vector4F& v )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, threeHalvesA, 1.5f );
+
+				Vector4F	estimateV = _mm_rsqrt_ps( v );
+				Vector4F	halfVV = _mm_mul_ps( v, constHalfF() );
+				Vector4F	correctionV = _mm_mul_ps( halfVV, _mm_mul_ps( estimateV, estimateV ) );
+
+				return _mm_mul_ps( estimateV, _mm_sub_ps( loadFromMemory( threeHalvesA ), correctionV ) );
+			}
+
 			// Comparison
 			static inline
 			Vector4F
@@ -282,6 +303,22 @@ namespace noise2
 			}
 
 
+			// MinMax
+			static inline
+			Vector4F
+			min( const Vector4F& a, const Vector4F& b )
+			{
+				return _mm_min_ps( a, b );
+			}
+
+			static inline
+			Vector4F
+			max( const Vector4F& a, const Vector4F& b )
+			{
+				return _mm_max_ps( a, b );
+			}
+
+
 			// Shift operations
 			static inline
 			Vector4F
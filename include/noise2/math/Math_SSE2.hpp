@@ -530,6 +530,14 @@ namespace noise2
 				return add( bPart, bitAnd( a, negBlendMask ) );
 			}
 
+			// Four bit mask made of the sign bits of the lanes
+			static inline
+			int32
+			moveMask( const Vector4I& mask )
+			{
+				return _mm_movemask_ps( _mm_castsi128_ps( mask ) );
+			}
+
 		};
 
 
@@ -605,6 +613,24 @@ namespace noise2
 				return castToFloat( bitAnd( castToInt( v ), mask ) );
 			}
 
+			// Moves the lanes set in mask (see moveMask) to the front, keeping their order
+			static inline
+			Vector4F
+			compact( const Vector4F& v, int32 mask )
+			{
+				const uint8*			lanes = maskLanes( mask );
+				VECTOR4_ALIGN( ScalarF	vA[ 4 ] );
+				VECTOR4_ALIGN( ScalarF	compactA[ 4 ] );
+
+				storeToMemory( vA, v );
+				compactA[ 0 ] = vA[ lanes[ 0 ] ];
+				compactA[ 1 ] = vA[ lanes[ 1 ] ];
+				compactA[ 2 ] = vA[ lanes[ 2 ] ];
+				compactA[ 3 ] = vA[ lanes[ 3 ] ];
+
+				return loadFromMemory( compactA );
+			}
+
 			static inline
 			Vector4F
 			floor( const Vector4F& v )
@@ -718,6 +744,168 @@ namespace noise2
 			}
 
 
+			// Logarithm and power. log2 is -inf at zero, inf at inf and NaN below zero, as
+			// std::log2, denormals are scaled by 2^24 into the normal range first.
+			using Math_SSE2_Integer< float >::log2;
+			using Math_SSE2_Integer< float >::exp2;
+			using Math_SSE2_Integer< float >::pow;
+
+			static inline
+			Vector4F
+			log2( const Vector4F& v )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, mantissa_mask, 0x007fffff );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, exponent_zero, 0x3f800000 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, infinity, 0x7f800000 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exponent_bias, 127.0f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, sqrt2, 1.41421356237309505f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, min_normal, 1.17549435082228751e-38f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, denormal_scale, 16777216.0f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, denormal_exponent, 24.0f );
+
+				// 2 / ((2k + 1) ln2)
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, log2_p0, 2.8853900817779268f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, log2_p1, 0.96179669392597560f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, log2_p2, 0.57707801635558536f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, log2_p3, 0.41219858311113244f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, log2_p4, 0.32059889797532520f );
+
+				Vector4F	one = constOneF();
+				Vector4F	zero = constZeroF();
+				Vector4F	inf = castToFloat( loadFromMemory( infinity ) );
+
+				Vector4F	denormalMask = _mm_cmplt_ps( v, loadFromMemory( min_normal ) );
+				Vector4F	x = _mm_mul_ps( v, _mm_or_ps( _mm_and_ps( denormalMask, loadFromMemory( denormal_scale ) ),
+														 _mm_andnot_ps( denormalMask, one ) ) );
+
+				/* x = m * 2^e with m in [ sqrt( 0.5 ), sqrt( 2 ) ) */
+				Vector4I	bits = castToInt( x );
+				Vector4F	e = _mm_sub_ps( intToFloat( shiftRightLogical( bits, 23 ) ), loadFromMemory( exponent_bias ) );
+				e = _mm_sub_ps( e, _mm_and_ps( denormalMask, loadFromMemory( denormal_exponent ) ) );
+				Vector4F	m = castToFloat( bitOr( bitAnd( bits, loadFromMemory( mantissa_mask ) ), loadFromMemory( exponent_zero ) ) );
+
+				Vector4F	upperMask = equalGreaterThan( m, loadFromMemory( sqrt2 ) );
+				m = _mm_mul_ps( m, _mm_sub_ps( one, _mm_and_ps( upperMask, constHalfF() ) ) );
+				e = _mm_add_ps( e, _mm_and_ps( upperMask, one ) );
+
+				/* log2( m ) = 2 atanh( s ) / ln2 with s = (m - 1) / (m + 1) */
+				Vector4F	s = _mm_div_ps( _mm_sub_ps( m, one ), _mm_add_ps( m, one ) );
+				Vector4F	z = _mm_mul_ps( s, s );
+
+				Vector4F	y = loadFromMemory( log2_p4 );
+				y = _mm_mul_ps( y, z );
+				y = _mm_add_ps( y, loadFromMemory( log2_p3 ) );
+				y = _mm_mul_ps( y, z );
+				y = _mm_add_ps( y, loadFromMemory( log2_p2 ) );
+				y = _mm_mul_ps( y, z );
+				y = _mm_add_ps( y, loadFromMemory( log2_p1 ) );
+				y = _mm_mul_ps( y, z );
+				y = _mm_add_ps( y, loadFromMemory( log2_p0 ) );
+				y = _mm_add_ps( e, _mm_mul_ps( y, s ) );
+
+				Vector4F	zeroMask = _mm_cmpeq_ps( v, zero );
+				Vector4F	infMask = _mm_cmpeq_ps( v, inf );
+				y = _mm_andnot_ps( _mm_or_ps( zeroMask, infMask ), y );
+				y = _mm_or_ps( y, _mm_and_ps( infMask, inf ) );
+				y = _mm_or_ps( y, _mm_and_ps( zeroMask, _mm_sub_ps( zero, inf ) ) );
+
+				return _mm_or_ps( y, _mm_cmpnge_ps( v, zero ) );
+			}
+
+			// exp2 is 0 below -150 and inf from 128 up, 2^n is built in two halves so that the
+			// denormal and the top results keep representable factors
+			static inline
+			Vector4F
+			exp2( const Vector4F& v )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, infinity, 0x7f800000 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_hi, 128.0f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_lo, -150.0f );
+
+				// ln2^k / k!
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p1, 6.9314718055994531E-1f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p2, 2.4022650695910071E-1f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p3, 5.5504108664821580E-2f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p4, 9.6181291076284772E-3f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p5, 1.3333558146428443E-3f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p6, 1.5403530393381609E-4f );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, exp2_p7, 1.5252733804059840E-5f );
+
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, i127, 0x7f );
+
+				Vector4F	x = _mm_min_ps( v, loadFromMemory( exp2_hi ) );
+				x = _mm_max_ps( x, loadFromMemory( exp2_lo ) );
+
+				/* 2^x = 2^n * 2^f with f in [ -0.5, 0.5 ] */
+				Vector4F	n = floor( _mm_add_ps( x, constHalfF() ) );
+				Vector4F	f = _mm_sub_ps( x, n );
+
+				Vector4F	y = loadFromMemory( exp2_p7 );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p6 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p5 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p4 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p3 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p2 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, loadFromMemory( exp2_p1 ) );
+				y = _mm_mul_ps( y, f );
+				y = _mm_add_ps( y, constOneF() );
+
+				/* build 2^n = 2^h * 2^(n - h) */
+				Vector4F	h = floor( _mm_mul_ps( n, constHalfF() ) );
+				Vector4I	pow2h = _mm_slli_epi32( _mm_add_epi32( _mm_cvttps_epi32( h ), loadFromMemory( i127 ) ), 23 );
+				Vector4I	pow2r = _mm_slli_epi32( _mm_add_epi32( _mm_cvttps_epi32( _mm_sub_ps( n, h ) ), loadFromMemory( i127 ) ), 23 );
+				y = _mm_mul_ps( _mm_mul_ps( y, _mm_castsi128_ps( pow2h ) ), _mm_castsi128_ps( pow2r ) );
+
+				Vector4F	overflowMask = _mm_cmpgt_ps( v, loadFromMemory( exp2_hi ) );
+				y = _mm_andnot_ps( _mm_or_ps( overflowMask, _mm_cmplt_ps( v, loadFromMemory( exp2_lo ) ) ), y );
+				y = _mm_or_ps( y, _mm_and_ps( overflowMask, castToFloat( loadFromMemory( infinity ) ) ) );
+
+				return _mm_or_ps( y, _mm_cmpunord_ps( v, v ) );
+			}
+
+			// std::pow of every lane: a negative base keeps its sign for odd exponents and gives NaN
+			// for fractional ones, zero and infinite bases and exponents follow C99
+			static inline
+			Vector4F
+			pow( const Vector4F& base, const Vector4F& exponent )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, sign_mask, ~0x7fffffff );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int32, infinity, 0x7f800000 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( float, even_integer_limit, 16777216.0f );
+
+				Vector4F	one = constOneF();
+				Vector4F	zero = constZeroF();
+				Vector4F	signMask = castToFloat( loadFromMemory( sign_mask ) );
+				Vector4F	inf = castToFloat( loadFromMemory( infinity ) );
+				Vector4F	absBase = _mm_andnot_ps( signMask, base );
+				Vector4F	absExponent = _mm_andnot_ps( signMask, exponent );
+
+				Vector4F	y = exp2( _mm_mul_ps( exponent, log2( absBase ) ) );
+
+				/* every exponent from 2^24 up is an even integer, below it floor is exact */
+				Vector4F	evenMask = _mm_cmpge_ps( absExponent, loadFromMemory( even_integer_limit ) );
+				Vector4F	exponentFloor = floor( _mm_andnot_ps( evenMask, exponent ) );
+				Vector4F	fractionMask = _mm_andnot_ps( evenMask, _mm_cmpneq_ps( exponent, exponentFloor ) );
+				Vector4F	halfFloor = floor( _mm_mul_ps( exponentFloor, constHalfF() ) );
+				Vector4F	oddMask = _mm_cmpneq_ps( exponentFloor, _mm_add_ps( halfFloor, halfFloor ) );
+
+				y = _mm_xor_ps( y, _mm_and_ps( _mm_and_ps( base, signMask ), _mm_andnot_ps( fractionMask, oddMask ) ) );
+				y = _mm_or_ps( y, _mm_and_ps( fractionMask, _mm_and_ps( _mm_cmplt_ps( base, zero ), _mm_cmplt_ps( absBase, inf ) ) ) );
+
+				/* x^0, 1^y and (-1)^inf are 1, NaN included */
+				Vector4F	oneMask = _mm_or_ps( _mm_cmpeq_ps( exponent, zero ), _mm_cmpeq_ps( base, one ) );
+				oneMask = _mm_or_ps( oneMask, _mm_and_ps( _mm_cmpeq_ps( absBase, one ), _mm_cmpeq_ps( absExponent, inf ) ) );
+
+				return _mm_or_ps( _mm_andnot_ps( oneMask, y ), _mm_and_ps( oneMask, one ) );
+			}
+
+
 			// Trigonometric
 			static inline
 			Vector4F
@@ -970,6 +1158,14 @@ namespace noise2
 				_mm_store_pd( memoryLocation + 2, v.hi );
 			}
 
+			static inline
+			void
+			storeToMemoryUnaligned( ScalarF* memoryLocation, const Vector4F& v )
+			{
+				_mm_storeu_pd( memoryLocation, v.lo );
+				_mm_storeu_pd( memoryLocation + 2, v.hi );
+			}
+
 
 			// Constants
 			static inline
@@ -1254,6 +1450,13 @@ namespace noise2
 				return r;
 			}
 
+			static inline
+			Vector4F
+			reciprocalSqrt( const Vector4F& v )
+			{
+				return divide( constOneF(), sqrtRecip( v ) );
+			}
+
 
 			// Comparison
 			using Math_SSE2_Integer< double >::equal;
@@ -1561,6 +1764,24 @@ namespace noise2
 				return selected;
 			}
 
+			// Moves the lanes set in mask (see moveMask) to the front, keeping their order
+			static inline
+			Vector4F
+			compact( const Vector4F& v, int32 mask )
+			{
+				const uint8*			lanes = maskLanes( mask );
+				VECTOR4_ALIGN( ScalarF	vA[ 4 ] );
+				VECTOR4_ALIGN( ScalarF	compactA[ 4 ] );
+
+				storeToMemory( vA, v );
+				compactA[ 0 ] = vA[ lanes[ 0 ] ];
+				compactA[ 1 ] = vA[ lanes[ 1 ] ];
+				compactA[ 2 ] = vA[ lanes[ 2 ] ];
+				compactA[ 3 ] = vA[ lanes[ 3 ] ];
+
+				return loadFromMemory( compactA );
+			}
+
 			static inline
 			Vector4F
 			floor( const Vector4F& v )
@@ -1691,6 +1912,219 @@ namespace noise2
 			}
 
 
+			// Logarithm and power. log2 is -inf at zero, inf at inf and NaN below zero, as
+			// std::log2, denormals are scaled by 2^54 into the normal range first.
+			using Math_SSE2_Integer< double >::log2;
+			using Math_SSE2_Integer< double >::exp2;
+			using Math_SSE2_Integer< double >::pow;
+
+			static inline
+			Vector4F
+			log2( const Vector4F& v )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, mantissa_mask, 0x000fffffffffffffLL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, exponent_zero, 0x3ff0000000000000LL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, infinity, 0x7ff0000000000000LL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exponent_bias, 1023.0 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, sqrt2, 1.41421356237309505 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, min_normal, 2.2250738585072014e-308 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, denormal_scale, 18014398509481984.0 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, denormal_exponent, 54.0 );
+
+				// 2 / ((2k + 1) ln2)
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p0, 2.8853900817779268 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p1, 0.9617966939259757 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p2, 0.5770780163555853 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p3, 0.41219858311113244 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p4, 0.3205988979753252 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p5, 0.2623081892525388 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p6, 0.2219530832136867 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p7, 0.19235933878519512 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p8, 0.16972882833987804 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, log2_p9, 0.15186263588304877 );
+
+				Vector4F	one = constOneF();
+				Vector4F	zero = constZeroF();
+				Vector4F	inf = castToFloat( loadFromMemory( infinity ) );
+
+				Vector4F	denormalMask = lowerThan( v, loadFromMemory( min_normal ) );
+				Vector4F	x = multiply( v, bitOr( bitAnd( denormalMask, loadFromMemory( denormal_scale ) ),
+													bitAndNot( denormalMask, one ) ) );
+
+				/* x = m * 2^e with m in [ sqrt( 0.5 ), sqrt( 2 ) ) */
+				Vector4I64	bits;
+				bits.lo = _mm_castpd_si128( x.lo );
+				bits.hi = _mm_castpd_si128( x.hi );
+				Vector4F	e = subtract( int64ToFloat( shiftRightLogical( bits, 52 ) ), loadFromMemory( exponent_bias ) );
+				e = subtract( e, bitAnd( denormalMask, loadFromMemory( denormal_exponent ) ) );
+				Vector4F	m = castToFloat( bitOr( bitAnd( bits, loadFromMemory( mantissa_mask ) ), loadFromMemory( exponent_zero ) ) );
+
+				Vector4F	upperMask = equalGreaterThan( m, loadFromMemory( sqrt2 ) );
+				m = multiply( m, subtract( one, bitAnd( upperMask, constHalfF() ) ) );
+				e = add( e, bitAnd( upperMask, one ) );
+
+				/* log2( m ) = 2 atanh( s ) / ln2 with s = (m - 1) / (m + 1) */
+				Vector4F	s = divide( subtract( m, one ), add( m, one ) );
+				Vector4F	z = multiply( s, s );
+
+				Vector4F	y = loadFromMemory( log2_p9 );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p8 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p7 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p6 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p5 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p4 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p3 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p2 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p1 ) );
+				y = multiply( y, z );
+				y = add( y, loadFromMemory( log2_p0 ) );
+				y = add( e, multiply( y, s ) );
+
+				Vector4F	zeroMask = equal( v, zero );
+				Vector4F	infMask = equal( v, inf );
+				y = bitAndNot( bitOr( zeroMask, infMask ), y );
+				y = bitOr( y, bitAnd( infMask, inf ) );
+				y = bitOr( y, bitAnd( zeroMask, subtract( zero, inf ) ) );
+
+				Vector4F	nanMask;
+				nanMask.lo = _mm_cmpnge_pd( v.lo, zero.lo );
+				nanMask.hi = _mm_cmpnge_pd( v.hi, zero.hi );
+
+				return bitOr( y, nanMask );
+			}
+
+			// exp2 is 0 below -1075 and inf from 1024 up, 2^n is built in two halves so that the
+			// denormal and the top results keep representable factors
+			static inline
+			Vector4F
+			exp2( const Vector4F& v )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, infinity, 0x7ff0000000000000LL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_hi, 1024.0 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_lo, -1075.0 );
+
+				// ln2^k / k!
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p1, 6.9314718055994529E-01 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p2, 2.4022650695910069E-01 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p3, 5.5504108664821576E-02 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p4, 9.6181291076284769E-03 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p5, 1.3333558146428441E-03 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p6, 1.5403530393381606E-04 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p7, 1.5252733804059838E-05 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p8, 1.3215486790144305E-06 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p9, 1.0178086009239696E-07 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p10, 7.0549116208011209E-09 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p11, 4.4455382718708101E-10 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, exp2_p12, 2.5678435993488196E-11 );
+
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, i1023, 0x3ff );
+
+				Vector4F	x = min( v, loadFromMemory( exp2_hi ) );
+				x = max( x, loadFromMemory( exp2_lo ) );
+
+				/* 2^x = 2^n * 2^f with f in [ -0.5, 0.5 ] */
+				Vector4F	n = floor( add( x, constHalfF() ) );
+				Vector4F	f = subtract( x, n );
+
+				Vector4F	y = loadFromMemory( exp2_p12 );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p11 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p10 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p9 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p8 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p7 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p6 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p5 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p4 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p3 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p2 ) );
+				y = multiply( y, f );
+				y = add( y, loadFromMemory( exp2_p1 ) );
+				y = multiply( y, f );
+				y = add( y, constOneF() );
+
+				/* build 2^n = 2^h * 2^(n - h) */
+				Vector4F	h = floor( multiply( n, constHalfF() ) );
+				Vector4I64	pow2h = shiftLeftLogical( add( floatToInt64Truncated( h ), loadFromMemory( i1023 ) ), 52 );
+				Vector4I64	pow2r = shiftLeftLogical( add( floatToInt64Truncated( subtract( n, h ) ), loadFromMemory( i1023 ) ), 52 );
+				y = multiply( multiply( y, castToFloat( pow2h ) ), castToFloat( pow2r ) );
+
+				Vector4F	overflowMask = greaterThan( v, loadFromMemory( exp2_hi ) );
+				y = bitAndNot( bitOr( overflowMask, lowerThan( v, loadFromMemory( exp2_lo ) ) ), y );
+				y = bitOr( y, bitAnd( overflowMask, castToFloat( loadFromMemory( infinity ) ) ) );
+
+				Vector4F	nanMask;
+				nanMask.lo = _mm_cmpunord_pd( v.lo, v.lo );
+				nanMask.hi = _mm_cmpunord_pd( v.hi, v.hi );
+
+				return bitOr( y, nanMask );
+			}
+
+			// std::pow of every lane: a negative base keeps its sign for odd exponents and gives NaN
+			// for fractional ones, zero and infinite bases and exponents follow C99
+			static inline
+			Vector4F
+			pow( const Vector4F& base, const Vector4F& exponent )
+			{
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, sign_mask, ~0x7fffffffffffffffLL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( int64, infinity, 0x7ff0000000000000LL );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, integer_limit, 4503599627370496.0 );
+				LIBNOISE2_SUPPORT_CONST_ARRAY( double, even_integer_limit, 9007199254740992.0 );
+
+				Vector4F	one = constOneF();
+				Vector4F	zero = constZeroF();
+				Vector4F	signMask = castToFloat( loadFromMemory( sign_mask ) );
+				Vector4F	inf = castToFloat( loadFromMemory( infinity ) );
+				Vector4F	absBase = bitAndNot( signMask, base );
+				Vector4F	absExponent = bitAndNot( signMask, exponent );
+
+				Vector4F	y = exp2( multiply( exponent, log2( absBase ) ) );
+
+				/* every exponent from 2^52 up is an integer and from 2^53 up an even one, below
+				   that adding and subtracting 2^52 rounds exactly */
+				Vector4F	integers = loadFromMemory( integer_limit );
+				Vector4F	halfExponent = multiply( absExponent, constHalfF() );
+				Vector4F	rounded = subtract( add( absExponent, integers ), integers );
+				Vector4F	halfRounded = subtract( add( halfExponent, integers ), integers );
+
+				Vector4F	fractionMask;
+				fractionMask.lo = _mm_cmpneq_pd( absExponent.lo, rounded.lo );
+				fractionMask.hi = _mm_cmpneq_pd( absExponent.hi, rounded.hi );
+				fractionMask = bitAnd( fractionMask, lowerThan( absExponent, integers ) );
+
+				Vector4F	oddMask;
+				oddMask.lo = _mm_cmpneq_pd( halfExponent.lo, halfRounded.lo );
+				oddMask.hi = _mm_cmpneq_pd( halfExponent.hi, halfRounded.hi );
+				oddMask = bitAndNot( fractionMask, bitAnd( oddMask, lowerThan( absExponent, loadFromMemory( even_integer_limit ) ) ) );
+
+				y = bitXor( y, bitAnd( bitAnd( base, signMask ), oddMask ) );
+				y = bitOr( y, bitAnd( fractionMask, bitAnd( lowerThan( base, zero ), lowerThan( absBase, inf ) ) ) );
+
+				/* x^0, 1^y and (-1)^inf are 1, NaN included */
+				Vector4F	oneMask = bitOr( equal( exponent, zero ), equal( base, one ) );
+				oneMask = bitOr( oneMask, bitAnd( equal( absBase, one ), equal( absExponent, inf ) ) );
+
+				return bitOr( bitAndNot( oneMask, y ), bitAnd( oneMask, one ) );
+			}
+
+
 			// Trigonometric
 			static inline
 			Vector4F
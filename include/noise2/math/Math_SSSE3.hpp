@@ -26,6 +26,38 @@ namespace noise2
 		template<>
 		class Math_SSSE3< float >: public Math_SSE3< float >
 		{
+
+		public:
+
+			// Misc operations
+			// Moves the lanes set in mask (see moveMask) to the front with a single byte shuffle
+			static inline
+			Vector4F
+			compact( const Vector4F& v, int32 mask )
+			{
+				static const VECTOR4_ALIGN( uint8	shuffleA[ 16 ][ 16 ] ) = {
+					{ 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 4, 5, 6, 7, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 4, 5, 6, 7, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 8, 9, 10, 11, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 8, 9, 10, 11, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 0, 1, 2, 3 },
+					{ 12, 13, 14, 15, 0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 12, 13, 14, 15, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 4, 5, 6, 7, 12, 13, 14, 15, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 4, 5, 6, 7, 12, 13, 14, 15, 0, 1, 2, 3 },
+					{ 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3 },
+					{ 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3 },
+					{ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 } };
+
+				Vector4I	shuffleV = _mm_load_si128( (const Vector4I*) shuffleA[ mask ] );
+
+				return castToFloat( _mm_shuffle_epi8( castToInt( v ), shuffleV ) );
+			}
+
 		};
 
 		template<>
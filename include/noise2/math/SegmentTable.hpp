@@ -0,0 +1,215 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace math
+	{
+
+		// Piecewise function of one value. Sorted breakpoints split the line into segments;
+		// segment s covers breakpoint s - 1 up to breakpoint s, and the first and last
+		// segments are unbounded. Each segment keeps an origin, a scale and ColumnCount
+		// values. The local coordinate of a value in its segment is ( value - origin ) * scale.
+		//
+		// Segments are found through a uniform grid of cells over the breakpoints. A cell
+		// stores the segment of its lowest value, so locating takes a fixed number of
+		// comparisons, at most the number of breakpoints in one cell. The grid is exact for
+		// any spacing of the breakpoints, since cells are assigned with the same rounding
+		// that Locate uses.
+		template< typename ValueType, uint32 ColumnCount >
+		class SegmentTable
+		{
+
+		public:
+
+			enum
+			{
+				MaxCellCount = 1024
+			};
+
+
+
+		private:
+
+			// Padded with a NaN, so that no value passes the last breakpoint twice
+			std::vector< ValueType >	breakpoints;
+			std::vector< uint32 >		cellSegments;
+			ValueType					first;
+			ValueType					cellScale;
+			ValueType					cellLimit;
+			uint32						stepCount;
+
+			std::vector< ValueType >	origins;
+			std::vector< ValueType >	scales;
+			std::vector< ValueType >	columns[ ColumnCount ];
+
+
+
+		public:
+
+			SegmentTable()
+			{
+				Build( 0, 0 );
+			}
+
+			// breakpoints have to be sorted, segment data are reset to zero
+			void
+			Build( const ValueType* breakpoints, size_t count )
+			{
+				this->breakpoints.assign( breakpoints, breakpoints + count );
+				this->breakpoints.push_back( std::numeric_limits< ValueType >::quiet_NaN() );
+
+				first = count > 0 ? breakpoints[ 0 ] : ValueType( 0.0 );
+				cellScale = ValueType( 0.0 );
+				cellLimit = ValueType( 0.0 );
+
+				uint32	cellCount = 0;
+				if( count > 1 && breakpoints[ count - 1 ] > breakpoints[ 0 ] )
+				{
+					ValueType	range = breakpoints[ count - 1 ] - breakpoints[ 0 ];
+					ValueType	minimalGap = range;
+
+					for( size_t i = 1; i < count; ++i )
+					{
+						ValueType	gap = breakpoints[ i ] - breakpoints[ i - 1 ];
+						if( gap > ValueType( 0.0 ) && gap < minimalGap )
+						{
+							minimalGap = gap;
+						}
+					}
+
+					// A cell per smallest gap keeps most cells down to one breakpoint
+					double	cells = double( range ) / double( minimalGap );
+					cellCount = cells < double( count ) ? uint32( count ) :
+								(cells > double( MaxCellCount ) ? uint32( MaxCellCount ) : uint32( cells ) + 1);
+					cellScale = ValueType( cellCount ) / range;
+					cellLimit = ValueType( cellCount );
+				}
+
+				std::vector< uint32 >	cellBreakpoints( cellCount + 1, 0 );
+				for( size_t i = 0; i < count; ++i )
+				{
+					++cellBreakpoints[ getCell( breakpoints[ i ] ) ];
+				}
+
+				cellSegments.resize( cellCount + 1 );
+				stepCount = 0;
+				uint32	segment = 0;
+				for( uint32 c = 0; c <= cellCount; ++c )
+				{
+					cellSegments[ c ] = segment;
+					segment += cellBreakpoints[ c ];
+					stepCount = cellBreakpoints[ c ] > stepCount ? cellBreakpoints[ c ] : stepCount;
+				}
+
+				origins.assign( count + 1, ValueType( 0.0 ) );
+				scales.assign( count + 1, ValueType( 0.0 ) );
+				for( uint32 c = 0; c < ColumnCount; ++c )
+				{
+					columns[ c ].assign( count + 1, ValueType( 0.0 ) );
+				}
+			}
+
+			size_t
+			GetSegmentCount() const
+			{
+				return origins.size();
+			}
+
+			// Comparisons one Locate takes
+			uint32
+			GetStepCount() const
+			{
+				return stepCount;
+			}
+
+			void
+			SetSegment( size_t segment, ValueType origin, ValueType scale, const ValueType* values )
+			{
+				origins[ segment ] = origin;
+				scales[ segment ] = scale;
+				for( uint32 c = 0; c < ColumnCount; ++c )
+				{
+					columns[ c ][ segment ] = values[ c ];
+				}
+			}
+
+			// Number of breakpoints lower or equal to value
+			inline
+			size_t
+			Locate( ValueType value ) const
+			{
+				size_t	segment = cellSegments[ getCell( value ) ];
+
+				for( uint32 s = 0; s < stepCount; ++s )
+				{
+					segment += value >= breakpoints[ segment ] ? 1 : 0;
+				}
+
+				return segment;
+			}
+
+			inline
+			ValueType
+			GetCoordinate( size_t segment, ValueType value ) const
+			{
+				return (value - origins[ segment ]) * scales[ segment ];
+			}
+
+			inline
+			ValueType
+			GetValue( size_t segment, uint32 column ) const
+			{
+				return columns[ column ][ segment ];
+			}
+
+			// Local coordinates and segment values of count values, laid out as arrays so that
+			// the function itself can be evaluated on vectors
+			void
+			Gather( const ValueType* values, ValueType* coordinates, ValueType* const* segmentValues, size_t count ) const
+			{
+				for( size_t i = 0; i < count; ++i )
+				{
+					size_t	segment = Locate( values[ i ] );
+
+					coordinates[ i ] = GetCoordinate( segment, values[ i ] );
+					for( uint32 c = 0; c < ColumnCount; ++c )
+					{
+						segmentValues[ c ][ i ] = columns[ c ][ segment ];
+					}
+				}
+			}
+
+
+
+		private:
+
+			// Monotonic in value, NaN goes to the first cell
+			inline
+			size_t
+			getCell( ValueType value ) const
+			{
+				ValueType	cell = (value - first) * cellScale;
+
+				return cell > ValueType( 0.0 ) ? size_t( cell < cellLimit ? cell : cellLimit ) : 0;
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+
+#include <cstddef>
+#include <cstring>
+
+
+
+
+namespace noise2
+{
+
+	namespace memory
+	{
+
+		// Heap array of POD values whose first element is aligned to Alignment bytes,
+		// so that it can be used with Math loadFromMemory/storeToMemory.
+		template< typename T, size_t Alignment = 16 >
+		class AlignedArray
+		{
+
+		private:
+
+			char*		raw;
+			T*			aligned;
+			size_t		count;
+			size_t		capacity;
+
+
+
+		public:
+
+			inline
+			AlignedArray():
+			  raw( 0 ),
+			  aligned( 0 ),
+			  count( 0 ),
+			  capacity( 0 )
+			{
+			}
+
+			inline
+			explicit
+			AlignedArray( size_t count ):
+			  raw( 0 ),
+			  aligned( 0 ),
+			  count( 0 ),
+			  capacity( 0 )
+			{
+				resize( count );
+			}
+
+			inline
+			AlignedArray( const AlignedArray& other ):
+			  raw( 0 ),
+			  aligned( 0 ),
+			  count( 0 ),
+			  capacity( 0 )
+			{
+				resize( other.count );
+				copyFrom( other );
+			}
+
+			inline
+			~AlignedArray()
+			{
+				delete[] raw;
+			}
+
+			inline
+			AlignedArray&
+			operator = ( const AlignedArray& other )
+			{
+				if( this != &other )
+				{
+					resize( other.count );
+					copyFrom( other );
+				}
+
+				return *this;
+			}
+
+			// Existing values are kept, new values are left uninitialized
+			inline
+			void
+			resize( size_t newCount )
+			{
+				if( newCount > capacity )
+				{
+					char*	newRaw = new char[ (newCount * sizeof( T )) + Alignment ];
+					T*		newAligned = align( newRaw );
+
+					if( count > 0 )
+					{
+						std::memcpy( newAligned, aligned, count * sizeof( T ) );
+					}
+
+					delete[] raw;
+					raw = newRaw;
+					aligned = newAligned;
+					capacity = newCount;
+				}
+
+				count = newCount;
+			}
+
+			inline
+			void
+			fill( const T& value )
+			{
+				for( size_t i = 0; i < count; ++i )
+				{
+					aligned[ i ] = value;
+				}
+			}
+
+			inline
+			size_t
+			size() const
+			{
+				return count;
+			}
+
+			inline
+			T*
+			data()
+			{
+				return aligned;
+			}
+
+			inline
+			const T*
+			data() const
+			{
+				return aligned;
+			}
+
+			inline
+			T&
+			operator [] ( size_t index )
+			{
+				return aligned[ index ];
+			}
+
+			inline
+			const T&
+			operator [] ( size_t index ) const
+			{
+				return aligned[ index ];
+			}
+
+
+
+		private:
+
+			static inline
+			T*
+			align( char* p )
+			{
+				size_t	misalignment = size_t( p ) & (Alignment - 1);
+
+				if( misalignment != 0 )
+				{
+					p += Alignment - misalignment;
+				}
+
+				return (T*) p;
+			}
+
+			inline
+			void
+			copyFrom( const AlignedArray& other )
+			{
+				if( other.count > 0 )
+				{
+					std::memcpy( aligned, other.aligned, other.count * sizeof( T ) );
+				}
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,240 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace memory
+	{
+
+		// Stack of temporary arrays, one instance lives per thread and value type, see
+		// forCurrentThread(). Memory is taken by Scope and given back when the scope ends.
+		// Chunks are kept and never move, so once the arena has grown to the largest
+		// demand of its thread, scopes allocate nothing.
+		template< typename T >
+		class ScratchArena
+		{
+
+		public:
+
+			enum
+			{
+				// Allocations are rounded to 32 bytes, so each starts aligned for any Math width
+				Alignment = 32,
+				MinimalChunkSize = 4096
+			};
+
+
+
+			class Scope
+			{
+
+			private:
+
+				ScratchArena&	arena;
+				size_t			chunk;
+				size_t			used;
+
+
+
+			public:
+
+				inline
+				explicit
+				Scope( ScratchArena& arena ):
+				  arena( arena ),
+				  chunk( arena.current ),
+				  used( arena.currentUsed() )
+				{
+				}
+
+				inline
+				~Scope()
+				{
+					arena.rewind( chunk, used );
+				}
+
+				inline
+				T*
+				allocate( size_t count )
+				{
+					return arena.allocate( count );
+				}
+
+
+
+			private:
+
+				Scope( const Scope& other );
+
+				Scope&
+				operator = ( const Scope& other );
+
+			};
+
+
+
+		private:
+
+			friend class Scope;
+
+			struct Chunk
+			{
+				AlignedArray< T, Alignment >	values;
+				size_t							used;
+			};
+
+			// Chunks after current are empty
+			std::vector< Chunk* >		chunks;
+			size_t						current;
+
+
+
+		public:
+
+			inline
+			ScratchArena():
+			  current( 0 )
+			{
+			}
+
+			inline
+			~ScratchArena()
+			{
+				for( size_t c = 0; c < chunks.size(); ++c )
+				{
+					delete chunks[ c ];
+				}
+			}
+
+			static inline
+			ScratchArena&
+			forCurrentThread()
+			{
+				ScratchArena*&	arena = threadArena();
+
+				if( arena == 0 )
+				{
+					arena = new ScratchArena();
+				}
+
+				return *arena;
+			}
+
+			// Frees the arena of the calling thread, to be called before a short-lived thread
+			// exits. No Scope of the thread may be open.
+			static inline
+			void
+			releaseCurrentThread()
+			{
+				ScratchArena*&	arena = threadArena();
+
+				delete arena;
+				arena = 0;
+			}
+
+			// Values held by all chunks
+			inline
+			size_t
+			capacity() const
+			{
+				size_t	total = 0;
+
+				for( size_t c = 0; c < chunks.size(); ++c )
+				{
+					total += chunks[ c ]->values.size();
+				}
+
+				return total;
+			}
+
+
+
+		private:
+
+			ScratchArena( const ScratchArena& other );
+
+			ScratchArena&
+			operator = ( const ScratchArena& other );
+
+			static inline
+			ScratchArena*&
+			threadArena()
+			{
+				static LIBNOISE2_THREAD_LOCAL ScratchArena*		arena = 0;
+				return arena;
+			}
+
+			inline
+			size_t
+			currentUsed() const
+			{
+				return current < chunks.size() ? chunks[ current ]->used : 0;
+			}
+
+			T*
+			allocate( size_t count )
+			{
+				const size_t	granule = (Alignment + sizeof( T ) - 1) / sizeof( T );
+				count = ((count + granule - 1) / granule) * granule;
+
+				for( ; current < chunks.size(); ++current )
+				{
+					Chunk&	chunk = *chunks[ current ];
+
+					// Nothing lives in an empty chunk, it can grow in place
+					if( chunk.used == 0 && chunk.values.size() < count )
+					{
+						chunk.values.resize( count );
+					}
+
+					if( chunk.values.size() - chunk.used >= count )
+					{
+						T*	values = chunk.values.data() + chunk.used;
+						chunk.used += count;
+						return values;
+					}
+				}
+
+				Chunk*	chunk = new Chunk();
+				chunk->values.resize( count > size_t( MinimalChunkSize ) ? count : size_t( MinimalChunkSize ) );
+				chunk->used = count;
+				chunks.push_back( chunk );
+
+				return chunk->values.data();
+			}
+
+			inline
+			void
+			rewind( size_t chunk, size_t used )
+			{
+				for( size_t c = chunk + 1; c <= current && c < chunks.size(); ++c )
+				{
+					chunks[ c ]->used = 0;
+				}
+
+				if( chunk < chunks.size() )
+				{
+					chunks[ chunk ]->used = used;
+				}
+
+				current = chunk;
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Absolute value of the source
+		template< typename ValueT, unsigned int Dimension >
+		class Abs: public epilogue::EpilogueModifier< ValueT, Dimension, epilogue::Abs< ValueT > >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+		};
+
+	}
+
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		template< typename ValueType >
+		class BakedGabor;
+
+
+		namespace gabor
+		{
+			template< typename ValueType, uint8 VectorSize >
+			class BakedGaborImpl;
+		}
+
+	}
+
+}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+#include <noise2/module/gabor/BakedGabor_Vector4.hpp>
+namespace noise2
+{
+	namespace module
+	{
+		template< typename ValueType >
+		class BakedGabor: public gabor::BakedGaborImpl< ValueType, 4 >
+		{
+		};
+	}
+}
+#else
+#include <noise2/module/gabor/BakedGabor_Scalar.hpp>
+namespace noise2
+{
+	namespace module
+	{
+		template< typename ValueType >
+		class BakedGabor: public gabor::BakedGaborImpl< ValueType, 1 >
+		{
+		};
+	}
+}
+#endif
@@ -0,0 +1,60 @@
+#pragma once
+
+
+// libnoise
+#include "noise2/math/ArrayMath.hpp"
+#include "noise2/module/Combiner.hpp"
+
+
+
+
+namespace noise2
+{
+	
+	namespace module
+	{
+
+		namespace combiner
+		{
+
+			template< typename ValueType >
+			struct BlendOperator
+			{
+
+				enum
+				{
+					SourceCount = 3
+				};
+
+				static inline
+				ValueType
+				apply( const ValueType* values )
+				{
+					ValueType	alpha = (values[ 2 ] + ValueType( 1.0 )) * ValueType( 0.5 );
+
+					return ((ValueType( 1.0 ) - alpha) * values[ 0 ]) + (alpha * values[ 1 ]);
+				}
+
+				template< uint32 Width >
+				static inline
+				void
+				applyArray( const ValueType* const* sourceValues, ValueType* output, size_t count )
+				{
+					math::ArrayMath< ValueType, Width >::blend( sourceValues[ 0 ], sourceValues[ 1 ], sourceValues[ 2 ], output, count );
+				}
+
+			};
+
+		}
+
+
+		// Linear interpolation between sources 0 and 1. Source 2 controls the weight, -1 gives
+		// source 0 and 1 source 1.
+		template< typename ValueType, unsigned int Dimension >
+		class Blend: public Combiner< ValueType, Dimension, combiner::BlendOperator< ValueType > >
+		{
+		};
+		
+	}
+	
+}
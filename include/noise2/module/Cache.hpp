@@ -0,0 +1,711 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <cstring>
+#include <map>
+#include <vector>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Dispatch.hpp>
+#include <noise2/module/Plan.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace cache
+		{
+
+			// Identity of one cache, shared by the cache and its slots in every thread and
+			// deleted by the last of them to let go. A destroyed cache clears alive, so other
+			// threads can tell its slots are dead.
+			struct Token
+			{
+
+				volatile long	references;
+				volatile long	alive;
+
+				Token():
+				  references( 1 ),
+				  alive( 1 )
+				{}
+
+				inline
+				void
+				acquire()
+				{
+					LIBNOISE2_ATOMIC_INCREMENT( references );
+				}
+
+				inline
+				void
+				release()
+				{
+					if( LIBNOISE2_ATOMIC_DECREMENT( references ) == 0 )
+					{
+						delete this;
+					}
+				}
+
+			};
+
+
+			// Values of source 0 for the last few blocks of points one thread asked for
+			template< typename ValueT, unsigned int Dimension >
+			struct Slot
+			{
+
+				typedef ValueT		ValueType;
+
+				enum
+				{
+					BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+				};
+
+				struct Entry
+				{
+					size_t								count;
+					memory::AlignedArray< ValueType, 32 >	coordinates;
+					memory::AlignedArray< ValueType, 32 >	values;
+
+					Entry():
+					  count( 0 ),
+					  coordinates( Dimension * BlockSize ),
+					  values( BlockSize )
+					{}
+				};
+
+				Token*					token;
+				long					version;
+				std::vector< Entry* >	entries;
+				size_t					next;
+
+				explicit
+				Slot( Token& token ):
+				  token( &token ),
+				  version( -1 ),
+				  next( 0 )
+				{
+					token.acquire();
+				}
+
+				~Slot()
+				{
+					for( size_t e = 0; e < entries.size(); ++e )
+					{
+						delete entries[ e ];
+					}
+
+					token->release();
+				}
+
+				// Forgets everything and keeps entryCount empty entries, allocating only when
+				// the count grows
+				void
+				reset( long version, size_t entryCount )
+				{
+					while( entries.size() > entryCount )
+					{
+						delete entries.back();
+						entries.pop_back();
+					}
+
+					while( entries.size() < entryCount )
+					{
+						entries.push_back( new Entry() );
+					}
+
+					// Blocks hold at least one point, so an empty entry never matches
+					for( size_t e = 0; e < entries.size(); ++e )
+					{
+						entries[ e ]->count = 0;
+					}
+
+					this->version = version;
+					next = 0;
+				}
+
+				// Entry holding exactly these count points, or null
+				const Entry*
+				find( const ValueType* const* input, size_t count ) const
+				{
+					for( size_t e = 0; e < entries.size(); ++e )
+					{
+						const Entry&	entry = *entries[ e ];
+						bool			equal = entry.count == count;
+
+						for( unsigned int d = 0; equal && d < Dimension; ++d )
+						{
+							equal = std::memcmp( entry.coordinates.data() + (d * BlockSize), input[ d ], count * sizeof( ValueType ) ) == 0;
+						}
+
+						if( equal )
+						{
+							return &entry;
+						}
+					}
+
+					return 0;
+				}
+
+				// Replaces the oldest entry
+				Entry&
+				store( const ValueType* const* input, size_t count )
+				{
+					Entry&	entry = *entries[ next ];
+
+					next = (next + 1) % entries.size();
+
+					entry.count = count;
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						std::memcpy( entry.coordinates.data() + (d * BlockSize), input[ d ], count * sizeof( ValueType ) );
+					}
+
+					return entry;
+				}
+
+			};
+
+
+			// Slots of one thread, keyed by the token of their cache. A slot is created the
+			// first time the thread uses the cache. It is freed when the cache is destroyed on
+			// this thread, on the next lookup of this thread after the cache is destroyed on
+			// another one, or by releaseCurrentThread().
+			template< typename ValueT, unsigned int Dimension >
+			class Memo
+			{
+
+			public:
+
+				typedef Slot< ValueT, Dimension >		SlotType;
+
+
+
+			private:
+
+				typedef std::map< const Token*, SlotType* >		SlotMap;
+
+				SlotMap		slots;
+				long		sweptRetirements;
+
+
+
+			public:
+
+				inline
+				Memo():
+				  sweptRetirements( retirements() )
+				{
+				}
+
+				inline
+				~Memo()
+				{
+					for( typename SlotMap::iterator s = slots.begin(); s != slots.end(); ++s )
+					{
+						delete s->second;
+					}
+				}
+
+				static inline
+				Memo&
+				forCurrentThread()
+				{
+					Memo*&	memo = threadMemo();
+
+					if( memo == 0 )
+					{
+						memo = new Memo();
+					}
+
+					return *memo;
+				}
+
+				// Frees all slots of the calling thread, to be called before a short-lived
+				// thread exits
+				static inline
+				void
+				releaseCurrentThread()
+				{
+					Memo*&	memo = threadMemo();
+
+					delete memo;
+					memo = 0;
+				}
+
+				// Marks the token of a cache being destroyed dead and frees its slot in the
+				// calling thread, the other threads free theirs on their next lookup
+				static inline
+				void
+				retire( Token& token )
+				{
+					Memo*	memo = threadMemo();
+
+					token.alive = 0;
+					LIBNOISE2_ATOMIC_INCREMENT( retirements() );
+
+					if( memo != 0 )
+					{
+						typename SlotMap::iterator	s = memo->slots.find( &token );
+
+						if( s != memo->slots.end() )
+						{
+							delete s->second;
+							memo->slots.erase( s );
+						}
+					}
+				}
+
+				// Slots do not move, the reference stays valid while other caches add theirs
+				inline
+				SlotType&
+				slot( Token& token )
+				{
+					if( sweptRetirements != retirements() )
+					{
+						sweep();
+					}
+
+					typename SlotMap::iterator	s = slots.lower_bound( &token );
+
+					if( s == slots.end() || s->first != &token )
+					{
+						s = slots.insert( s, typename SlotMap::value_type( &token, new SlotType( token ) ) );
+					}
+
+					return *s->second;
+				}
+
+
+
+			private:
+
+				Memo( const Memo& other );
+
+				Memo&
+				operator = ( const Memo& other );
+
+				// Frees the slots of destroyed caches. A token outlives the slots holding it, so
+				// its address is not reused while one of them is still in the map.
+				void
+				sweep()
+				{
+					sweptRetirements = retirements();
+
+					for( typename SlotMap::iterator s = slots.begin(); s != slots.end(); )
+					{
+						if( s->first->alive == 0 )
+						{
+							delete s->second;
+							slots.erase( s++ );
+						}
+						else
+						{
+							++s;
+						}
+					}
+				}
+
+				// Caches destroyed so far, in any thread
+				static inline
+				volatile long&
+				retirements()
+				{
+					static volatile long	count = 0;
+					return count;
+				}
+
+				static inline
+				Memo*&
+				threadMemo()
+				{
+					static LIBNOISE2_THREAD_LOCAL Memo*		memo = 0;
+					return memo;
+				}
+
+			};
+
+
+			// Module which remembers the values of its source for the last GetBlockCount() blocks
+			// of points, GetValue and GetValue4 calls count as blocks of one and four points.
+			// Blocks are matched by their coordinates rather than by the arrays they are
+			// passed in, which callers tend to refill. Arrays are looked up BlockSize points
+			// at a time. Every thread keeps its own blocks, so concurrent evaluation needs no
+			// locking, the hit and miss counts are shared and counted atomically.
+			template< typename ValueT, unsigned int Dim >
+			class CacheBase: public Module< ValueT, Dim >
+			{
+
+				//
+				// Type aliases
+				//
+				public:
+
+				typedef ValueT								ValueType;
+				static const unsigned int					Dimension = Dim;
+				typedef Module< ValueType, Dimension >		ModuleType;
+				typedef Memo< ValueType, Dimension >		MemoType;
+				typedef Slot< ValueType, Dimension >		SlotType;
+
+				enum
+				{
+					BlockSize = SlotType::BlockSize
+				};
+
+
+
+				//
+				// Public interface
+				//
+				public:
+
+				CacheBase():
+				  ModuleType( 1 ),
+				  token( new Token() ),
+				  version( 0 ),
+				  blockCount( 4 ),
+				  hitCount( 0 ),
+				  missCount( 0 )
+				{
+				}
+
+				virtual
+				~CacheBase()
+				{
+					MemoType::retire( *token );
+					token->release();
+				}
+
+				virtual
+				void
+				SetSourceModule( int index, const ModuleType& sourceModule )
+				{
+					ModuleType::SetSourceModule( index, sourceModule );
+					Invalidate();
+				}
+
+				size_t
+				GetBlockCount() const
+				{
+					return blockCount;
+				}
+
+				void
+				SetBlockCount( size_t blockCount )
+				{
+					this->blockCount = blockCount > 0 ? blockCount : 1;
+					Invalidate();
+				}
+
+				// Drops the remembered values in all threads and the counts, needed when the
+				// source changes behind the cache's back. Threads evaluating meanwhile may
+				// still count and return values of the old source for the block at hand.
+				void
+				Invalidate()
+				{
+					LIBNOISE2_ATOMIC_INCREMENT( version );
+					hitCount = 0;
+					missCount = 0;
+				}
+
+				// Blocks found and not found by all threads since the cache was created or
+				// last invalidated
+				size_t
+				GetHitCount() const
+				{
+					return size_t( hitCount );
+				}
+
+				size_t
+				GetMissCount() const
+				{
+					return size_t( missCount );
+				}
+
+
+
+				//
+				// Protected interface
+				//
+				protected:
+
+				ValueType
+				cachedValue( const ValueType* point ) const
+				{
+					const ValueType*	input[ Dimension ];
+
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						input[ d ] = point + d;
+					}
+
+					SlotType&						slot = ownSlot();
+					const typename SlotType::Entry*	entry = slot.find( input, 1 );
+
+					if( entry != 0 )
+					{
+						LIBNOISE2_ATOMIC_INCREMENT( hitCount );
+						return entry->values[ 0 ];
+					}
+
+					LIBNOISE2_ATOMIC_INCREMENT( missCount );
+
+					ValueType	value = dispatch::getValue( this->GetSourceModule( 0 ), point );
+
+					slot.store( input, 1 ).values[ 0 ] = value;
+					return value;
+				}
+
+				void
+				cached4( const ValueType* const* input, ValueType* output ) const
+				{
+					SlotType&						slot = ownSlot();
+					const typename SlotType::Entry*	entry = slot.find( input, 4 );
+
+					if( entry == 0 )
+					{
+						LIBNOISE2_ATOMIC_INCREMENT( missCount );
+						dispatch::getValue4( this->GetSourceModule( 0 ), input, output );
+						std::memcpy( slot.store( input, 4 ).values.data(), output, 4 * sizeof( ValueType ) );
+					}
+					else
+					{
+						LIBNOISE2_ATOMIC_INCREMENT( hitCount );
+						std::memcpy( output, entry->values.data(), 4 * sizeof( ValueType ) );
+					}
+				}
+
+				void
+				cachedArray( const ValueType* const* input, ValueType* output, size_t count ) const
+				{
+					SlotType&			slot = ownSlot();
+					const ValueType*	blockInput[ Dimension ];
+
+					for( size_t start = 0; start < count; start += BlockSize )
+					{
+						size_t							blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+						const typename SlotType::Entry*	entry;
+
+						for( unsigned int d = 0; d < Dimension; ++d )
+						{
+							blockInput[ d ] = input[ d ] + start;
+						}
+
+						entry = slot.find( blockInput, blockCount );
+						if( entry == 0 )
+						{
+							LIBNOISE2_ATOMIC_INCREMENT( missCount );
+							dispatch::getValueArray( this->GetSourceModule( 0 ), blockInput, output + start, blockCount );
+							std::memcpy( slot.store( blockInput, blockCount ).values.data(), output + start, blockCount * sizeof( ValueType ) );
+						}
+						else
+						{
+							LIBNOISE2_ATOMIC_INCREMENT( hitCount );
+							std::memcpy( output + start, entry->values.data(), blockCount * sizeof( ValueType ) );
+						}
+					}
+				}
+
+
+
+				//
+				// Private interface
+				//
+				private:
+
+				// The slot of this cache in the calling thread, emptied if the cache was
+				// invalidated since the thread last used it
+				SlotType&
+				ownSlot() const
+				{
+					SlotType&	slot = MemoType::forCurrentThread().slot( *token );
+					long		currentVersion = version;
+
+					if( slot.version != currentVersion )
+					{
+						slot.reset( currentVersion, blockCount );
+					}
+
+					return slot;
+				}
+
+
+
+				//
+				// Fields
+				//
+				private:
+
+				Token*					token;
+				volatile long			version;
+				size_t					blockCount;
+				mutable volatile long	hitCount;
+				mutable volatile long	missCount;
+
+			};
+
+		}
+
+
+		template< typename ValueT, unsigned int Dimension >
+		class Cache;
+
+
+		template< typename ValueT >
+		class Cache< ValueT, 1 >: public cache::CacheBase< ValueT, 1 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x ) const
+			{
+				ValueType	point[ 1 ] = { x };
+				return this->cachedValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, ValueType* output ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->cached4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->cachedArray( input, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Cache< ValueT, 2 >: public cache::CacheBase< ValueT, 2 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y ) const
+			{
+				ValueType	point[ 2 ] = { x, y };
+				return this->cachedValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->cached4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->cachedArray( input, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Cache< ValueT, 3 >: public cache::CacheBase< ValueT, 3 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z ) const
+			{
+				ValueType	point[ 3 ] = { x, y, z };
+				return this->cachedValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->cached4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->cachedArray( input, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Cache< ValueT, 4 >: public cache::CacheBase< ValueT, 4 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+			{
+				ValueType	point[ 4 ] = { x, y, z, w };
+				return this->cachedValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+					   ValueType* output ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->cached4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->cachedArray( input, output, count );
+			}
+
+		};
+
+	}
+
+}
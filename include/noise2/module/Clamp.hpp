@@ -0,0 +1,49 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Source value clamped to the bounds, -1 to 1 by default, as in libnoise
+		template< typename ValueT, unsigned int Dimension >
+		class Clamp: public epilogue::EpilogueModifier< ValueT, Dimension, epilogue::Clamp< ValueT > >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			ValueType
+			GetLowerBound() const
+			{
+				return this->epilogue.lowerBound;
+			}
+
+			ValueType
+			GetUpperBound() const
+			{
+				return this->epilogue.upperBound;
+			}
+
+			// lowerBound has to be lower than upperBound
+			void
+			SetBounds( ValueType lowerBound, ValueType upperBound )
+			{
+				this->epilogue.lowerBound = lowerBound;
+				this->epilogue.upperBound = upperBound;
+			}
+
+		};
+
+	}
+
+}
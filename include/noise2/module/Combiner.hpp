@@ -0,0 +1,482 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/memory/ScratchArena.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Plan.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Module whose value at a point is OperatorT applied to the values of its sources there.
+		// OperatorT has SourceCount, apply( values ) for one point and applyArray< Width >(
+		// sourceValues, output, count ) for many. GetValue4 and GetValueArray take vectors of source values
+		// from the sources' own GetValue4 and GetValueArray, so SIMD sources stay SIMD; under
+		// Plan the sources are buffered and only applyArray runs.
+		template< typename ValueT, unsigned int Dimension, typename OperatorT >
+		class Combiner;
+
+
+		template< typename ValueT, typename OperatorT >
+		class Combiner< ValueT, 1, OperatorT >: public Module< ValueT, 1 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 1;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				SourceCount = OperatorT::SourceCount,
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Combiner():
+			  ModuleType( SourceCount )
+			{
+			}
+
+			virtual
+			~Combiner()
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x ) const
+			{
+				ValueType	values[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					values[ s ] = this->GetSourceModule( s ).GetValue( x );
+				}
+
+				return OperatorT::apply( values );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, ValueType* output ) const
+			{
+				VECTOR4_ALIGN( ValueType	values[ SourceCount * 4 ] );
+				const ValueType*			sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					this->GetSourceModule( s ).GetValue4( inputX, values + (s * 4) );
+					sourceValues[ s ] = values + (s * 4);
+				}
+
+				OperatorT::template applyArray< 4 >( sourceValues, output, 4 );
+			}
+
+			// Sources are evaluated a block at a time, so that their values stay in cache
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				ValueType*											values = scope.allocate( SourceCount * BlockSize );
+				const ValueType*									sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					sourceValues[ s ] = values + (s * BlockSize);
+				}
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					for( int s = 0; s < SourceCount; ++s )
+					{
+						this->GetSourceModule( s ).GetValueArray( inputX + start, values + (s * BlockSize), blockCount );
+					}
+
+					OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT, typename OperatorT >
+		class Combiner< ValueT, 2, OperatorT >: public Module< ValueT, 2 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 2;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				SourceCount = OperatorT::SourceCount,
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Combiner():
+			  ModuleType( SourceCount )
+			{
+			}
+
+			virtual
+			~Combiner()
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y ) const
+			{
+				ValueType	values[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					values[ s ] = this->GetSourceModule( s ).GetValue( x, y );
+				}
+
+				return OperatorT::apply( values );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				VECTOR4_ALIGN( ValueType	values[ SourceCount * 4 ] );
+				const ValueType*			sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					this->GetSourceModule( s ).GetValue4( inputX, inputY, values + (s * 4) );
+					sourceValues[ s ] = values + (s * 4);
+				}
+
+				OperatorT::template applyArray< 4 >( sourceValues, output, 4 );
+			}
+
+			// Sources are evaluated a block at a time, so that their values stay in cache
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				ValueType*											values = scope.allocate( SourceCount * BlockSize );
+				const ValueType*									sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					sourceValues[ s ] = values + (s * BlockSize);
+				}
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					for( int s = 0; s < SourceCount; ++s )
+					{
+						this->GetSourceModule( s ).GetValueArray( inputX + start, inputY + start, values + (s * BlockSize), blockCount );
+					}
+
+					OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT, typename OperatorT >
+		class Combiner< ValueT, 3, OperatorT >: public Module< ValueT, 3 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 3;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				SourceCount = OperatorT::SourceCount,
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Combiner():
+			  ModuleType( SourceCount )
+			{
+			}
+
+			virtual
+			~Combiner()
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z ) const
+			{
+				ValueType	values[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					values[ s ] = this->GetSourceModule( s ).GetValue( x, y, z );
+				}
+
+				return OperatorT::apply( values );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+			{
+				VECTOR4_ALIGN( ValueType	values[ SourceCount * 4 ] );
+				const ValueType*			sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					this->GetSourceModule( s ).GetValue4( inputX, inputY, inputZ, values + (s * 4) );
+					sourceValues[ s ] = values + (s * 4);
+				}
+
+				OperatorT::template applyArray< 4 >( sourceValues, output, 4 );
+			}
+
+			// Sources are evaluated a block at a time, so that their values stay in cache
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				ValueType*											values = scope.allocate( SourceCount * BlockSize );
+				const ValueType*									sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					sourceValues[ s ] = values + (s * BlockSize);
+				}
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					for( int s = 0; s < SourceCount; ++s )
+					{
+						this->GetSourceModule( s ).GetValueArray( inputX + start, inputY + start, inputZ + start, values + (s * BlockSize), blockCount );
+					}
+
+					OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* /*inputZ*/,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT, typename OperatorT >
+		class Combiner< ValueT, 4, OperatorT >: public Module< ValueT, 4 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 4;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				SourceCount = OperatorT::SourceCount,
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Combiner():
+			  ModuleType( SourceCount )
+			{
+			}
+
+			virtual
+			~Combiner()
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+			{
+				ValueType	values[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					values[ s ] = this->GetSourceModule( s ).GetValue( x, y, z, w );
+				}
+
+				return OperatorT::apply( values );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+					   ValueType* output ) const
+			{
+				VECTOR4_ALIGN( ValueType	values[ SourceCount * 4 ] );
+				const ValueType*			sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					this->GetSourceModule( s ).GetValue4( inputX, inputY, inputZ, inputW, values + (s * 4) );
+					sourceValues[ s ] = values + (s * 4);
+				}
+
+				OperatorT::template applyArray< 4 >( sourceValues, output, 4 );
+			}
+
+			// Sources are evaluated a block at a time, so that their values stay in cache
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				ValueType*											values = scope.allocate( SourceCount * BlockSize );
+				const ValueType*									sourceValues[ SourceCount ];
+
+				for( int s = 0; s < SourceCount; ++s )
+				{
+					sourceValues[ s ] = values + (s * BlockSize);
+				}
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					for( int s = 0; s < SourceCount; ++s )
+					{
+						this->GetSourceModule( s ).GetValueArray( inputX + start, inputY + start, inputZ + start, inputW + start, values + (s * BlockSize), blockCount );
+					}
+
+					OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* /*inputZ*/, const ValueType* /*inputW*/,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				OperatorT::template applyArray< math::NativeWidth< ValueType >::Value >( sourceValues, output, count );
+			}
+
+		};
+
+	}
+
+}
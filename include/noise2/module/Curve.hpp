@@ -0,0 +1,262 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <vector>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/math/Interpolations.hpp>
+#include <noise2/math/SegmentTable.hpp>
+#include <noise2/module/Modifier.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Curve of libnoise: maps the source value through a cubic spline across the control
+		// points, which are sorted by input value. Setting the control points compiles one
+		// segment per gap between them into a SegmentTable, holding the four outputs the
+		// spline needs there; outside the control points the curve is flat. Arrays are
+		// evaluated in chunks: first the segment of every value is looked up, then the
+		// cubic runs on vectors.
+		template< typename ValueT, unsigned int Dimension >
+		class Curve: public Modifier< ValueT, Dimension >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			typedef math::SegmentTable< ValueType, 4 >	Table;
+
+			struct ControlPoint
+			{
+				ValueType	inputValue;
+				ValueType	outputValue;
+			};
+
+			enum
+			{
+				ChunkSize = 64
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Curve()
+			{
+			}
+
+			virtual
+			~Curve()
+			{
+			}
+
+			// Input values have to be distinct, returns false and adds nothing if the input
+			// value is already taken
+			bool
+			AddControlPoint( ValueType inputValue, ValueType outputValue )
+			{
+				size_t	index = findInsertionPos( inputValue );
+
+				if( index < controlPoints.size() && controlPoints[ index ].inputValue == inputValue )
+				{
+					return false;
+				}
+
+				ControlPoint	controlPoint = { inputValue, outputValue };
+				controlPoints.insert( controlPoints.begin() + index, controlPoint );
+				compile();
+
+				return true;
+			}
+
+			// Replaces all control points, the table is compiled once. Returns false and keeps
+			// the current points if two input values are equal.
+			bool
+			SetControlPoints( const ControlPoint* points, size_t count )
+			{
+				std::vector< ControlPoint >	previous;
+
+				previous.swap( controlPoints );
+				for( size_t i = 0; i < count; ++i )
+				{
+					size_t	index = findInsertionPos( points[ i ].inputValue );
+
+					if( index < controlPoints.size() && controlPoints[ index ].inputValue == points[ i ].inputValue )
+					{
+						controlPoints.swap( previous );
+						return false;
+					}
+
+					controlPoints.insert( controlPoints.begin() + index, points[ i ] );
+				}
+				compile();
+
+				return true;
+			}
+
+			void
+			ClearAllControlPoints()
+			{
+				controlPoints.clear();
+				compile();
+			}
+
+			const ControlPoint*
+			GetControlPointArray() const
+			{
+				return controlPoints.empty() ? 0 : &controlPoints[ 0 ];
+			}
+
+			int
+			GetControlPointCount() const
+			{
+				return int( controlPoints.size() );
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const
+			{
+				size_t	segment = table.Locate( value );
+
+				return math::Interpolations< ValueType >::CubicInterp( table.GetValue( segment, 0 ), table.GetValue( segment, 1 ),
+																	   table.GetValue( segment, 2 ), table.GetValue( segment, 3 ),
+																	   table.GetCoordinate( segment, value ) );
+			}
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const
+			{
+				VECTOR4_ALIGN( ValueType	alpha[ ChunkSize ] );
+				VECTOR4_ALIGN( ValueType	n[ 4 ][ ChunkSize ] );
+				ValueType*					segmentValues[ 4 ] = { n[ 0 ], n[ 1 ], n[ 2 ], n[ 3 ] };
+
+				for( size_t start = 0; start < count; start += ChunkSize )
+				{
+					size_t	chunkCount = count - start < size_t( ChunkSize ) ? count - start : size_t( ChunkSize );
+					size_t	i = 0;
+
+					table.Gather( values + start, alpha, segmentValues, chunkCount );
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+					typedef math::Math< ValueType, math::NativeWidth< ValueType >::Value >				M;
+					typedef math::Interpolations< ValueType, math::NativeWidth< ValueType >::Value >	Interp;
+
+					for( ; i + M::LaneCount <= chunkCount; i += M::LaneCount )
+					{
+						M::storeToMemory( output + start + i, Interp::CubicInterpV( M::loadFromMemory( n[ 0 ] + i ), M::loadFromMemory( n[ 1 ] + i ),
+																					M::loadFromMemory( n[ 2 ] + i ), M::loadFromMemory( n[ 3 ] + i ),
+																					M::loadFromMemory( alpha + i ) ) );
+					}
+#endif
+
+					for( ; i < chunkCount; ++i )
+					{
+						output[ start + i ] = math::Interpolations< ValueType >::CubicInterp( n[ 0 ][ i ], n[ 1 ][ i ], n[ 2 ][ i ], n[ 3 ][ i ],
+																							  alpha[ i ] );
+					}
+				}
+			}
+
+
+
+			//
+			// Private interface
+			//
+			private:
+
+			size_t
+			findInsertionPos( ValueType inputValue ) const
+			{
+				size_t	index = 0;
+
+				while( index < controlPoints.size() && controlPoints[ index ].inputValue < inputValue )
+				{
+					++index;
+				}
+
+				return index;
+			}
+
+			// Segment s lies between control points s - 1 and s and interpolates the outputs
+			// of points s - 2 to s + 1, clamped to the ends as in libnoise
+			void
+			compile()
+			{
+				size_t						count = controlPoints.size();
+				std::vector< ValueType >	inputs( count );
+
+				for( size_t i = 0; i < count; ++i )
+				{
+					inputs[ i ] = controlPoints[ i ].inputValue;
+				}
+
+				table.Build( count > 0 ? &inputs[ 0 ] : 0, count );
+				if( count == 0 )
+				{
+					return;
+				}
+
+				for( size_t segment = 0; segment <= count; ++segment )
+				{
+					size_t		index1 = clampIndex( int( segment ) - 1 );
+					size_t		index2 = clampIndex( int( segment ) );
+					ValueType	n[ 4 ] = { controlPoints[ clampIndex( int( segment ) - 2 ) ].outputValue,
+										   controlPoints[ index1 ].outputValue,
+										   controlPoints[ index2 ].outputValue,
+										   controlPoints[ clampIndex( int( segment ) + 1 ) ].outputValue };
+
+					if( index1 == index2 )
+					{
+						// Flat beyond the ends, the cubic of four equal values is that value
+						n[ 0 ] = n[ 1 ] = n[ 2 ] = n[ 3 ] = controlPoints[ index1 ].outputValue;
+						table.SetSegment( segment, ValueType( 0.0 ), ValueType( 0.0 ), n );
+					}
+					else
+					{
+						ValueType	width = controlPoints[ index2 ].inputValue - controlPoints[ index1 ].inputValue;
+						table.SetSegment( segment, controlPoints[ index1 ].inputValue, ValueType( 1.0 ) / width, n );
+					}
+				}
+			}
+
+			size_t
+			clampIndex( int index ) const
+			{
+				return index < 0 ? 0 : (size_t( index ) >= controlPoints.size() ? controlPoints.size() - 1 : size_t( index ));
+			}
+
+
+
+			//
+			// Fields
+			//
+			private:
+
+			std::vector< ControlPoint >		controlPoints;
+			Table							table;
+
+		};
+
+	}
+
+}
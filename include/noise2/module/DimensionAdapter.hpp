@@ -1,7 +1,16 @@
 #pragma once
 
 
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
 #include <noise2/module/Module.hpp>
+#include <noise2/module/Plan.hpp>
+#include <noise2/module/SliceKernel.hpp>
 
 
 
@@ -53,6 +62,20 @@ namespace noise2
 				return adaptee.GetValue( x );
 			}
 
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* /*inputY*/, ValueType* output ) const
+			{
+				adaptee.GetValue4( inputX, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* /*inputY*/, ValueType* output, size_t count ) const
+			{
+				adaptee.GetValueArray( inputX, output, count );
+			}
+
 		};
 
 		template< typename ValueT, typename AdaptedT >
@@ -93,8 +116,23 @@ namespace noise2
 				return adaptee.GetValue( x, y );
 			}
 
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				adaptee.GetValue4( inputX, inputY, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				adaptee.GetValueArray( inputX, inputY, output, count );
+			}
+
 		};
 
+		// The plane z = 0 of a 3D module, batches go through dimensionadapter::SliceKernel
 		template< typename ValueT, typename AdaptedT >
 		class DimensionAdapter< ValueT, 2, AdaptedT, 3 >: public Module< ValueT, 2 >
 		{
@@ -133,6 +171,20 @@ namespace noise2
 				return adaptee.GetValue( x, y, ValueType( 0.0 ) );
 			}
 
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				dimensionadapter::SliceKernel< AdaptedType >::getValue4( adaptee, inputX, inputY, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				dimensionadapter::SliceKernel< AdaptedType >::getValueArray( adaptee, inputX, inputY, output, count );
+			}
+
 		};
 
 		template< typename ValueT, typename AdaptedT >
@@ -147,6 +199,11 @@ namespace noise2
 			typedef Module< ValueType, Dimension >		ModuleType;
 			typedef DimensionAdapter< ValueType, Dimension, AdaptedType, 4 >		ThisType;
 
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
 
 
 		private:
@@ -173,6 +230,29 @@ namespace noise2
 				return adaptee.GetValue( x, y, ValueType( 0.0 ), ValueType( 0.0 ) );
 			}
 
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				VECTOR4_ALIGN( ValueType	zero[ 4 ] ) = { 0 };
+
+				adaptee.GetValue4( inputX, inputY, zero, zero, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				VECTOR4_ALIGN( ValueType	zero[ BlockSize ] ) = { 0 };
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					adaptee.GetValueArray( inputX + start, inputY + start, zero, zero, output + start, blockCount );
+				}
+			}
+
 		};
 
 	}
@@ -0,0 +1,125 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/module/Module.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Module calls on points given as arrays of coordinates, so that code written once for
+		// all dimensions can evaluate a Module< ValueType, Dimension >
+		namespace dispatch
+		{
+
+			template< typename ValueType >
+			inline
+			ValueType
+			getValue( const Module< ValueType, 1 >& module, const ValueType* point )
+			{
+				return module.GetValue( point[ 0 ] );
+			}
+
+			template< typename ValueType >
+			inline
+			ValueType
+			getValue( const Module< ValueType, 2 >& module, const ValueType* point )
+			{
+				return module.GetValue( point[ 0 ], point[ 1 ] );
+			}
+
+			template< typename ValueType >
+			inline
+			ValueType
+			getValue( const Module< ValueType, 3 >& module, const ValueType* point )
+			{
+				return module.GetValue( point[ 0 ], point[ 1 ], point[ 2 ] );
+			}
+
+			template< typename ValueType >
+			inline
+			ValueType
+			getValue( const Module< ValueType, 4 >& module, const ValueType* point )
+			{
+				return module.GetValue( point[ 0 ], point[ 1 ], point[ 2 ], point[ 3 ] );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValue4( const Module< ValueType, 1 >& module, const ValueType* const* input, ValueType* output )
+			{
+				module.GetValue4( input[ 0 ], output );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValue4( const Module< ValueType, 2 >& module, const ValueType* const* input, ValueType* output )
+			{
+				module.GetValue4( input[ 0 ], input[ 1 ], output );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValue4( const Module< ValueType, 3 >& module, const ValueType* const* input, ValueType* output )
+			{
+				module.GetValue4( input[ 0 ], input[ 1 ], input[ 2 ], output );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValue4( const Module< ValueType, 4 >& module, const ValueType* const* input, ValueType* output )
+			{
+				module.GetValue4( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], output );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValueArray( const Module< ValueType, 1 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], output, count );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValueArray( const Module< ValueType, 2 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], output, count );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValueArray( const Module< ValueType, 3 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], input[ 2 ], output, count );
+			}
+
+			template< typename ValueType >
+			inline
+			void
+			getValueArray( const Module< ValueType, 4 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], output, count );
+			}
+
+		}
+
+	}
+
+}
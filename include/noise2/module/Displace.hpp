@@ -0,0 +1,108 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/math/ArrayMath.hpp>
+#include <noise2/module/Dispatch.hpp>
+#include <noise2/module/Transformer.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Displace of libnoise: source 0 evaluated at the point moved by the values of the
+		// displacement modules, source 1 + axis displacing along axis. A block of points
+		// gets its displacements from the displacement modules' GetValueArray, under Plan
+		// they are buffered and may be shared with other modules.
+		template< typename ValueT, unsigned int Dimension >
+		class Displace: public Transformer< ValueT, Dimension >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			typedef Module< ValueType, Dimension >		ModuleType;
+			typedef Transformer< ValueType, Dimension >	TransformerType;
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Displace():
+			  TransformerType( Dimension + 1 )
+			{
+			}
+
+			virtual
+			~Displace()
+			{
+			}
+
+			const ModuleType&
+			GetDisplaceModule( int axis ) const
+			{
+				return this->GetSourceModule( axis + 1 );
+			}
+
+			void
+			SetDisplaceModule( int axis, const ModuleType& displaceModule )
+			{
+				this->SetSourceModule( axis + 1, displaceModule );
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int index ) const
+			{
+				return index > 0;
+			}
+
+			virtual
+			void
+			TransformPoint( const ValueType* point, ValueType* transformed ) const
+			{
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					transformed[ d ] = point[ d ] + dispatch::getValue( GetDisplaceModule( d ), point );
+				}
+			}
+
+			virtual
+			void
+			TransformArray( const ValueType* const* input, const ValueType* const* sourceValues, ValueType* const* transformed,
+							size_t count ) const
+			{
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					const ValueType*	displacement = sourceValues == 0 ? 0 : sourceValues[ d + 1 ];
+
+					if( displacement == 0 )
+					{
+						dispatch::getValueArray( GetDisplaceModule( d ), input, transformed[ d ], count );
+						displacement = transformed[ d ];
+					}
+
+					math::ArrayMath< ValueType >::add( input[ d ], displacement, transformed[ d ], count );
+				}
+			}
+
+		};
+
+	}
+
+}
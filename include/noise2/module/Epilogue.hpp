@@ -0,0 +1,697 @@
+#pragma once
+
+
+// Std C++
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/module/Modifier.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Point-wise mappings of a value, as policies which can run wherever a value is
+		// produced: apply() on a scalar and applyVector< M >() on a Math vector in
+		// registers. The modifier modules (ScaleBias, Clamp, ...) run them over the
+		// source's values; expression::scaleBias and friends run them on the vectors of the
+		// producing kernel before its store, so a chain of them costs no extra pass. Plan
+		// runs a chain of modifier modules as one Program over the values of the chain's
+		// source: one pass for the chain, Exponent aside, but still one after the source's
+		// own store.
+		namespace epilogue
+		{
+
+			// value * scale + bias
+			template< typename ValueT >
+			struct ScaleBias
+			{
+
+				typedef ValueT		ValueType;
+
+				ValueType	scale;
+				ValueType	bias;
+
+				explicit
+				ScaleBias( ValueType scale = ValueType( 1.0 ), ValueType bias = ValueType( 0.0 ) ):
+				  scale( scale ),
+				  bias( bias )
+				{}
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return value * scale + bias;
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return M::add( M::multiply( valueV, M::vectorizeOne( scale ) ), M::vectorizeOne( bias ) );
+				}
+#endif
+
+			};
+
+
+			// value limited to lowerBound up to upperBound
+			template< typename ValueT >
+			struct Clamp
+			{
+
+				typedef ValueT		ValueType;
+
+				ValueType	lowerBound;
+				ValueType	upperBound;
+
+				explicit
+				Clamp( ValueType lowerBound = ValueType( -1.0 ), ValueType upperBound = ValueType( 1.0 ) ):
+				  lowerBound( lowerBound ),
+				  upperBound( upperBound )
+				{}
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					if( value < lowerBound )
+					{
+						return lowerBound;
+					}
+					else if( value > upperBound )
+					{
+						return upperBound;
+					}
+
+					return value;
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return M::min( M::max( valueV, M::vectorizeOne( lowerBound ) ), M::vectorizeOne( upperBound ) );
+				}
+#endif
+
+			};
+
+
+			template< typename ValueT >
+			struct Abs
+			{
+
+				typedef ValueT		ValueType;
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return std::fabs( value );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return M::abs( valueV );
+				}
+#endif
+
+			};
+
+
+			template< typename ValueT >
+			struct Invert
+			{
+
+				typedef ValueT		ValueType;
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return -value;
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return M::subtract( M::constZeroF(), valueV );
+				}
+#endif
+
+			};
+
+
+			// Exponent of libnoise: the value mapped from -1 to 1 onto 0 to 1, raised to the
+			// exponent and mapped back
+			template< typename ValueT >
+			struct Exponent
+			{
+
+				typedef ValueT		ValueType;
+
+				ValueType	exponent;
+
+				explicit
+				Exponent( ValueType exponent = ValueType( 1.0 ) ):
+				  exponent( exponent )
+				{}
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return std::pow( std::fabs( (value + ValueType( 1.0 )) / ValueType( 2.0 ) ), exponent ) * ValueType( 2.0 ) - ValueType( 1.0 );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					typename M::VectorF	baseV = M::abs( M::multiply( M::add( valueV, M::constOneF() ), M::constHalfF() ) );
+					typename M::VectorF	powerV = M::pow( baseV, M::vectorizeOne( exponent ) );
+
+					return M::subtract( M::multiply( powerV, M::constTwoF() ), M::constOneF() );
+				}
+#endif
+
+			};
+
+
+			// FirstT, then SecondT
+			template< typename FirstT, typename SecondT >
+			struct Chain
+			{
+
+				typedef typename FirstT::ValueType		ValueType;
+
+				FirstT		first;
+				SecondT		second;
+
+				Chain( const FirstT& first, const SecondT& second ):
+				  first( first ),
+				  second( second )
+				{}
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return second.apply( first.apply( value ) );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return second.template applyVector< M >( first.template applyVector< M >( valueV ) );
+				}
+#endif
+
+			};
+
+
+			// epilogue over count values, Width at a time; output may alias values. The arrays
+			// have to be aligned as for GetValue4.
+			template< uint32 Width, typename EpilogueT >
+			inline
+			void
+			applyArray( const EpilogueT& epilogue, const typename EpilogueT::ValueType* values, typename EpilogueT::ValueType* output,
+						size_t count )
+			{
+				size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				typedef math::Math< typename EpilogueT::ValueType, Width >		M;
+
+				for( ; i + Width <= count; i += Width )
+				{
+					M::storeToMemory( output + i, epilogue.template applyVector< M >( M::loadFromMemory( values + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = epilogue.apply( values[ i ] );
+				}
+			}
+
+
+			// The epilogues above put together at run time, itself an epilogue. Plan appends
+			// those of a chain of modules (see Module::AppendEpilogue) and runs the chain as one
+			// epilogue: a run of operations other than Exponent is one pass over the values,
+			// each vector loaded and stored once, and Exponent, bound by its pow, a pass of its
+			// own. Each operation runs the code of its epilogue, so the values are those of the
+			// modules one after the other.
+			template< typename ValueT >
+			class Program
+			{
+
+			public:
+
+				typedef ValueT		ValueType;
+
+
+
+			private:
+
+				enum Kind
+				{
+					ScaleBiasKind,
+					ClampKind,
+					AbsKind,
+					InvertKind,
+					ExponentKind
+				};
+
+				// a and b are the parameters of the epilogue, in the order of its constructor
+				struct Operation
+				{
+					Kind		kind;
+					ValueType	a;
+					ValueType	b;
+				};
+
+				typedef typename std::vector< Operation >::const_iterator		OperationIterator;
+
+				std::vector< Operation >	operations;
+
+
+
+			public:
+
+				size_t
+				GetOperationCount() const
+				{
+					return operations.size();
+				}
+
+				// Appends the operations of epilogue, false and nothing appended for an
+				// EpilogueT not built of the epilogues above
+				template< typename EpilogueT >
+				bool
+				append( const EpilogueT& /*epilogue*/ )
+				{
+					return false;
+				}
+
+				bool
+				append( const ScaleBias< ValueType >& epilogue )
+				{
+					return push( ScaleBiasKind, epilogue.scale, epilogue.bias );
+				}
+
+				bool
+				append( const Clamp< ValueType >& epilogue )
+				{
+					return push( ClampKind, epilogue.lowerBound, epilogue.upperBound );
+				}
+
+				bool
+				append( const Abs< ValueType >& /*epilogue*/ )
+				{
+					return push( AbsKind );
+				}
+
+				bool
+				append( const Invert< ValueType >& /*epilogue*/ )
+				{
+					return push( InvertKind );
+				}
+
+				bool
+				append( const Exponent< ValueType >& epilogue )
+				{
+					return push( ExponentKind, epilogue.exponent );
+				}
+
+				template< typename FirstT, typename SecondT >
+				bool
+				append( const Chain< FirstT, SecondT >& epilogue )
+				{
+					size_t	operationCount = operations.size();
+
+					if( append( epilogue.first ) && append( epilogue.second ) )
+					{
+						return true;
+					}
+
+					operations.resize( operationCount );
+					return false;
+				}
+
+				inline
+				ValueType
+				apply( ValueType value ) const
+				{
+					return apply( operations.begin(), operations.end(), value );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& valueV ) const
+				{
+					return applyVector< M >( operations.begin(), operations.end(), valueV );
+				}
+#endif
+
+				// As epilogue::applyArray, in the passes described above. Without vectors every
+				// operation is a pass of its own, as in separate modules.
+				template< uint32 Width >
+				void
+				applyArray( const ValueType* values, ValueType* output, size_t count ) const
+				{
+					const ValueType*	sourceValues = values;
+
+					for( OperationIterator begin = operations.begin(); begin != operations.end(); sourceValues = output )
+					{
+						OperationIterator	end = begin + 1;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+						if( begin->kind != ExponentKind )
+						{
+							while( end != operations.end() && end->kind != ExponentKind )
+							{
+								++end;
+							}
+
+							applyRun< Width >( begin, end, sourceValues, output, count );
+							begin = end;
+							continue;
+						}
+#endif
+
+						applyOperation< Width >( *begin, sourceValues, output, count );
+						begin = end;
+					}
+
+					for( size_t i = 0; sourceValues != output && i < count; ++i )
+					{
+						output[ i ] = values[ i ];
+					}
+				}
+
+
+
+			private:
+
+				bool
+				push( Kind kind, ValueType a = ValueType( 0.0 ), ValueType b = ValueType( 0.0 ) )
+				{
+					Operation	operation;
+					operation.kind = kind;
+					operation.a = a;
+					operation.b = b;
+					operations.push_back( operation );
+
+					return true;
+				}
+
+				static inline
+				ValueType
+				apply( OperationIterator begin, OperationIterator end, ValueType value )
+				{
+					for( OperationIterator o = begin; o != end; ++o )
+					{
+						switch( o->kind )
+						{
+							case ScaleBiasKind:
+								value = ScaleBias< ValueType >( o->a, o->b ).apply( value );
+								break;
+
+							case ClampKind:
+								value = Clamp< ValueType >( o->a, o->b ).apply( value );
+								break;
+
+							case AbsKind:
+								value = Abs< ValueType >().apply( value );
+								break;
+
+							case InvertKind:
+								value = Invert< ValueType >().apply( value );
+								break;
+
+							case ExponentKind:
+								value = Exponent< ValueType >( o->a ).apply( value );
+								break;
+						}
+					}
+
+					return value;
+				}
+
+				template< uint32 Width >
+				static inline
+				void
+				applyOperation( const Operation& operation, const ValueType* values, ValueType* output, size_t count )
+				{
+					switch( operation.kind )
+					{
+						case ScaleBiasKind:
+							epilogue::applyArray< Width >( ScaleBias< ValueType >( operation.a, operation.b ), values, output, count );
+							break;
+
+						case ClampKind:
+							epilogue::applyArray< Width >( Clamp< ValueType >( operation.a, operation.b ), values, output, count );
+							break;
+
+						case AbsKind:
+							epilogue::applyArray< Width >( Abs< ValueType >(), values, output, count );
+							break;
+
+						case InvertKind:
+							epilogue::applyArray< Width >( Invert< ValueType >(), values, output, count );
+							break;
+
+						case ExponentKind:
+							epilogue::applyArray< Width >( Exponent< ValueType >( operation.a ), values, output, count );
+							break;
+					}
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< typename M >
+				static inline
+				typename M::VectorF
+				applyVector( OperationIterator begin, OperationIterator end, const typename M::VectorF& valueV )
+				{
+					typename M::VectorF	resultV = valueV;
+
+					for( OperationIterator o = begin; o != end; ++o )
+					{
+						switch( o->kind )
+						{
+							case ScaleBiasKind:
+								resultV = ScaleBias< ValueType >( o->a, o->b ).template applyVector< M >( resultV );
+								break;
+
+							case ClampKind:
+								resultV = Clamp< ValueType >( o->a, o->b ).template applyVector< M >( resultV );
+								break;
+
+							case AbsKind:
+								resultV = Abs< ValueType >().template applyVector< M >( resultV );
+								break;
+
+							case InvertKind:
+								resultV = Invert< ValueType >().template applyVector< M >( resultV );
+								break;
+
+							case ExponentKind:
+								resultV = Exponent< ValueType >( o->a ).template applyVector< M >( resultV );
+								break;
+						}
+					}
+
+					return resultV;
+				}
+
+				// One pass of the operations from begin to end, four vectors at a time kept in
+				// registers so that each operation is dispatched once for the four
+				template< uint32 Width >
+				static
+				void
+				applyRun( OperationIterator begin, OperationIterator end, const ValueType* values, ValueType* output, size_t count )
+				{
+					typedef math::Math< ValueType, Width >		M;
+
+					size_t	i = 0;
+
+					for( ; i + 4 * Width <= count; i += 4 * Width )
+					{
+						typename M::VectorF	value0V = M::loadFromMemory( values + i );
+						typename M::VectorF	value1V = M::loadFromMemory( values + i + Width );
+						typename M::VectorF	value2V = M::loadFromMemory( values + i + 2 * Width );
+						typename M::VectorF	value3V = M::loadFromMemory( values + i + 3 * Width );
+
+						for( OperationIterator o = begin; o != end; ++o )
+						{
+							switch( o->kind )
+							{
+								case ScaleBiasKind:
+									applyTile< M >( ScaleBias< ValueType >( o->a, o->b ), value0V, value1V, value2V, value3V );
+									break;
+
+								case ClampKind:
+									applyTile< M >( Clamp< ValueType >( o->a, o->b ), value0V, value1V, value2V, value3V );
+									break;
+
+								case AbsKind:
+									applyTile< M >( Abs< ValueType >(), value0V, value1V, value2V, value3V );
+									break;
+
+								case InvertKind:
+									applyTile< M >( Invert< ValueType >(), value0V, value1V, value2V, value3V );
+									break;
+
+								case ExponentKind:
+									// Not in runs, its pow is too long to be inlined four times
+									break;
+							}
+						}
+
+						M::storeToMemory( output + i, value0V );
+						M::storeToMemory( output + i + Width, value1V );
+						M::storeToMemory( output + i + 2 * Width, value2V );
+						M::storeToMemory( output + i + 3 * Width, value3V );
+					}
+
+					for( ; i + Width <= count; i += Width )
+					{
+						M::storeToMemory( output + i, applyVector< M >( begin, end, M::loadFromMemory( values + i ) ) );
+					}
+
+					for( ; i < count; ++i )
+					{
+						output[ i ] = apply( begin, end, values[ i ] );
+					}
+				}
+
+				template< typename M, typename EpilogueT >
+				static inline
+				void
+				applyTile( const EpilogueT& epilogue, typename M::VectorF& value0V, typename M::VectorF& value1V,
+						   typename M::VectorF& value2V, typename M::VectorF& value3V )
+				{
+					value0V = epilogue.template applyVector< M >( value0V );
+					value1V = epilogue.template applyVector< M >( value1V );
+					value2V = epilogue.template applyVector< M >( value2V );
+					value3V = epilogue.template applyVector< M >( value3V );
+				}
+#endif
+
+			};
+
+
+			template< uint32 Width, typename ValueT >
+			inline
+			void
+			applyArray( const Program< ValueT >& program, const ValueT* values, ValueT* output, size_t count )
+			{
+				program.template applyArray< Width >( values, output, count );
+			}
+
+
+			// applyArray at the width modules evaluate blocks with: 4 for the values of
+			// GetValue4, the native width for all other counts
+			template< typename EpilogueT >
+			inline
+			void
+			applyBlock( const EpilogueT& epilogue, const typename EpilogueT::ValueType* values, typename EpilogueT::ValueType* output,
+						size_t count )
+			{
+				if( count == 4 )
+				{
+					applyArray< 4 >( epilogue, values, output, count );
+				}
+				else
+				{
+					applyArray< math::NativeWidth< typename EpilogueT::ValueType >::Value >( epilogue, values, output, count );
+				}
+			}
+
+
+			// Modifier module running EpilogueT
+			template< typename ValueT, unsigned int Dimension, typename EpilogueT >
+			class EpilogueModifier: public Modifier< ValueT, Dimension >
+			{
+
+			public:
+
+				typedef ValueT			ValueType;
+				typedef EpilogueT		EpilogueType;
+
+
+
+			protected:
+
+				EpilogueType	epilogue;
+
+
+
+			public:
+
+				const EpilogueType&
+				GetEpilogue() const
+				{
+					return epilogue;
+				}
+
+				virtual
+				ValueType
+				ModifyValue( ValueType value ) const
+				{
+					return epilogue.apply( value );
+				}
+
+				virtual
+				void
+				ModifyArray( const ValueType* values, ValueType* output, size_t count ) const
+				{
+					applyBlock( epilogue, values, output, count );
+				}
+
+				virtual
+				bool
+				AppendEpilogue( Program< ValueType >& program ) const
+				{
+					return program.append( epilogue );
+				}
+
+			};
+
+		}
+
+	}
+
+}
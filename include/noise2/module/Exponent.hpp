@@ -0,0 +1,42 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Source value mapped onto 0 to 1, raised to the exponent and mapped back to -1 to 1, as in
+		// libnoise
+		template< typename ValueT, unsigned int Dimension >
+		class Exponent: public epilogue::EpilogueModifier< ValueT, Dimension, epilogue::Exponent< ValueT > >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			ValueType
+			GetExponent() const
+			{
+				return this->epilogue.exponent;
+			}
+
+			void
+			SetExponent( ValueType exponent )
+			{
+				this->epilogue.exponent = exponent;
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,826 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Epilogue.hpp>
+#include <noise2/module/Perlin.hpp>
+#include <noise2/module/Billow.hpp>
+#include <noise2/module/RidgedMulti.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Module graphs composed at compile time. add( perlin, ridged ) returns an expression
+		// whose type is the whole graph, so its evaluation is one inlined function with no
+		// virtual calls; vectorized, the source kernels share registers and one loop.
+		//
+		//	expression::getValueArray( expression::add( perlin, ridged ), count, x, y, z, output );
+		//
+		// The epilogue policies (scaleBias, clamp, abs, invert, exponent) map the vectors of
+		// their operand in registers, so a chain of them runs in the store of the source
+		// kernel:
+		//
+		//	expression::getValueArray( expression::clamp( expression::scaleBias( perlin, 0.5, 0.5 ), 0, 1 ), ... );
+		//
+		// Leaves keep references to their modules, which have to outlive the expression.
+		// Adapter wraps an expression into a runtime Module. Vector evaluation is three
+		// dimensional, like the module kernels it inlines; the adapters of the other
+		// dimensions evaluate their arrays point by point, with the expression inlined.
+		namespace expression
+		{
+
+			namespace impl
+			{
+
+				// Calls qualified with the concrete module type bind statically. A leaf over
+				// the abstract Module is the more specialized match and calls virtually.
+				template< typename ModuleT >
+				inline
+				typename ModuleT::ValueType
+				getValue( const ModuleT& module, typename ModuleT::ValueType x )
+				{
+					return module.ModuleT::GetValue( x );
+				}
+
+				template< typename ModuleT >
+				inline
+				typename ModuleT::ValueType
+				getValue( const ModuleT& module, typename ModuleT::ValueType x, typename ModuleT::ValueType y )
+				{
+					return module.ModuleT::GetValue( x, y );
+				}
+
+				template< typename ModuleT >
+				inline
+				typename ModuleT::ValueType
+				getValue( const ModuleT& module, typename ModuleT::ValueType x, typename ModuleT::ValueType y,
+						  typename ModuleT::ValueType z )
+				{
+					return module.ModuleT::GetValue( x, y, z );
+				}
+
+				template< typename ModuleT >
+				inline
+				typename ModuleT::ValueType
+				getValue( const ModuleT& module, typename ModuleT::ValueType x, typename ModuleT::ValueType y,
+						  typename ModuleT::ValueType z, typename ModuleT::ValueType w )
+				{
+					return module.ModuleT::GetValue( x, y, z, w );
+				}
+
+				template< typename ValueType >
+				inline
+				ValueType
+				getValue( const Module< ValueType, 1 >& module, ValueType x )
+				{
+					return module.GetValue( x );
+				}
+
+				template< typename ValueType >
+				inline
+				ValueType
+				getValue( const Module< ValueType, 2 >& module, ValueType x, ValueType y )
+				{
+					return module.GetValue( x, y );
+				}
+
+				template< typename ValueType >
+				inline
+				ValueType
+				getValue( const Module< ValueType, 3 >& module, ValueType x, ValueType y, ValueType z )
+				{
+					return module.GetValue( x, y, z );
+				}
+
+				template< typename ValueType >
+				inline
+				ValueType
+				getValue( const Module< ValueType, 4 >& module, ValueType x, ValueType y, ValueType z, ValueType w )
+				{
+					return module.GetValue( x, y, z, w );
+				}
+
+			}
+
+
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+			// Vector evaluation of a leaf module. Modules without a register kernel are
+			// evaluated lane by lane.
+			template< typename ModuleT >
+			struct Kernel
+			{
+
+				typedef typename ModuleT::ValueType		ValueType;
+
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				getValueVector( const ModuleT& module, const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV )
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					VECTOR4_ALIGN( ValueType	x[ Width ] );
+					VECTOR4_ALIGN( ValueType	y[ Width ] );
+					VECTOR4_ALIGN( ValueType	z[ Width ] );
+					MW::storeToMemory( x, xV );
+					MW::storeToMemory( y, yV );
+					MW::storeToMemory( z, zV );
+
+					for( uint32 i = 0; i < Width; ++i )
+					{
+						x[ i ] = impl::getValue( module, x[ i ], y[ i ], z[ i ] );
+					}
+
+					return MW::loadFromMemory( x );
+				}
+
+			};
+
+			template< typename ValueType >
+			struct Kernel< Perlin< ValueType, 3 > >
+			{
+
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				getValueVector( const Perlin< ValueType, 3 >& module, const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV )
+				{
+					return module.template GetValueVector< Width >( xV, yV, zV );
+				}
+
+			};
+
+			template< typename ValueType >
+			struct Kernel< Billow< ValueType, 3 > >
+			{
+
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				getValueVector( const Billow< ValueType, 3 >& module, const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV )
+				{
+					return module.template GetValueVector< Width >( xV, yV, zV );
+				}
+
+			};
+
+			template< typename ValueType >
+			struct Kernel< RidgedMulti< ValueType, 3 > >
+			{
+
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				getValueVector( const RidgedMulti< ValueType, 3 >& module, const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV )
+				{
+					return module.template GetValueVector< Width >( xV, yV, zV );
+				}
+
+			};
+#endif
+
+
+
+			// A module in an expression. The module is held by reference, not copied: it has to
+			// outlive the leaf and every expression or Adapter built over it, and changes to
+			// its parameters show in their values.
+			template< typename ModuleT >
+			class Leaf
+			{
+
+			public:
+
+				typedef ModuleT						ModuleType;
+				typedef typename ModuleT::ValueType	ValueType;
+
+
+
+			private:
+
+				const ModuleType&	module;
+
+
+
+			public:
+
+				explicit
+				Leaf( const ModuleType& module ):
+				  module( module )
+				{}
+
+				inline
+				ValueType
+				GetValue( ValueType x ) const
+				{
+					return impl::getValue( module, x );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					return impl::getValue( module, x, y );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					return impl::getValue( module, x, y, z );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+				{
+					return impl::getValue( module, x, y, z, w );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< uint32 Width >
+				inline
+				typename math::Math< ValueType, Width >::VectorF
+				GetValueVector( const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV ) const
+				{
+					return Kernel< ModuleType >::template getValueVector< Width >( module, xV, yV, zV );
+				}
+#endif
+
+			};
+
+
+
+			// Combines the values of two expressions, OperatorT provides apply() for scalars
+			// and applyVector() for Math vectors
+			template< typename OperatorT, typename LeftT, typename RightT >
+			class Binary
+			{
+
+			public:
+
+				typedef typename LeftT::ValueType	ValueType;
+
+
+
+			private:
+
+				LeftT		left;
+				RightT		right;
+
+
+
+			public:
+
+				Binary( const LeftT& left, const RightT& right ):
+				  left( left ),
+				  right( right )
+				{}
+
+				inline
+				ValueType
+				GetValue( ValueType x ) const
+				{
+					return OperatorT::apply( left.GetValue( x ), right.GetValue( x ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					return OperatorT::apply( left.GetValue( x, y ), right.GetValue( x, y ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					return OperatorT::apply( left.GetValue( x, y, z ), right.GetValue( x, y, z ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+				{
+					return OperatorT::apply( left.GetValue( x, y, z, w ), right.GetValue( x, y, z, w ) );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< uint32 Width >
+				inline
+				typename math::Math< ValueType, Width >::VectorF
+				GetValueVector( const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV ) const
+				{
+					return OperatorT::template applyVector< math::Math< ValueType, Width > >( left.template GetValueVector< Width >( xV, yV, zV ),
+																							 right.template GetValueVector< Width >( xV, yV, zV ) );
+				}
+#endif
+
+			};
+
+
+
+			struct AddOperator
+			{
+
+				template< typename ValueType >
+				static inline
+				ValueType
+				apply( ValueType l, ValueType r )
+				{
+					return l + r;
+				}
+
+				template< typename M >
+				static inline
+				typename M::VectorF
+				applyVector( const typename M::VectorF& l, const typename M::VectorF& r )
+				{
+					return M::add( l, r );
+				}
+
+			};
+
+
+
+			// Maps the values of an expression, EpilogueT is one of the module::epilogue policies
+			template< typename EpilogueT, typename OperandT >
+			class Unary
+			{
+
+			public:
+
+				typedef typename OperandT::ValueType	ValueType;
+
+
+
+			private:
+
+				EpilogueT	epilogue;
+				OperandT	operand;
+
+
+
+			public:
+
+				Unary( const EpilogueT& epilogue, const OperandT& operand ):
+				  epilogue( epilogue ),
+				  operand( operand )
+				{}
+
+				inline
+				ValueType
+				GetValue( ValueType x ) const
+				{
+					return epilogue.apply( operand.GetValue( x ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					return epilogue.apply( operand.GetValue( x, y ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					return epilogue.apply( operand.GetValue( x, y, z ) );
+				}
+
+				inline
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+				{
+					return epilogue.apply( operand.GetValue( x, y, z, w ) );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				template< uint32 Width >
+				inline
+				typename math::Math< ValueType, Width >::VectorF
+				GetValueVector( const typename math::Math< ValueType, Width >::VectorF& xV,
+								const typename math::Math< ValueType, Width >::VectorF& yV,
+								const typename math::Math< ValueType, Width >::VectorF& zV ) const
+				{
+					return epilogue.template applyVector< math::Math< ValueType, Width > >( operand.template GetValueVector< Width >( xV, yV, zV ) );
+				}
+#endif
+
+			};
+
+
+
+			// Expression type of an argument, modules become leaves
+			template< typename T >
+			struct Wrap
+			{
+				typedef Leaf< T >		Type;
+			};
+
+			template< typename ModuleT >
+			struct Wrap< Leaf< ModuleT > >
+			{
+				typedef Leaf< ModuleT >		Type;
+			};
+
+			template< typename OperatorT, typename LeftT, typename RightT >
+			struct Wrap< Binary< OperatorT, LeftT, RightT > >
+			{
+				typedef Binary< OperatorT, LeftT, RightT >		Type;
+			};
+
+			template< typename EpilogueT, typename OperandT >
+			struct Wrap< Unary< EpilogueT, OperandT > >
+			{
+				typedef Unary< EpilogueT, OperandT >		Type;
+			};
+
+
+
+			template< typename ModuleT >
+			inline
+			Leaf< ModuleT >
+			source( const ModuleT& module )
+			{
+				return Leaf< ModuleT >( module );
+			}
+
+			template< typename L, typename R >
+			inline
+			Binary< AddOperator, typename Wrap< L >::Type, typename Wrap< R >::Type >
+			add( const L& l, const R& r )
+			{
+				return Binary< AddOperator, typename Wrap< L >::Type, typename Wrap< R >::Type >( typename Wrap< L >::Type( l ),
+																								  typename Wrap< R >::Type( r ) );
+			}
+
+			template< typename T >
+			inline
+			Unary< epilogue::ScaleBias< typename Wrap< T >::Type::ValueType >, typename Wrap< T >::Type >
+			scaleBias( const T& operand, typename Wrap< T >::Type::ValueType scale, typename Wrap< T >::Type::ValueType bias )
+			{
+				typedef typename Wrap< T >::Type	OperandType;
+
+				return Unary< epilogue::ScaleBias< typename OperandType::ValueType >, OperandType >(
+					epilogue::ScaleBias< typename OperandType::ValueType >( scale, bias ), OperandType( operand ) );
+			}
+
+			template< typename T >
+			inline
+			Unary< epilogue::Clamp< typename Wrap< T >::Type::ValueType >, typename Wrap< T >::Type >
+			clamp( const T& operand, typename Wrap< T >::Type::ValueType lowerBound, typename Wrap< T >::Type::ValueType upperBound )
+			{
+				typedef typename Wrap< T >::Type	OperandType;
+
+				return Unary< epilogue::Clamp< typename OperandType::ValueType >, OperandType >(
+					epilogue::Clamp< typename OperandType::ValueType >( lowerBound, upperBound ), OperandType( operand ) );
+			}
+
+			template< typename T >
+			inline
+			Unary< epilogue::Abs< typename Wrap< T >::Type::ValueType >, typename Wrap< T >::Type >
+			abs( const T& operand )
+			{
+				typedef typename Wrap< T >::Type	OperandType;
+
+				return Unary< epilogue::Abs< typename OperandType::ValueType >, OperandType >(
+					epilogue::Abs< typename OperandType::ValueType >(), OperandType( operand ) );
+			}
+
+			template< typename T >
+			inline
+			Unary< epilogue::Invert< typename Wrap< T >::Type::ValueType >, typename Wrap< T >::Type >
+			invert( const T& operand )
+			{
+				typedef typename Wrap< T >::Type	OperandType;
+
+				return Unary< epilogue::Invert< typename OperandType::ValueType >, OperandType >(
+					epilogue::Invert< typename OperandType::ValueType >(), OperandType( operand ) );
+			}
+
+			template< typename T >
+			inline
+			Unary< epilogue::Exponent< typename Wrap< T >::Type::ValueType >, typename Wrap< T >::Type >
+			exponent( const T& operand, typename Wrap< T >::Type::ValueType exponent )
+			{
+				typedef typename Wrap< T >::Type	OperandType;
+
+				return Unary< epilogue::Exponent< typename OperandType::ValueType >, OperandType >(
+					epilogue::Exponent< typename OperandType::ValueType >( exponent ), OperandType( operand ) );
+			}
+
+
+
+			// Evaluates count points, Width of them per iteration and the rest one by one.
+			// The arrays have to be aligned as for GetValue4.
+			template< uint32 Width, typename ExpressionT >
+			inline
+			void
+			getValueArray( const ExpressionT& expression, uint32 count, const typename ExpressionT::ValueType* inputX,
+						   const typename ExpressionT::ValueType* inputY, const typename ExpressionT::ValueType* inputZ,
+						   typename ExpressionT::ValueType* output )
+			{
+				uint32	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				typedef math::Math< typename ExpressionT::ValueType, Width >		MW;
+
+				for( ; i + Width <= count; i += Width )
+				{
+					MW::storeToMemory( output + i, expression.template GetValueVector< Width >( MW::loadFromMemory( inputX + i ),
+																								MW::loadFromMemory( inputY + i ),
+																								MW::loadFromMemory( inputZ + i ) ) );
+				}
+#endif
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = expression.GetValue( inputX[ i ], inputY[ i ], inputZ[ i ] );
+				}
+			}
+
+			template< typename ExpressionT >
+			inline
+			void
+			getValueArray( const ExpressionT& expression, uint32 count, const typename ExpressionT::ValueType* inputX,
+						   const typename ExpressionT::ValueType* inputY, const typename ExpressionT::ValueType* inputZ,
+						   typename ExpressionT::ValueType* output )
+			{
+				getValueArray< math::NativeWidth< typename ExpressionT::ValueType >::Value >( expression, count, inputX, inputY,
+																							 inputZ, output );
+			}
+
+
+
+			// An expression as a runtime Module, for graphs mixing both
+			template< typename ExpressionT, unsigned int Dimension >
+			class Adapter;
+
+
+			template< typename ExpressionT >
+			class Adapter< ExpressionT, 1 >: public Module< typename ExpressionT::ValueType, 1 >
+			{
+
+			public:
+
+				typedef typename ExpressionT::ValueType		ValueType;
+				static const unsigned int					Dimension = 1;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+
+
+			private:
+
+				ExpressionT		expression;
+
+
+
+			public:
+
+				explicit
+				Adapter( const ExpressionT& expression ):
+				  ModuleType( 0 ),
+				  expression( expression )
+				{}
+
+				virtual
+				~Adapter()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x ) const
+				{
+					return expression.GetValue( x );
+				}
+
+				virtual
+				void
+				GetValue4( const ValueType* inputX, ValueType* output ) const
+				{
+					for( uint8 i = 0; i < 4; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ] );
+					}
+				}
+
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+				{
+					for( size_t i = 0; i < count; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ] );
+					}
+				}
+
+			};
+
+
+			template< typename ExpressionT >
+			class Adapter< ExpressionT, 2 >: public Module< typename ExpressionT::ValueType, 2 >
+			{
+
+			public:
+
+				typedef typename ExpressionT::ValueType		ValueType;
+				static const unsigned int					Dimension = 2;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+
+
+			private:
+
+				ExpressionT		expression;
+
+
+
+			public:
+
+				explicit
+				Adapter( const ExpressionT& expression ):
+				  ModuleType( 0 ),
+				  expression( expression )
+				{}
+
+				virtual
+				~Adapter()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					return expression.GetValue( x, y );
+				}
+
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+				{
+					for( uint8 i = 0; i < 4; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ], inputY[ i ] );
+					}
+				}
+
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					for( size_t i = 0; i < count; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ], inputY[ i ] );
+					}
+				}
+
+			};
+
+
+			template< typename ExpressionT >
+			class Adapter< ExpressionT, 3 >: public Module< typename ExpressionT::ValueType, 3 >
+			{
+
+			public:
+
+				typedef typename ExpressionT::ValueType		ValueType;
+				static const unsigned int					Dimension = 3;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+
+
+			private:
+
+				ExpressionT		expression;
+
+
+
+			public:
+
+				explicit
+				Adapter( const ExpressionT& expression ):
+				  ModuleType( 0 ),
+				  expression( expression )
+				{}
+
+				virtual
+				~Adapter()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					return expression.GetValue( x, y, z );
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+				{
+					getValueArray< 4 >( expression, 4, inputX, inputY, inputZ, output );
+				}
+#endif
+
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+							   size_t count ) const
+				{
+					getValueArray( expression, uint32( count ), inputX, inputY, inputZ, output );
+				}
+
+			};
+
+
+			template< typename ExpressionT >
+			class Adapter< ExpressionT, 4 >: public Module< typename ExpressionT::ValueType, 4 >
+			{
+
+			public:
+
+				typedef typename ExpressionT::ValueType		ValueType;
+				static const unsigned int					Dimension = 4;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+
+
+			private:
+
+				ExpressionT		expression;
+
+
+
+			public:
+
+				explicit
+				Adapter( const ExpressionT& expression ):
+				  ModuleType( 0 ),
+				  expression( expression )
+				{}
+
+				virtual
+				~Adapter()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+				{
+					return expression.GetValue( x, y, z, w );
+				}
+
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output ) const
+				{
+					for( uint8 i = 0; i < 4; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ], inputY[ i ], inputZ[ i ], inputW[ i ] );
+					}
+				}
+
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+							   ValueType* output, size_t count ) const
+				{
+					for( size_t i = 0; i < count; ++i )
+					{
+						output[ i ] = expression.GetValue( inputX[ i ], inputY[ i ], inputZ[ i ], inputW[ i ] );
+					}
+				}
+
+			};
+
+		}
+
+	}
+
+}
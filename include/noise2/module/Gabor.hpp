@@ -3,6 +3,7 @@
 
 #include <noise2/Platform.hpp>
 #include <noise2/BasicTypes.hpp>
+#include <noise2/math/Precision.hpp>
 
 
 
@@ -13,13 +14,14 @@ namespace noise2
 	namespace module
 	{
 
-		template< typename ValueType, uint8 Dimension >
+		// Precision selects the exp and cos tier of the kernel, see math/Precision.hpp
+		template< typename ValueType, uint8 Dimension, typename Precision = math::precision::Accurate >
 		class Gabor;
 
 
 		namespace gabor
 		{
-			template< typename ValueType, uint8 Dimension, uint8 VectorSize >
+			template< typename ValueType, uint8 Dimension, uint8 VectorSize, typename Precision >
 			class GaborImpl;
 		}
 
@@ -33,8 +35,8 @@ namespace noise2
 {
 	namespace module
 	{
-		template< typename ValueType, uint8 Dimension >
-		class Gabor: public gabor::GaborImpl< ValueType, Dimension, 4 >
+		template< typename ValueType, uint8 Dimension, typename Precision >
+		class Gabor: public gabor::GaborImpl< ValueType, Dimension, 4, Precision >
 		{
 		};
 	}
@@ -45,8 +47,8 @@ namespace noise2
 {
 	namespace module
 	{
-		template< typename ValueType, uint8 Dimension >
-		class Gabor: public gabor::GaborImpl< ValueType, Dimension, 1 >
+		template< typename ValueType, uint8 Dimension, typename Precision >
+		class Gabor: public gabor::GaborImpl< ValueType, Dimension, 1, Precision >
 		{
 		};
 	}
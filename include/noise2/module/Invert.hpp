@@ -0,0 +1,29 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Negated value of the source
+		template< typename ValueT, unsigned int Dimension >
+		class Invert: public epilogue::EpilogueModifier< ValueT, Dimension, epilogue::Invert< ValueT > >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+		};
+
+	}
+
+}
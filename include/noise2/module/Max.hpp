@@ -0,0 +1,61 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+
+
+// libnoise
+#include "noise2/math/ArrayMath.hpp"
+#include "noise2/module/Combiner.hpp"
+
+
+
+
+namespace noise2
+{
+	
+	namespace module
+	{
+
+		namespace combiner
+		{
+
+			template< typename ValueType >
+			struct MaxOperator
+			{
+
+				enum
+				{
+					SourceCount = 2
+				};
+
+				static inline
+				ValueType
+				apply( const ValueType* values )
+				{
+					return std::max( values[ 0 ], values[ 1 ] );
+				}
+
+				template< uint32 Width >
+				static inline
+				void
+				applyArray( const ValueType* const* sourceValues, ValueType* output, size_t count )
+				{
+					math::ArrayMath< ValueType, Width >::max( sourceValues[ 0 ], sourceValues[ 1 ], output, count );
+				}
+
+			};
+
+		}
+
+
+		// Larger of the values of the two sources
+		template< typename ValueType, unsigned int Dimension >
+		class Max: public Combiner< ValueType, Dimension, combiner::MaxOperator< ValueType > >
+		{
+		};
+		
+	}
+	
+}
@@ -0,0 +1,393 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/BasicTypes.hpp>
+#include <noise2/module/Module.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Module which maps the value of its single source, point by point. Subclasses supply
+		// ModifyValue for one value and ModifyArray for many; output of ModifyArray may alias
+		// values. GetValue4 and GetValueArray map the source's own vectors in place, under
+		// Plan the source is buffered. See also epilogue::EpilogueModifier.
+		template< typename ValueT, unsigned int Dimension >
+		class Modifier;
+
+
+		template< typename ValueT >
+		class Modifier< ValueT, 1 >: public Module< ValueT, 1 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 1;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Modifier():
+			  ModuleType( 1 )
+			{
+			}
+
+			virtual
+			~Modifier()
+			{
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const = 0;
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const = 0;
+
+			virtual
+			ValueType
+			GetValue( ValueType x ) const
+			{
+				return ModifyValue( this->GetSourceModule( 0 ).GetValue( x ) );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, ValueType* output ) const
+			{
+				this->GetSourceModule( 0 ).GetValue4( inputX, output );
+				ModifyArray( output, output, 4 );
+			}
+
+			// A block at a time, so that the values are still in cache when modified
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					this->GetSourceModule( 0 ).GetValueArray( inputX + start, output + start, blockCount );
+					ModifyArray( output + start, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				ModifyArray( sourceValues[ 0 ], output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Modifier< ValueT, 2 >: public Module< ValueT, 2 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 2;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Modifier():
+			  ModuleType( 1 )
+			{
+			}
+
+			virtual
+			~Modifier()
+			{
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const = 0;
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const = 0;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y ) const
+			{
+				return ModifyValue( this->GetSourceModule( 0 ).GetValue( x, y ) );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				this->GetSourceModule( 0 ).GetValue4( inputX, inputY, output );
+				ModifyArray( output, output, 4 );
+			}
+
+			// A block at a time, so that the values are still in cache when modified
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					this->GetSourceModule( 0 ).GetValueArray( inputX + start, inputY + start, output + start, blockCount );
+					ModifyArray( output + start, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				ModifyArray( sourceValues[ 0 ], output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Modifier< ValueT, 3 >: public Module< ValueT, 3 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 3;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Modifier():
+			  ModuleType( 1 )
+			{
+			}
+
+			virtual
+			~Modifier()
+			{
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const = 0;
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const = 0;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z ) const
+			{
+				return ModifyValue( this->GetSourceModule( 0 ).GetValue( x, y, z ) );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+			{
+				this->GetSourceModule( 0 ).GetValue4( inputX, inputY, inputZ, output );
+				ModifyArray( output, output, 4 );
+			}
+
+			// A block at a time, so that the values are still in cache when modified
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					this->GetSourceModule( 0 ).GetValueArray( inputX + start, inputY + start, inputZ + start, output + start, blockCount );
+					ModifyArray( output + start, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* /*inputZ*/,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				ModifyArray( sourceValues[ 0 ], output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Modifier< ValueT, 4 >: public Module< ValueT, 4 >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = 4;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Modifier():
+			  ModuleType( 1 )
+			{
+			}
+
+			virtual
+			~Modifier()
+			{
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const = 0;
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const = 0;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+			{
+				return ModifyValue( this->GetSourceModule( 0 ).GetValue( x, y, z, w ) );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+					   ValueType* output ) const
+			{
+				this->GetSourceModule( 0 ).GetValue4( inputX, inputY, inputZ, inputW, output );
+				ModifyArray( output, output, 4 );
+			}
+
+			// A block at a time, so that the values are still in cache when modified
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+					this->GetSourceModule( 0 ).GetValueArray( inputX + start, inputY + start, inputZ + start, inputW + start, output + start, blockCount );
+					ModifyArray( output + start, output + start, blockCount );
+				}
+			}
+
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return true;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* /*inputX*/, const ValueType* /*inputY*/, const ValueType* /*inputZ*/, const ValueType* /*inputW*/,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				ModifyArray( sourceValues[ 0 ], output, count );
+			}
+
+		};
+
+	}
+
+}
@@ -1,18 +1,37 @@
 #pragma once
 
 
+// Std C++
+#include <cstddef>
+
+
 // libnoise
+#include "noise2/BasicTypes.hpp"
 #include "noise2/module/ModuleBase.hpp"
 
 
 
 
+// Number of points a Plan evaluates per module call
+#if !defined( LIBNOISE2_PLAN_BLOCK_SIZE )
+#define LIBNOISE2_PLAN_BLOCK_SIZE		256
+#endif
+
+
+
 namespace noise2
 {
 	
 	namespace module
 	{
 		
+		namespace epilogue
+		{
+			template< typename ValueT >
+			class Program;
+		}
+		
+		
 		template< typename ValueType, unsigned int Dimension >
 		class Module;
 		
@@ -60,6 +79,53 @@ namespace noise2
 					output[ i ] = GetValue( inputX[ i ] );
 				}
 			}
+
+			// Values of count points, the arrays have to be aligned as for GetValue4
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				size_t	i = 0;
+
+				for( ; i + 4 <= count; i += 4 )
+				{
+					GetValue4( inputX + i, output + i );
+				}
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = GetValue( inputX[ i ] );
+				}
+			}
+
+			// Block evaluation by Plan. A module which only combines the values of some of its
+			// sources at each point gets them computed in advance, sourceValues[ i ] holds those
+			// of source i or is null where IsSourceBuffered( i ) is false. A module buffering none
+			// of its sources is evaluated by its GetValueArray.
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* const* /*sourceValues*/,
+						  ValueType* output, size_t count ) const
+			{
+				GetValueArray( inputX, output, count );
+			}
+			
+			// Point-wise mapping of the values of its single buffered source, appended to
+			// program as epilogue operations, so that Plan runs a chain of such modules in one
+			// pass. False, leaving program unchanged, if the module has no such form.
+			virtual
+			bool
+			AppendEpilogue( epilogue::Program< ValueType >& /*program*/ ) const
+			{
+				return false;
+			}
 			
 		};
 		
@@ -107,6 +173,53 @@ namespace noise2
 					output[ i ] = GetValue( inputX[ i ], inputY[ i ] );
 				}
 			}
+
+			// Values of count points, the arrays have to be aligned as for GetValue4
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				size_t	i = 0;
+
+				for( ; i + 4 <= count; i += 4 )
+				{
+					GetValue4( inputX + i, inputY + i, output + i );
+				}
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = GetValue( inputX[ i ], inputY[ i ] );
+				}
+			}
+
+			// Block evaluation by Plan. A module which only combines the values of some of its
+			// sources at each point gets them computed in advance, sourceValues[ i ] holds those
+			// of source i or is null where IsSourceBuffered( i ) is false. A module buffering none
+			// of its sources is evaluated by its GetValueArray.
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* const* /*sourceValues*/,
+						  ValueType* output, size_t count ) const
+			{
+				GetValueArray( inputX, inputY, output, count );
+			}
+			
+			// Point-wise mapping of the values of its single buffered source, appended to
+			// program as epilogue operations, so that Plan runs a chain of such modules in one
+			// pass. False, leaving program unchanged, if the module has no such form.
+			virtual
+			bool
+			AppendEpilogue( epilogue::Program< ValueType >& /*program*/ ) const
+			{
+				return false;
+			}
 			
 		};
 		
@@ -154,6 +267,54 @@ namespace noise2
 					output[ i ] = GetValue( inputX[ i ], inputY[ i ], inputZ[ i ] );
 				}
 			}
+
+			// Values of count points, the arrays have to be aligned as for GetValue4
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				size_t	i = 0;
+
+				for( ; i + 4 <= count; i += 4 )
+				{
+					GetValue4( inputX + i, inputY + i, inputZ + i, output + i );
+				}
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = GetValue( inputX[ i ], inputY[ i ], inputZ[ i ] );
+				}
+			}
+
+			// Block evaluation by Plan. A module which only combines the values of some of its
+			// sources at each point gets them computed in advance, sourceValues[ i ] holds those
+			// of source i or is null where IsSourceBuffered( i ) is false. A module buffering none
+			// of its sources is evaluated by its GetValueArray.
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ,
+						  const ValueType* const* /*sourceValues*/, ValueType* output, size_t count ) const
+			{
+				GetValueArray( inputX, inputY, inputZ, output, count );
+			}
+			
+			// Point-wise mapping of the values of its single buffered source, appended to
+			// program as epilogue operations, so that Plan runs a chain of such modules in one
+			// pass. False, leaving program unchanged, if the module has no such form.
+			virtual
+			bool
+			AppendEpilogue( epilogue::Program< ValueType >& /*program*/ ) const
+			{
+				return false;
+			}
 			
 		};
 		
@@ -202,6 +363,54 @@ namespace noise2
 					output[ i ] = GetValue( inputX[ i ], inputY[ i ], inputZ[ i ], inputW[ i ] );
 				}
 			}
+
+			// Values of count points, the arrays have to be aligned as for GetValue4
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				size_t	i = 0;
+
+				for( ; i + 4 <= count; i += 4 )
+				{
+					GetValue4( inputX + i, inputY + i, inputZ + i, inputW + i, output + i );
+				}
+
+				for( ; i < count; ++i )
+				{
+					output[ i ] = GetValue( inputX[ i ], inputY[ i ], inputZ[ i ], inputW[ i ] );
+				}
+			}
+
+			// Block evaluation by Plan. A module which only combines the values of some of its
+			// sources at each point gets them computed in advance, sourceValues[ i ] holds those
+			// of source i or is null where IsSourceBuffered( i ) is false. A module buffering none
+			// of its sources is evaluated by its GetValueArray.
+			virtual
+			bool
+			IsSourceBuffered( int /*index*/ ) const
+			{
+				return false;
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						  const ValueType* const* /*sourceValues*/, ValueType* output, size_t count ) const
+			{
+				GetValueArray( inputX, inputY, inputZ, inputW, output, count );
+			}
+			
+			// Point-wise mapping of the values of its single buffered source, appended to
+			// program as epilogue operations, so that Plan runs a chain of such modules in one
+			// pass. False, leaving program unchanged, if the module has no such form.
+			virtual
+			bool
+			AppendEpilogue( epilogue::Program< ValueType >& /*program*/ ) const
+			{
+				return false;
+			}
 			
 		};
 		
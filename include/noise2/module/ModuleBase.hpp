@@ -50,6 +50,7 @@ namespace noise2
 				return *( sourceModules[ index ] );
 		    }
 			
+			virtual
 			void 
 			SetSourceModule( int index, const ModuleType& sourceModule )
 			{
@@ -79,7 +80,7 @@ namespace noise2
 			//
 			private:
 			
-			std::vector< ModuleType* >		sourceModules;
+			std::vector< const ModuleType* >		sourceModules;
 			
 		};
 		
@@ -0,0 +1,449 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <map>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/ScratchArena.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// A module graph flattened into steps, sources before the modules which use them.
+		// Every step evaluates one module over a block of points into a scratch slot of
+		// BlockSize values. Modules get the values of their buffered sources (see
+		// Module::IsSourceBuffered) from those slots and combine them in CombineArray; other
+		// modules are evaluated by GetValueArray. A chain of modules with an epilogue form
+		// (see Module::AppendEpilogue), each used only by the next, is one step running their
+		// epilogue::Program in one pass over the values of the chain's source. A module
+		// reached along several paths is evaluated once per block and its slot is shared by
+		// all its users, see GetReport.
+		// Slots are reused once their values are consumed, and are taken from the
+		// ScratchArena of the evaluating thread, so after the first call evaluation allocates
+		// nothing. The graph must not change while planned.
+		template< typename ValueT, unsigned int Dim >
+		class Plan
+		{
+
+		public:
+
+			typedef ValueT								ValueType;
+			static const unsigned int					Dimension = Dim;
+			typedef Module< ValueType, Dimension >		ModuleType;
+
+			enum
+			{
+				BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+			};
+
+			// Module evaluations per block
+			struct Report
+			{
+				// Evaluations of the plan, one per distinct module
+				size_t		evaluations;
+				// Evaluations if every use of a module evaluated it again
+				size_t		treeEvaluations;
+				size_t		savedEvaluations;
+				// Modules used by more than one module
+				size_t		sharedModules;
+				// Modules run in the step of the module using them, see epilogue::Program
+				size_t		fusedModules;
+			};
+
+
+
+		private:
+
+			enum
+			{
+				// Slot of the root, its values go straight to the output
+				NoSlot = -1
+			};
+
+			struct Step
+			{
+				const ModuleType*		module;
+				int32					slot;
+				// Slot per source, NoSlot for those not buffered
+				std::vector< int32 >	sourceSlots;
+				bool					combines;
+				// Epilogues of a chain of modules ending in module, run over the values of
+				// the single source slot instead of module's CombineArray
+				epilogue::Program< ValueType >	program;
+			};
+
+			// Planning state of a module
+			struct Node
+			{
+				uint32		uses;
+				// Uses whose steps are not planned yet, the slot is freed when none are left
+				uint32		pendingUses;
+				size_t		treeEvaluations;
+				bool		planned;
+				int32		slot;
+			};
+
+			typedef std::map< const ModuleType*, Node >		NodeMap;
+
+			std::vector< Step >		steps;
+			uint32					slotCount;
+			size_t					sourceCount;
+			size_t					fusedCount;
+			Report					report;
+
+
+
+		public:
+
+			explicit
+			Plan( const ModuleType& root ):
+			  slotCount( 0 ),
+			  sourceCount( 0 ),
+			  fusedCount( 0 )
+			{
+				NodeMap					nodes;
+				std::vector< int32 >	freeSlots;
+
+				countUses( root, nodes );
+				visit( root, true, nodes, freeSlots );
+
+				report.evaluations = steps.size() + fusedCount;
+				report.treeEvaluations = nodes[ &root ].treeEvaluations;
+				report.savedEvaluations = report.treeEvaluations - report.evaluations;
+				report.sharedModules = 0;
+				for( typename NodeMap::const_iterator n = nodes.begin(); n != nodes.end(); ++n )
+				{
+					if( n->second.uses > 1 )
+					{
+						++report.sharedModules;
+					}
+				}
+				report.fusedModules = fusedCount;
+			}
+
+			size_t
+			GetStepCount() const
+			{
+				return steps.size();
+			}
+
+			uint32
+			GetSlotCount() const
+			{
+				return slotCount;
+			}
+
+			const Report&
+			GetReport() const
+			{
+				return report;
+			}
+
+			// Scratch values one evaluation takes from the arena of its thread
+			size_t
+			GetScratchSize() const
+			{
+				return size_t( slotCount ) * BlockSize;
+			}
+
+			// Values of count points, the arrays have to be aligned as for GetValue4
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				evaluate( input, output, count );
+			}
+
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				evaluate( input, output, count );
+			}
+
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				evaluate( input, output, count );
+			}
+
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				evaluate( input, output, count );
+			}
+
+
+
+		private:
+
+			// Counts the uses of every module, returns the evaluations of its subtree if no
+			// module was shared
+			size_t
+			countUses( const ModuleType& module, NodeMap& nodes )
+			{
+				typename NodeMap::iterator	found = nodes.find( &module );
+				if( found != nodes.end() )
+				{
+					++found->second.uses;
+					++found->second.pendingUses;
+					return found->second.treeEvaluations;
+				}
+
+				size_t	treeEvaluations = 1;
+				for( int s = 0; s < module.GetSourceModuleCount(); ++s )
+				{
+					if( module.IsSourceBuffered( s ) )
+					{
+						treeEvaluations += countUses( module.GetSourceModule( s ), nodes );
+					}
+				}
+
+				Node&	node = nodes[ &module ];
+				node.uses = 1;
+				node.pendingUses = 1;
+				node.treeEvaluations = treeEvaluations;
+				node.planned = false;
+				node.slot = NoSlot;
+
+				return treeEvaluations;
+			}
+
+			// Appends the steps of module and its buffered sources unless already planned,
+			// returns the slot of its values
+			int32
+			visit( const ModuleType& module, bool isRoot, NodeMap& nodes, std::vector< int32 >& freeSlots )
+			{
+				Node&	node = nodes[ &module ];
+				if( node.planned )
+				{
+					return node.slot;
+				}
+
+				Step	step;
+				step.module = &module;
+				step.combines = false;
+
+				// The step evaluates module on the sources of the last module of its chain
+				std::vector< const ModuleType* >	chain( 1, &module );
+				while( hasEpilogue( *chain.back() ) )
+				{
+					const ModuleType&	source = chain.back()->GetSourceModule( 0 );
+					if( nodes[ &source ].uses != 1 || !hasEpilogue( source ) )
+					{
+						break;
+					}
+					chain.push_back( &source );
+				}
+
+				if( chain.size() > 1 )
+				{
+					for( size_t c = chain.size(); c-- > 0; )
+					{
+						chain[ c ]->AppendEpilogue( step.program );
+					}
+					fusedCount += chain.size() - 1;
+				}
+
+				const ModuleType&	last = *chain.back();
+				step.sourceSlots.resize( last.GetSourceModuleCount(), int32( NoSlot ) );
+
+				for( int s = 0; s < last.GetSourceModuleCount(); ++s )
+				{
+					if( last.IsSourceBuffered( s ) )
+					{
+						step.sourceSlots[ s ] = visit( last.GetSourceModule( s ), false, nodes, freeSlots );
+						step.combines = true;
+					}
+				}
+
+				// Taken before the source slots are released, so that no module writes over its inputs
+				step.slot = NoSlot;
+				if( !isRoot )
+				{
+					if( freeSlots.empty() )
+					{
+						step.slot = int32( slotCount++ );
+					}
+					else
+					{
+						step.slot = freeSlots.back();
+						freeSlots.pop_back();
+					}
+				}
+
+				for( int s = 0; s < last.GetSourceModuleCount(); ++s )
+				{
+					if( step.sourceSlots[ s ] != NoSlot )
+					{
+						Node&	source = nodes[ &last.GetSourceModule( s ) ];
+						if( --source.pendingUses == 0 )
+						{
+							freeSlots.push_back( source.slot );
+						}
+					}
+				}
+
+				if( step.combines )
+				{
+					sourceCount += step.sourceSlots.size();
+				}
+
+				node.planned = true;
+				node.slot = step.slot;
+				steps.push_back( step );
+
+				return step.slot;
+			}
+
+			// Whether module maps the values of its single buffered source by an epilogue
+			static
+			bool
+			hasEpilogue( const ModuleType& module )
+			{
+				epilogue::Program< ValueType >	program;
+
+				return module.GetSourceModuleCount() == 1 && module.IsSourceBuffered( 0 ) && module.AppendEpilogue( program );
+			}
+
+			void
+			evaluate( const ValueType* const* input, ValueType* output, size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope			valueScope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				typename memory::ScratchArena< const ValueType* >::Scope	sourceScope( memory::ScratchArena< const ValueType* >::forCurrentThread() );
+				ValueType*			scratch = valueScope.allocate( GetScratchSize() );
+				const ValueType**	sourceValues = sourceScope.allocate( sourceCount );
+
+				// Slots stay at the same place for all blocks, so the source tables are built once
+				const ValueType**	stepSources = sourceValues;
+				for( size_t s = 0; s < steps.size(); ++s )
+				{
+					const Step&		step = steps[ s ];
+
+					if( step.combines )
+					{
+						for( size_t k = 0; k < step.sourceSlots.size(); ++k )
+						{
+							stepSources[ k ] = step.sourceSlots[ k ] == NoSlot ? 0 : scratch + (size_t( step.sourceSlots[ k ] ) * BlockSize);
+						}
+						stepSources += step.sourceSlots.size();
+					}
+				}
+
+				for( size_t start = 0; start < count; start += BlockSize )
+				{
+					size_t				blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+					const ValueType*	blockInput[ Dimension ];
+
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						blockInput[ d ] = input[ d ] + start;
+					}
+
+					stepSources = sourceValues;
+					for( size_t s = 0; s < steps.size(); ++s )
+					{
+						const Step&		step = steps[ s ];
+						ValueType*		values = step.slot == NoSlot ? output + start : scratch + (size_t( step.slot ) * BlockSize);
+
+						if( step.program.GetOperationCount() != 0 )
+						{
+							epilogue::applyBlock( step.program, stepSources[ 0 ], values, blockCount );
+							stepSources += step.sourceSlots.size();
+						}
+						else if( step.combines )
+						{
+							combineArray( *step.module, blockInput, stepSources, values, blockCount );
+							stepSources += step.sourceSlots.size();
+						}
+						else
+						{
+							getValueArray( *step.module, blockInput, values, blockCount );
+						}
+					}
+				}
+			}
+
+			static inline
+			void
+			getValueArray( const Module< ValueType, 1 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], output, count );
+			}
+
+			static inline
+			void
+			getValueArray( const Module< ValueType, 2 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], output, count );
+			}
+
+			static inline
+			void
+			getValueArray( const Module< ValueType, 3 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], input[ 2 ], output, count );
+			}
+
+			static inline
+			void
+			getValueArray( const Module< ValueType, 4 >& module, const ValueType* const* input, ValueType* output, size_t count )
+			{
+				module.GetValueArray( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], output, count );
+			}
+
+			static inline
+			void
+			combineArray( const Module< ValueType, 1 >& module, const ValueType* const* input, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count )
+			{
+				module.CombineArray( input[ 0 ], sourceValues, output, count );
+			}
+
+			static inline
+			void
+			combineArray( const Module< ValueType, 2 >& module, const ValueType* const* input, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count )
+			{
+				module.CombineArray( input[ 0 ], input[ 1 ], sourceValues, output, count );
+			}
+
+			static inline
+			void
+			combineArray( const Module< ValueType, 3 >& module, const ValueType* const* input, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count )
+			{
+				module.CombineArray( input[ 0 ], input[ 1 ], input[ 2 ], sourceValues, output, count );
+			}
+
+			static inline
+			void
+			combineArray( const Module< ValueType, 4 >& module, const ValueType* const* input, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count )
+			{
+				module.CombineArray( input[ 0 ], input[ 1 ], input[ 2 ], input[ 3 ], sourceValues, output, count );
+			}
+
+		};
+
+	}
+
+}
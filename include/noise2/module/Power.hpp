@@ -0,0 +1,61 @@
+#pragma once
+
+
+// Std C++
+#include <cmath>
+
+
+// libnoise
+#include "noise2/math/ArrayMath.hpp"
+#include "noise2/module/Combiner.hpp"
+
+
+
+
+namespace noise2
+{
+	
+	namespace module
+	{
+
+		namespace combiner
+		{
+
+			template< typename ValueType >
+			struct PowerOperator
+			{
+
+				enum
+				{
+					SourceCount = 2
+				};
+
+				static inline
+				ValueType
+				apply( const ValueType* values )
+				{
+					return std::pow( values[ 0 ], values[ 1 ] );
+				}
+
+				template< uint32 Width >
+				static inline
+				void
+				applyArray( const ValueType* const* sourceValues, ValueType* output, size_t count )
+				{
+					math::ArrayMath< ValueType, Width >::pow( sourceValues[ 0 ], sourceValues[ 1 ], output, count );
+				}
+
+			};
+
+		}
+
+
+		// Value of source 0 raised to the value of source 1, as std::pow
+		template< typename ValueType, unsigned int Dimension >
+		class Power: public Combiner< ValueType, Dimension, combiner::PowerOperator< ValueType > >
+		{
+		};
+		
+	}
+	
+}
@@ -23,6 +23,7 @@
 // libnoise
 #include <noise2/Platform.hpp>
 #include <noise2/BasicTypes.hpp>
+#include <noise2/module/SliceKernel.hpp>
 
 
 
@@ -59,6 +60,35 @@ namespace noise2
 		class RidgedMulti: public perlin::RidgedMultiImpl< ValueType, Dimension, 4 >
 		{
 		};
+
+
+		namespace dimensionadapter
+		{
+
+			// The plane z = 0 has a kernel of its own, which leaves out the z half of the
+			// noise cube
+			template< typename ValueType >
+			struct SliceKernel< RidgedMulti< ValueType, 3 > >
+			{
+
+				static inline
+				void
+				getValue4( const RidgedMulti< ValueType, 3 >& adaptee, const ValueType* inputX, const ValueType* inputY, ValueType* output )
+				{
+					adaptee.template GetSliceValueV< 4 >( inputX, inputY, output );
+				}
+
+				static inline
+				void
+				getValueArray( const RidgedMulti< ValueType, 3 >& adaptee, const ValueType* inputX, const ValueType* inputY,
+							   ValueType* output, size_t count )
+				{
+					adaptee.GetSliceValueArray( inputX, inputY, output, count );
+				}
+
+			};
+
+		}
 	}
 }
 #else
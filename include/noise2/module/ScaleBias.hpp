@@ -0,0 +1,53 @@
+#pragma once
+
+
+// libnoise
+#include <noise2/module/Epilogue.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Source value multiplied by the scale and offset by the bias, as in libnoise
+		template< typename ValueT, unsigned int Dimension >
+		class ScaleBias: public epilogue::EpilogueModifier< ValueT, Dimension, epilogue::ScaleBias< ValueT > >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			ValueType
+			GetScale() const
+			{
+				return this->epilogue.scale;
+			}
+
+			ValueType
+			GetBias() const
+			{
+				return this->epilogue.bias;
+			}
+
+			void
+			SetScale( ValueType scale )
+			{
+				this->epilogue.scale = scale;
+			}
+
+			void
+			SetBias( ValueType bias )
+			{
+				this->epilogue.bias = bias;
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,616 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/math/Interpolations.hpp>
+#include <noise2/memory/ScratchArena.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Dispatch.hpp>
+#include <noise2/module/Plan.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace select
+		{
+
+			// Select of libnoise: source 1 where the control module (source 2) lies within the
+			// bounds, source 0 elsewhere, blended across an edge of 2 * edgeFalloff around
+			// each bound. Sources 0 and 1 are evaluated lazily: a block of points gets its
+			// control values first, then each source is evaluated only on the points whose
+			// weight needs it, gathered into a compact block. Under Plan only the control
+			// is buffered.
+			template< typename ValueT, unsigned int Dim >
+			class SelectBase: public Module< ValueT, Dim >
+			{
+
+				//
+				// Type aliases
+				//
+				public:
+
+				typedef ValueT								ValueType;
+				static const unsigned int					Dimension = Dim;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+				enum
+				{
+					ControlIndex = 2,
+					BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+				};
+
+
+
+				//
+				// Public interface
+				//
+				public:
+
+				SelectBase():
+				  ModuleType( 3 ),
+				  lowerBound( ValueType( -1.0 ) ),
+				  upperBound( ValueType( 1.0 ) ),
+				  edgeFalloff( ValueType( 0.0 ) )
+				{
+				}
+
+				virtual
+				~SelectBase()
+				{
+				}
+
+				const ModuleType&
+				GetControlModule() const
+				{
+					return this->GetSourceModule( ControlIndex );
+				}
+
+				void
+				SetControlModule( const ModuleType& controlModule )
+				{
+					this->SetSourceModule( ControlIndex, controlModule );
+				}
+
+				ValueType
+				GetLowerBound() const
+				{
+					return lowerBound;
+				}
+
+				ValueType
+				GetUpperBound() const
+				{
+					return upperBound;
+				}
+
+				ValueType
+				GetEdgeFalloff() const
+				{
+					return edgeFalloff;
+				}
+
+				// lowerBound has to be lower than upperBound
+				void
+				SetBounds( ValueType lowerBound, ValueType upperBound )
+				{
+					this->lowerBound = lowerBound;
+					this->upperBound = upperBound;
+
+					SetEdgeFalloff( edgeFalloff );
+				}
+
+				// Clamped to half of the selection range, so that the two edges do not overlap
+				void
+				SetEdgeFalloff( ValueType edgeFalloff )
+				{
+					ValueType	boundSize = upperBound - lowerBound;
+
+					this->edgeFalloff = edgeFalloff > boundSize / ValueType( 2.0 ) ? boundSize / ValueType( 2.0 ) : edgeFalloff;
+				}
+
+				virtual
+				bool
+				IsSourceBuffered( int index ) const
+				{
+					return index == ControlIndex;
+				}
+
+
+
+				//
+				// Protected interface
+				//
+				protected:
+
+				ValueType
+				selectValue( const ValueType* point ) const
+				{
+					ValueType	weight = getWeight( dispatch::getValue( GetControlModule(), point ) );
+
+					if( weight == ValueType( 0.0 ) )
+					{
+						return dispatch::getValue( this->GetSourceModule( 0 ), point );
+					}
+					if( weight == ValueType( 1.0 ) )
+					{
+						return dispatch::getValue( this->GetSourceModule( 1 ), point );
+					}
+
+					return ((ValueType( 1.0 ) - weight) * dispatch::getValue( this->GetSourceModule( 0 ), point )) +
+						   (weight * dispatch::getValue( this->GetSourceModule( 1 ), point ));
+				}
+
+				void
+				select4( const ValueType* const* input, ValueType* output ) const
+				{
+					VECTOR4_ALIGN( ValueType	control[ 4 ] );
+					VECTOR4_ALIGN( ValueType	weights[ 4 ] );
+					VECTOR4_ALIGN( ValueType	values[ 4 ] );
+					bool						needs0 = false;
+					bool						needs1 = false;
+
+					dispatch::getValue4( GetControlModule(), input, control );
+					this->template getWeights< 4 >( control, weights, 4 );
+
+					for( int i = 0; i < 4; ++i )
+					{
+						needs0 = needs0 || usesSource0( weights[ i ] );
+						needs1 = needs1 || usesSource1( weights[ i ] );
+					}
+
+					if( needs0 )
+					{
+						dispatch::getValue4( this->GetSourceModule( 0 ), input, values );
+						for( int i = 0; i < 4; ++i )
+						{
+							if( usesSource0( weights[ i ] ) )
+							{
+								output[ i ] = (ValueType( 1.0 ) - weights[ i ]) * values[ i ];
+							}
+						}
+					}
+
+					if( needs1 )
+					{
+						dispatch::getValue4( this->GetSourceModule( 1 ), input, values );
+						for( int i = 0; i < 4; ++i )
+						{
+							if( usesSource1( weights[ i ] ) )
+							{
+								output[ i ] = weights[ i ] < ValueType( 1.0 ) ? output[ i ] + (weights[ i ] * values[ i ]) : values[ i ];
+							}
+						}
+					}
+				}
+
+				void
+				selectArray( const ValueType* const* input, ValueType* output, size_t count ) const
+				{
+					typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+					ValueType*											control = scope.allocate( BlockSize );
+					const ValueType*									blockInput[ Dimension ];
+
+					for( size_t start = 0; start < count; start += BlockSize )
+					{
+						size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+						for( unsigned int d = 0; d < Dimension; ++d )
+						{
+							blockInput[ d ] = input[ d ] + start;
+						}
+
+						dispatch::getValueArray( GetControlModule(), blockInput, control, blockCount );
+						selectBlock( blockInput, control, output + start, blockCount );
+					}
+				}
+
+				void
+				combineArray( const ValueType* const* input, const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+				{
+					const ValueType*	blockInput[ Dimension ];
+
+					for( size_t start = 0; start < count; start += BlockSize )
+					{
+						size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+						for( unsigned int d = 0; d < Dimension; ++d )
+						{
+							blockInput[ d ] = input[ d ] + start;
+						}
+
+						selectBlock( blockInput, sourceValues[ ControlIndex ] + start, output + start, blockCount );
+					}
+				}
+
+
+
+				//
+				// Private interface
+				//
+				private:
+
+				// Weight of source 1, 0 where only source 0 is selected and 1 where only source 1
+				ValueType
+				getWeight( ValueType control ) const
+				{
+					if( edgeFalloff > ValueType( 0.0 ) )
+					{
+						ValueType	lowerAlpha = clamp( (control - (lowerBound - edgeFalloff)) /
+														((lowerBound + edgeFalloff) - (lowerBound - edgeFalloff)) );
+						ValueType	upperAlpha = clamp( (control - (upperBound - edgeFalloff)) /
+														((upperBound + edgeFalloff) - (upperBound - edgeFalloff)) );
+
+						return math::Interpolations< ValueType >::SCurve3( lowerAlpha ) *
+							   (ValueType( 1.0 ) - math::Interpolations< ValueType >::SCurve3( upperAlpha ));
+					}
+
+					return control < lowerBound || control > upperBound ? ValueType( 0.0 ) : ValueType( 1.0 );
+				}
+
+				template< uint32 Width >
+				void
+				getWeights( const ValueType* control, ValueType* weights, size_t count ) const
+				{
+					size_t	i = 0;
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+					typedef math::Math< ValueType, Width >				M;
+					typedef math::Interpolations< ValueType, Width >	I;
+
+					if( edgeFalloff > ValueType( 0.0 ) )
+					{
+						typename M::VectorF	lowerStartV = M::vectorizeOne( lowerBound - edgeFalloff );
+						typename M::VectorF	lowerSizeV = M::vectorizeOne( (lowerBound + edgeFalloff) - (lowerBound - edgeFalloff) );
+						typename M::VectorF	upperStartV = M::vectorizeOne( upperBound - edgeFalloff );
+						typename M::VectorF	upperSizeV = M::vectorizeOne( (upperBound + edgeFalloff) - (upperBound - edgeFalloff) );
+
+						for( ; i + Width <= count; i += Width )
+						{
+							typename M::VectorF	controlV = M::loadFromMemory( control + i );
+							typename M::VectorF	lowerV = M::divide( M::subtract( controlV, lowerStartV ), lowerSizeV );
+							typename M::VectorF	upperV = M::divide( M::subtract( controlV, upperStartV ), upperSizeV );
+
+							lowerV = M::min( M::max( lowerV, M::constZeroF() ), M::constOneF() );
+							upperV = M::min( M::max( upperV, M::constZeroF() ), M::constOneF() );
+
+							M::storeToMemory( weights + i, M::multiply( I::SCurve3V( lowerV ),
+																		M::subtract( M::constOneF(), I::SCurve3V( upperV ) ) ) );
+						}
+					}
+					else
+					{
+						typename M::VectorF	lowerV = M::vectorizeOne( lowerBound );
+						typename M::VectorF	upperV = M::vectorizeOne( upperBound );
+
+						for( ; i + Width <= count; i += Width )
+						{
+							typename M::VectorF	controlV = M::loadFromMemory( control + i );
+							typename M::VectorI	outsideMask = M::castToInt( M::lowerThan( controlV, lowerV ) );
+
+							outsideMask = M::bitOr( outsideMask, M::castToInt( M::greaterThan( controlV, upperV ) ) );
+							M::storeToMemory( weights + i, M::blend( M::constOneF(), M::constZeroF(), outsideMask ) );
+						}
+					}
+#endif
+
+					for( ; i < count; ++i )
+					{
+						weights[ i ] = getWeight( control[ i ] );
+					}
+				}
+
+				// A count of at most BlockSize points
+				void
+				selectBlock( const ValueType* const* input, const ValueType* control, ValueType* output, size_t count ) const
+				{
+					typename memory::ScratchArena< ValueType >::Scope	valueScope( memory::ScratchArena< ValueType >::forCurrentThread() );
+					typename memory::ScratchArena< uint32 >::Scope		indexScope( memory::ScratchArena< uint32 >::forCurrentThread() );
+					ValueType*											weights = valueScope.allocate( BlockSize );
+					ValueType*											values = valueScope.allocate( BlockSize );
+					ValueType*											points = valueScope.allocate( Dimension * BlockSize );
+					uint32*												indices = indexScope.allocate( BlockSize );
+					size_t												indexCount = 0;
+
+					this->template getWeights< math::NativeWidth< ValueType >::Value >( control, weights, count );
+
+					for( size_t i = 0; i < count; ++i )
+					{
+						if( usesSource0( weights[ i ] ) )
+						{
+							indices[ indexCount++ ] = uint32( i );
+						}
+					}
+
+					getSubsetValues( this->GetSourceModule( 0 ), input, indices, indexCount, count, points, values );
+					for( size_t k = 0; k < indexCount; ++k )
+					{
+						uint32	i = indices[ k ];
+						output[ i ] = (ValueType( 1.0 ) - weights[ i ]) * values[ k ];
+					}
+
+					indexCount = 0;
+					for( size_t i = 0; i < count; ++i )
+					{
+						if( usesSource1( weights[ i ] ) )
+						{
+							indices[ indexCount++ ] = uint32( i );
+						}
+					}
+
+					getSubsetValues( this->GetSourceModule( 1 ), input, indices, indexCount, count, points, values );
+					for( size_t k = 0; k < indexCount; ++k )
+					{
+						uint32	i = indices[ k ];
+						output[ i ] = weights[ i ] < ValueType( 1.0 ) ? output[ i ] + (weights[ i ] * values[ k ]) : values[ k ];
+					}
+				}
+
+				// Values of source at the listed points of a block, gathered into points first
+				// unless the list covers the whole block
+				static inline
+				void
+				getSubsetValues( const ModuleType& source, const ValueType* const* input, const uint32* indices, size_t indexCount,
+								 size_t count, ValueType* points, ValueType* values )
+				{
+					if( indexCount == 0 )
+					{
+						return;
+					}
+
+					if( indexCount == count )
+					{
+						dispatch::getValueArray( source, input, values, count );
+						return;
+					}
+
+					const ValueType*	subsetInput[ Dimension ];
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						ValueType*	subset = points + (d * BlockSize);
+
+						for( size_t k = 0; k < indexCount; ++k )
+						{
+							subset[ k ] = input[ d ][ indices[ k ] ];
+						}
+						subsetInput[ d ] = subset;
+					}
+
+					dispatch::getValueArray( source, subsetInput, values, indexCount );
+				}
+
+				// A NaN weight goes through source 0, so that it reaches the output
+				static inline
+				bool
+				usesSource0( ValueType weight )
+				{
+					return !(weight >= ValueType( 1.0 ));
+				}
+
+				static inline
+				bool
+				usesSource1( ValueType weight )
+				{
+					return weight > ValueType( 0.0 );
+				}
+
+				static inline
+				ValueType
+				clamp( ValueType alpha )
+				{
+					return alpha < ValueType( 0.0 ) ? ValueType( 0.0 ) : (alpha > ValueType( 1.0 ) ? ValueType( 1.0 ) : alpha);
+				}
+
+
+
+				//
+				// Fields
+				//
+				private:
+
+				ValueType	lowerBound;
+				ValueType	upperBound;
+				ValueType	edgeFalloff;
+
+			};
+
+		}
+
+
+		template< typename ValueType, unsigned int Dimension >
+		class Select;
+
+
+		template< typename ValueT >
+		class Select< ValueT, 1 >: public select::SelectBase< ValueT, 1 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x ) const
+			{
+				ValueType	point[ 1 ] = { x };
+				return this->selectValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, ValueType* output ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->select4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->selectArray( input, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->combineArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Select< ValueT, 2 >: public select::SelectBase< ValueT, 2 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y ) const
+			{
+				ValueType	point[ 2 ] = { x, y };
+				return this->selectValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->select4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->selectArray( input, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->combineArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Select< ValueT, 3 >: public select::SelectBase< ValueT, 3 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z ) const
+			{
+				ValueType	point[ 3 ] = { x, y, z };
+				return this->selectValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->select4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->selectArray( input, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->combineArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Select< ValueT, 4 >: public select::SelectBase< ValueT, 4 >
+		{
+
+			public:
+
+			typedef ValueT		ValueType;
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+			{
+				ValueType	point[ 4 ] = { x, y, z, w };
+				return this->selectValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+					   ValueType* output ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->select4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->selectArray( input, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->combineArray( input, sourceValues, output, count );
+			}
+
+		};
+
+	}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/module/Plan.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace dimensionadapter
+		{
+
+			// Batch evaluation of a 3D module in the plane z = 0, used by DimensionAdapter.
+			// Modules without a kernel of their own for the plane get a block of zero z
+			// coordinates, modules with one specialize SliceKernel next to their definition.
+			template< typename AdaptedT >
+			struct SliceKernel
+			{
+
+				typedef typename AdaptedT::ValueType	ValueType;
+
+				enum
+				{
+					BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+				};
+
+				static inline
+				void
+				getValue4( const AdaptedT& adaptee, const ValueType* inputX, const ValueType* inputY, ValueType* output )
+				{
+					VECTOR4_ALIGN( ValueType	z[ 4 ] ) = { 0 };
+
+					adaptee.GetValue4( inputX, inputY, z, output );
+				}
+
+				static inline
+				void
+				getValueArray( const AdaptedT& adaptee, const ValueType* inputX, const ValueType* inputY, ValueType* output,
+							   size_t count )
+				{
+					VECTOR4_ALIGN( ValueType	z[ BlockSize ] ) = { 0 };
+
+					for( size_t start = 0; start < count; start += BlockSize )
+					{
+						size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+						adaptee.GetValueArray( inputX + start, inputY + start, z, output + start, blockCount );
+					}
+				}
+
+			};
+
+		}
+
+	}
+
+}
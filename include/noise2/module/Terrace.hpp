@@ -0,0 +1,280 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+#include <vector>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/math/Interpolations.hpp>
+#include <noise2/math/SegmentTable.hpp>
+#include <noise2/module/Modifier.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Terrace of libnoise: between two neighbouring control points the source value is
+		// eased onto the lower one by the square of its position, or onto the upper one
+		// when the terraces are inverted. Outside the control points the value is flat.
+		// Setting the control points compiles one segment per gap into a SegmentTable,
+		// with the inversion folded into the origin and scale of each segment. Arrays look
+		// up the segments of a chunk first, then interpolate on vectors.
+		template< typename ValueT, unsigned int Dimension >
+		class Terrace: public Modifier< ValueT, Dimension >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			typedef math::SegmentTable< ValueType, 2 >	Table;
+
+			enum
+			{
+				ChunkSize = 64
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Terrace():
+			  invertTerraces( false )
+			{
+			}
+
+			virtual
+			~Terrace()
+			{
+			}
+
+			// Control points have to be distinct, returns false and adds nothing if the value
+			// is already a control point
+			bool
+			AddControlPoint( ValueType value )
+			{
+				size_t	index = findInsertionPos( value );
+
+				if( index < controlPoints.size() && controlPoints[ index ] == value )
+				{
+					return false;
+				}
+
+				controlPoints.insert( controlPoints.begin() + index, value );
+				compile();
+
+				return true;
+			}
+
+			// Replaces all control points, the table is compiled once. Returns false and keeps
+			// the current points if two values are equal.
+			bool
+			SetControlPoints( const ValueType* values, size_t count )
+			{
+				std::vector< ValueType >	previous;
+
+				previous.swap( controlPoints );
+				for( size_t i = 0; i < count; ++i )
+				{
+					size_t	index = findInsertionPos( values[ i ] );
+
+					if( index < controlPoints.size() && controlPoints[ index ] == values[ i ] )
+					{
+						controlPoints.swap( previous );
+						return false;
+					}
+
+					controlPoints.insert( controlPoints.begin() + index, values[ i ] );
+				}
+				compile();
+
+				return true;
+			}
+
+			void
+			ClearAllControlPoints()
+			{
+				controlPoints.clear();
+				compile();
+			}
+
+			// Replaces the control points by terraceCount ones spread evenly over -1 to 1
+			void
+			MakeControlPoints( int terraceCount )
+			{
+				controlPoints.clear();
+				if( terraceCount >= 2 )
+				{
+					ValueType	terraceStep = ValueType( 2.0 ) / ValueType( terraceCount - 1 );
+
+					for( int i = 0; i < terraceCount; ++i )
+					{
+						controlPoints.push_back( ValueType( -1.0 ) + (ValueType( i ) * terraceStep) );
+					}
+				}
+				compile();
+			}
+
+			const ValueType*
+			GetControlPointArray() const
+			{
+				return controlPoints.empty() ? 0 : &controlPoints[ 0 ];
+			}
+
+			int
+			GetControlPointCount() const
+			{
+				return int( controlPoints.size() );
+			}
+
+			void
+			InvertTerraces( bool invert = true )
+			{
+				invertTerraces = invert;
+				compile();
+			}
+
+			bool
+			IsTerracesInverted() const
+			{
+				return invertTerraces;
+			}
+
+			virtual
+			ValueType
+			ModifyValue( ValueType value ) const
+			{
+				size_t		segment = table.Locate( value );
+				ValueType	alpha = table.GetCoordinate( segment, value );
+
+				return math::Interpolations< ValueType >::LinearInterp( table.GetValue( segment, 0 ), table.GetValue( segment, 1 ),
+																		alpha * alpha );
+			}
+
+			virtual
+			void
+			ModifyArray( const ValueType* values, ValueType* output, size_t count ) const
+			{
+				VECTOR4_ALIGN( ValueType	alpha[ ChunkSize ] );
+				VECTOR4_ALIGN( ValueType	n[ 2 ][ ChunkSize ] );
+				ValueType*					segmentValues[ 2 ] = { n[ 0 ], n[ 1 ] };
+
+				for( size_t start = 0; start < count; start += ChunkSize )
+				{
+					size_t	chunkCount = count - start < size_t( ChunkSize ) ? count - start : size_t( ChunkSize );
+					size_t	i = 0;
+
+					table.Gather( values + start, alpha, segmentValues, chunkCount );
+
+#if defined( LIBNOISE2_AT_LEAST_SSE2 )
+					typedef math::Math< ValueType, math::NativeWidth< ValueType >::Value >				M;
+					typedef math::Interpolations< ValueType, math::NativeWidth< ValueType >::Value >	Interp;
+
+					for( ; i + M::LaneCount <= chunkCount; i += M::LaneCount )
+					{
+						typename M::VectorF	n0V = M::loadFromMemory( n[ 0 ] + i );
+						typename M::VectorF	n1V = M::loadFromMemory( n[ 1 ] + i );
+						typename M::VectorF	alphaV = M::loadFromMemory( alpha + i );
+
+						alphaV = M::multiply( alphaV, alphaV );
+						M::storeToMemory( output + start + i, Interp::LinearInterpV( n0V, n1V, alphaV ) );
+					}
+#endif
+
+					for( ; i < chunkCount; ++i )
+					{
+						output[ start + i ] = math::Interpolations< ValueType >::LinearInterp( n[ 0 ][ i ], n[ 1 ][ i ], alpha[ i ] * alpha[ i ] );
+					}
+				}
+			}
+
+
+
+			//
+			// Private interface
+			//
+			private:
+
+			size_t
+			findInsertionPos( ValueType value ) const
+			{
+				size_t	index = 0;
+
+				while( index < controlPoints.size() && controlPoints[ index ] < value )
+				{
+					++index;
+				}
+
+				return index;
+			}
+
+			// Segment s lies between control points s - 1 and s. Inverted terraces run from
+			// the upper point back to the lower one, which is libnoise's 1 - alpha with the
+			// two values swapped.
+			void
+			compile()
+			{
+				size_t	count = controlPoints.size();
+
+				table.Build( count > 0 ? &controlPoints[ 0 ] : 0, count );
+				if( count == 0 )
+				{
+					return;
+				}
+
+				for( size_t segment = 0; segment <= count; ++segment )
+				{
+					size_t		index0 = segment == 0 ? 0 : segment - 1;
+					size_t		index1 = segment == count ? count - 1 : segment;
+					ValueType	value0 = controlPoints[ index0 ];
+					ValueType	value1 = controlPoints[ index1 ];
+
+					if( index0 == index1 )
+					{
+						ValueType	n[ 2 ] = { value0, value0 };
+						table.SetSegment( segment, ValueType( 0.0 ), ValueType( 0.0 ), n );
+					}
+					else if( invertTerraces )
+					{
+						ValueType	n[ 2 ] = { value1, value0 };
+						table.SetSegment( segment, value1, ValueType( 1.0 ) / (value0 - value1), n );
+					}
+					else
+					{
+						ValueType	n[ 2 ] = { value0, value1 };
+						table.SetSegment( segment, value0, ValueType( 1.0 ) / (value1 - value0), n );
+					}
+				}
+			}
+
+
+
+			//
+			// Fields
+			//
+			private:
+
+			std::vector< ValueType >	controlPoints;
+			bool						invertTerraces;
+			Table						table;
+
+		};
+
+	}
+
+}
@@ -0,0 +1,367 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/ScratchArena.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/Dispatch.hpp>
+#include <noise2/module/Plan.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace transformer
+		{
+
+			// Module which evaluates source 0 at transformed coordinates. Subclasses supply
+			// TransformPoint for one point and TransformArray for a block of points; arrays
+			// are transformed a block at a time into scratch coordinates, which then go to
+			// the source in one GetValueArray call.
+			template< typename ValueT, unsigned int Dim >
+			class TransformerBase: public Module< ValueT, Dim >
+			{
+
+				//
+				// Type aliases
+				//
+				public:
+
+				typedef ValueT								ValueType;
+				static const unsigned int					Dimension = Dim;
+				typedef Module< ValueType, Dimension >		ModuleType;
+
+				enum
+				{
+					BlockSize = LIBNOISE2_PLAN_BLOCK_SIZE
+				};
+
+
+
+				//
+				// Public interface
+				//
+				public:
+
+				explicit
+				TransformerBase( int sourceModuleCount ):
+				  ModuleType( sourceModuleCount )
+				{
+				}
+
+				virtual
+				~TransformerBase()
+				{
+				}
+
+				// Coordinates source 0 is evaluated at for point
+				virtual
+				void
+				TransformPoint( const ValueType* point, ValueType* transformed ) const = 0;
+
+				// Coordinates of count points, at most BlockSize. sourceValues are the values of
+				// the buffered sources under Plan (see Module::IsSourceBuffered) and null
+				// otherwise, the arrays are aligned as for GetValue4.
+				virtual
+				void
+				TransformArray( const ValueType* const* input, const ValueType* const* sourceValues, ValueType* const* transformed,
+								size_t count ) const = 0;
+
+
+
+				//
+				// Protected interface
+				//
+				protected:
+
+				ValueType
+				transformValue( const ValueType* point ) const
+				{
+					ValueType	transformed[ Dimension ];
+
+					TransformPoint( point, transformed );
+					return dispatch::getValue( this->GetSourceModule( 0 ), transformed );
+				}
+
+				void
+				transform4( const ValueType* const* input, ValueType* output ) const
+				{
+					VECTOR4_ALIGN( ValueType	points[ Dimension * 4 ] );
+					ValueType*					transformed[ Dimension ];
+
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						transformed[ d ] = points + (d * 4);
+					}
+
+					TransformArray( input, 0, transformed, 4 );
+					dispatch::getValue4( this->GetSourceModule( 0 ), transformed, output );
+				}
+
+				void
+				transformArray( const ValueType* const* input, const ValueType* const* sourceValues, ValueType* output,
+								size_t count ) const
+				{
+					typename memory::ScratchArena< ValueType >::Scope			valueScope( memory::ScratchArena< ValueType >::forCurrentThread() );
+					typename memory::ScratchArena< const ValueType* >::Scope	sourceScope( memory::ScratchArena< const ValueType* >::forCurrentThread() );
+					ValueType*				points = valueScope.allocate( Dimension * BlockSize );
+					const ValueType**		blockSources = sourceValues == 0 ? 0 : sourceScope.allocate( this->GetSourceModuleCount() );
+					ValueType*				transformed[ Dimension ];
+					const ValueType*		blockInput[ Dimension ];
+
+					for( unsigned int d = 0; d < Dimension; ++d )
+					{
+						transformed[ d ] = points + (d * BlockSize);
+					}
+
+					for( size_t start = 0; start < count; start += BlockSize )
+					{
+						size_t	blockCount = count - start < size_t( BlockSize ) ? count - start : size_t( BlockSize );
+
+						for( unsigned int d = 0; d < Dimension; ++d )
+						{
+							blockInput[ d ] = input[ d ] + start;
+						}
+
+						if( blockSources != 0 )
+						{
+							for( int s = 0; s < this->GetSourceModuleCount(); ++s )
+							{
+								blockSources[ s ] = sourceValues[ s ] == 0 ? 0 : sourceValues[ s ] + start;
+							}
+						}
+
+						TransformArray( blockInput, blockSources, transformed, blockCount );
+						dispatch::getValueArray( this->GetSourceModule( 0 ), transformed, output + start, blockCount );
+					}
+				}
+
+			};
+
+		}
+
+
+		template< typename ValueT, unsigned int Dimension >
+		class Transformer;
+
+
+		template< typename ValueT >
+		class Transformer< ValueT, 1 >: public transformer::TransformerBase< ValueT, 1 >
+		{
+
+			public:
+
+			typedef ValueT										ValueType;
+			typedef transformer::TransformerBase< ValueT, 1 >	BaseType;
+
+			explicit
+			Transformer( int sourceModuleCount ):
+			  BaseType( sourceModuleCount )
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x ) const
+			{
+				ValueType	point[ 1 ] = { x };
+				return this->transformValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, ValueType* output ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->transform4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->transformArray( input, 0, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 1 ] = { inputX };
+				this->transformArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Transformer< ValueT, 2 >: public transformer::TransformerBase< ValueT, 2 >
+		{
+
+			public:
+
+			typedef ValueT										ValueType;
+			typedef transformer::TransformerBase< ValueT, 2 >	BaseType;
+
+			explicit
+			Transformer( int sourceModuleCount ):
+			  BaseType( sourceModuleCount )
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y ) const
+			{
+				ValueType	point[ 2 ] = { x, y };
+				return this->transformValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->transform4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->transformArray( input, 0, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* const* sourceValues,
+						  ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 2 ] = { inputX, inputY };
+				this->transformArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Transformer< ValueT, 3 >: public transformer::TransformerBase< ValueT, 3 >
+		{
+
+			public:
+
+			typedef ValueT										ValueType;
+			typedef transformer::TransformerBase< ValueT, 3 >	BaseType;
+
+			explicit
+			Transformer( int sourceModuleCount ):
+			  BaseType( sourceModuleCount )
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z ) const
+			{
+				ValueType	point[ 3 ] = { x, y, z };
+				return this->transformValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->transform4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+						   size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->transformArray( input, 0, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 3 ] = { inputX, inputY, inputZ };
+				this->transformArray( input, sourceValues, output, count );
+			}
+
+		};
+
+
+		template< typename ValueT >
+		class Transformer< ValueT, 4 >: public transformer::TransformerBase< ValueT, 4 >
+		{
+
+			public:
+
+			typedef ValueT										ValueType;
+			typedef transformer::TransformerBase< ValueT, 4 >	BaseType;
+
+			explicit
+			Transformer( int sourceModuleCount ):
+			  BaseType( sourceModuleCount )
+			{
+			}
+
+			virtual
+			ValueType
+			GetValue( ValueType x, ValueType y, ValueType z, ValueType w ) const
+			{
+				ValueType	point[ 4 ] = { x, y, z, w };
+				return this->transformValue( point );
+			}
+
+			virtual
+			void
+			GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+					   ValueType* output ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->transform4( input, output );
+			}
+
+			virtual
+			void
+			GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->transformArray( input, 0, output, count );
+			}
+
+			virtual
+			void
+			CombineArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						  const ValueType* const* sourceValues, ValueType* output, size_t count ) const
+			{
+				const ValueType*	input[ 4 ] = { inputX, inputY, inputZ, inputW };
+				this->transformArray( input, sourceValues, output, count );
+			}
+
+		};
+
+	}
+
+}
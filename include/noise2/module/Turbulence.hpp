@@ -0,0 +1,212 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/ScratchArena.hpp>
+#include <noise2/module/Dispatch.hpp>
+#include <noise2/module/Perlin.hpp>
+#include <noise2/module/Transformer.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		// Turbulence of libnoise: source 0 evaluated at the point moved along every axis by
+		// a Perlin noise of its own seed, sampled at offset coordinates and scaled by the
+		// power. A block of points gets all its displacements from the Perlin modules'
+		// GetValueArray.
+		template< typename ValueT, unsigned int Dimension >
+		class Turbulence: public Transformer< ValueT, Dimension >
+		{
+
+			//
+			// Type aliases
+			//
+			public:
+
+			typedef ValueT								ValueType;
+			typedef Transformer< ValueType, Dimension >	TransformerType;
+			typedef Perlin< ValueType, Dimension >		DistortModule;
+
+			enum
+			{
+				BlockSize = TransformerType::BlockSize
+			};
+
+
+
+			//
+			// Public interface
+			//
+			public:
+
+			Turbulence():
+			  TransformerType( 1 ),
+			  power( ValueType( 1.0 ) )
+			{
+				SetFrequency( ValueType( 1.0 ) );
+				SetSeed( 0 );
+				SetRoughness( 3 );
+			}
+
+			virtual
+			~Turbulence()
+			{
+			}
+
+			// Frequency of the Perlin modules
+			ValueType
+			GetFrequency() const
+			{
+				return distortModules[ 0 ].GetFrequency();
+			}
+
+			void
+			SetFrequency( ValueType frequency )
+			{
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					distortModules[ d ].SetFrequency( frequency );
+				}
+			}
+
+			ValueType
+			GetPower() const
+			{
+				return power;
+			}
+
+			void
+			SetPower( ValueType power )
+			{
+				this->power = power;
+			}
+
+			// Octave count of the Perlin modules
+			uint32
+			GetRoughnessCount() const
+			{
+				return distortModules[ 0 ].GetOctaveCount();
+			}
+
+			void
+			SetRoughness( uint32 roughness )
+			{
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					distortModules[ d ].SetOctaveCount( roughness );
+				}
+			}
+
+			// The Perlin module of axis d uses seed + d
+			uint32
+			GetSeed() const
+			{
+				return distortModules[ 0 ].GetSeed();
+			}
+
+			void
+			SetSeed( uint32 seed )
+			{
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					distortModules[ d ].SetSeed( seed + d );
+				}
+			}
+
+			virtual
+			void
+			TransformPoint( const ValueType* point, ValueType* transformed ) const
+			{
+				ValueType	distortPoint[ Dimension ];
+
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					for( unsigned int a = 0; a < Dimension; ++a )
+					{
+						distortPoint[ a ] = point[ a ] + offset( d, a );
+					}
+
+					transformed[ d ] = point[ d ] + (dispatch::getValue( distortModules[ d ], distortPoint ) * power);
+				}
+			}
+
+			virtual
+			void
+			TransformArray( const ValueType* const* input, const ValueType* const* /*sourceValues*/, ValueType* const* transformed,
+							size_t count ) const
+			{
+				typename memory::ScratchArena< ValueType >::Scope	scope( memory::ScratchArena< ValueType >::forCurrentThread() );
+				ValueType*											points = scope.allocate( Dimension * BlockSize );
+				ValueType*											values = scope.allocate( BlockSize );
+				const ValueType*									distortInput[ Dimension ];
+
+				for( unsigned int d = 0; d < Dimension; ++d )
+				{
+					for( unsigned int a = 0; a < Dimension; ++a )
+					{
+						ValueType*	distortCoordinates = points + (a * BlockSize);
+						ValueType	axisOffset = offset( d, a );
+
+						for( size_t i = 0; i < count; ++i )
+						{
+							distortCoordinates[ i ] = input[ a ][ i ] + axisOffset;
+						}
+						distortInput[ a ] = distortCoordinates;
+					}
+
+					dispatch::getValueArray( distortModules[ d ], distortInput, values, count );
+
+					for( size_t i = 0; i < count; ++i )
+					{
+						transformed[ d ][ i ] = input[ d ][ i ] + (values[ i ] * power);
+					}
+				}
+			}
+
+
+
+			//
+			// Private interface
+			//
+			private:
+
+			// Offset of axis in the coordinates of the Perlin module of axis d, the x, y and z
+			// ones are those of libnoise
+			static inline
+			ValueType
+			offset( unsigned int d, unsigned int axis )
+			{
+				static const int32	offsets[ 4 ][ 4 ] = { { 12414, 65124, 31337, 23193 },
+														  { 26519, 18128, 60493, 8479 },
+														  { 53820, 11213, 44845, 39751 },
+														  { 47202, 35917, 5737, 16421 } };
+
+				return ValueType( offsets[ d ][ axis ] ) / ValueType( 65536.0 );
+			}
+
+
+
+			//
+			// Fields
+			//
+			private:
+
+			DistortModule	distortModules[ Dimension ];
+			ValueType		power;
+
+		};
+
+	}
+
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+#include <noise2/module/Gabor.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			// One period of a periodic 2D Gabor noise stored as a square texture, sampled
+			// with bicubic interpolation. The texture keeps one wrapped texel before and two
+			// after every row and column, so the 4x4 footprint of a sample never wraps.
+			template< typename ValueT >
+			class BakedGaborBase
+			{
+
+			public:
+
+				typedef ValueT						ValueType;
+				typedef Gabor< ValueType, 2 >		GaborType;
+
+
+
+			protected:
+
+				memory::AlignedArray< ValueType >	texture;
+				uint32								resolution;
+				uint32								stride;
+				ValueType							periodLength;
+				ValueType							texelsPerUnit;
+
+
+
+			public:
+
+				BakedGaborBase():
+				  resolution( 0 ),
+				  stride( 0 ),
+				  periodLength( ValueType( 1.0 ) ),
+				  texelsPerUnit( ValueType( 0.0 ) )
+				{
+				}
+
+				// Evaluates one period of gabor into a newResolution x newResolution texture.
+				// When built with OpenMP the rows are split between all threads. Returns false
+				// and keeps the current texture unless gabor is periodic and all its widgets
+				// share one kernel radius, otherwise the texture would have seams at its edges.
+				bool
+				Bake( const GaborType& gabor, uint32 newResolution )
+				{
+					if( gabor.IsPeriodic() == false )
+					{
+						return false;
+					}
+
+					for( uint32 i = 1; i < gabor.GetWidgetCount(); ++i )
+					{
+						if( gabor.GetPeriodLength( i ) != gabor.GetPeriodLength( 0 ) )
+						{
+							return false;
+						}
+					}
+
+					resolution = newResolution > 0 ? newResolution : 1;
+					stride = resolution + 3;
+					periodLength = gabor.GetPeriodLength();
+					texelsPerUnit = ValueType( resolution ) / periodLength;
+
+					memory::AlignedArray< ValueType >	baked( size_t( resolution ) * resolution );
+					ValueType							step = periodLength / ValueType( resolution );
+
+#if defined( _OPENMP )
+					int32	stripRows = int32( resolution ) / (4 * omp_get_max_threads());
+#else
+					int32	stripRows = int32( resolution );
+#endif
+					if( stripRows == 0 )
+					{
+						stripRows = 1;
+					}
+
+					int32	stripCount = (int32( resolution ) + stripRows - 1) / stripRows;
+
+#if defined( _OPENMP )
+#pragma omp parallel for schedule( dynamic )
+#endif
+					for( int32 strip = 0; strip < stripCount; ++strip )
+					{
+						int32	row = strip * stripRows;
+						int32	rows = int32( resolution ) - row < stripRows ? int32( resolution ) - row : stripRows;
+
+						gabor.GetValueGrid( ValueType( 0.0 ), ValueType( row ) * step, step, step,
+											resolution, size_t( rows ), baked.data() + (size_t( row ) * resolution) );
+					}
+
+					texture.resize( size_t( stride ) * stride );
+
+					for( int32 j = -1; j < int32( resolution ) + 2; ++j )
+					{
+						for( int32 i = -1; i < int32( resolution ) + 2; ++i )
+						{
+							texture[ (size_t( j + 1 ) * stride) + size_t( i + 1 ) ] = baked[ (size_t( wrapTexel( j ) ) * resolution) + wrapTexel( i ) ];
+						}
+					}
+
+					return true;
+				}
+
+				inline
+				uint32
+				GetResolution() const
+				{
+					return resolution;
+				}
+
+				inline
+				ValueType
+				GetPeriodLength() const
+				{
+					return periodLength;
+				}
+
+
+
+			protected:
+
+				inline
+				uint32
+				wrapTexel( int32 i ) const
+				{
+					int32	wrapped = i % int32( resolution );
+
+					return uint32( wrapped < 0 ? wrapped + int32( resolution ) : wrapped );
+				}
+
+				// First texel of the 4x4 footprint whose second texel is ( i, j )
+				inline
+				const ValueType*
+				footprint( uint32 i, uint32 j ) const
+				{
+					return texture.data() + (size_t( j ) * stride) + i;
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise2
+#include <noise2/math/Interpolations.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/gabor/BakedGaborBase.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			template< typename ValueT >
+			class BakedGaborImpl< ValueT, 1 >: public Module< ValueT, 2 >, public gabor::BakedGaborBase< ValueT >
+			{
+
+			public:
+
+				typedef ValueT								ValueType;
+				static const uint32							Dimension = 2;
+				typedef Module< ValueType, Dimension >		ModuleType;
+				typedef gabor::BakedGaborBase< ValueType >	BaseType;
+				typedef BakedGaborImpl< ValueType, 1 >		ThisType;
+
+
+
+			private:
+				typedef math::Math< ValueType >				M;
+				typedef math::Interpolations< ValueType >	I;
+
+
+
+			public:
+
+				BakedGaborImpl():
+				  ModuleType( 0 ),
+				  BaseType()
+				{}
+
+				virtual
+				~BakedGaborImpl()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					ValueType	u = x * this->texelsPerUnit;
+					ValueType	v = y * this->texelsPerUnit;
+					ValueType	intU = M::floor( u );
+					ValueType	intV = M::floor( v );
+					ValueType	a = u - intU;
+					ValueType	b = v - intV;
+
+					const ValueType*	texel = this->footprint( this->wrapTexel( int32( intU ) ), this->wrapTexel( int32( intV ) ) );
+					ValueType			rows[ 4 ];
+
+					for( uint32 r = 0; r < 4; ++r )
+					{
+						rows[ r ] = I::CubicInterp( texel[ 0 ], texel[ 1 ], texel[ 2 ], texel[ 3 ], a );
+						texel += this->stride;
+					}
+
+					return I::CubicInterp( rows[ 0 ], rows[ 1 ], rows[ 2 ], rows[ 3 ], b );
+				}
+
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					for( size_t s = 0; s < count; ++s )
+					{
+						output[ s ] = GetValue( inputX[ s ], inputY[ s ] );
+					}
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -0,0 +1,188 @@
+#pragma once
+
+
+// Std C++
+#include <cstddef>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/math/Interpolations.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/module/Module.hpp>
+#include <noise2/module/gabor/BakedGaborBase.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			template< typename ValueT >
+			class BakedGaborImpl< ValueT, 4 >: public Module< ValueT, 2 >, public gabor::BakedGaborBase< ValueT >
+			{
+
+			public:
+
+				typedef ValueT								ValueType;
+				static const unsigned						Dimension = 2;
+				typedef Module< ValueType, Dimension >		ModuleType;
+				typedef gabor::BakedGaborBase< ValueType >	BaseType;
+				typedef BakedGaborImpl< ValueType, 4 >		ThisType;
+
+
+
+			private:
+				typedef math::Math< ValueType >				M;
+				typedef math::Interpolations< ValueType >	I;
+
+
+
+			public:
+
+				BakedGaborImpl():
+				  ModuleType( 0 ),
+				  BaseType()
+				{}
+
+				virtual
+				~BakedGaborImpl()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y ) const
+				{
+					ValueType	u = x * this->texelsPerUnit;
+					ValueType	v = y * this->texelsPerUnit;
+					ValueType	intU = M::floor( u );
+					ValueType	intV = M::floor( v );
+					ValueType	a = u - intU;
+					ValueType	b = v - intV;
+
+					const ValueType*	texel = this->footprint( this->wrapTexel( int32( intU ) ), this->wrapTexel( int32( intV ) ) );
+					ValueType			rows[ 4 ];
+
+					for( uint32 r = 0; r < 4; ++r )
+					{
+						rows[ r ] = I::CubicInterp( texel[ 0 ], texel[ 1 ], texel[ 2 ], texel[ 3 ], a );
+						texel += this->stride;
+					}
+
+					return I::CubicInterp( rows[ 0 ], rows[ 1 ], rows[ 2 ], rows[ 3 ], b );
+				}
+
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+				{
+					M::storeToMemory( output, valueVectorized( M::loadFromMemory( inputX ), M::loadFromMemory( inputY ) ) );
+				}
+
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					VECTOR4_ALIGN( ValueType	xA[ 4 ] );
+					VECTOR4_ALIGN( ValueType	yA[ 4 ] );
+					VECTOR4_ALIGN( ValueType	outputA[ 4 ] );
+
+					for( size_t s = 0; s < count; s += 4 )
+					{
+						size_t	lanes = count - s < 4 ? count - s : 4;
+
+						for( size_t l = 0; l < 4; ++l )
+						{
+							xA[ l ] = l < lanes ? inputX[ s + l ] : ValueType( 0.0 );
+							yA[ l ] = l < lanes ? inputY[ s + l ] : ValueType( 0.0 );
+						}
+
+						M::storeToMemory( outputA, valueVectorized( M::loadFromMemory( xA ), M::loadFromMemory( yA ) ) );
+
+						for( size_t l = 0; l < lanes; ++l )
+						{
+							output[ s + l ] = outputA[ l ];
+						}
+					}
+				}
+
+
+
+			private:
+
+				// Texel addressing and interpolation are vectorized, the 16 texels of every lane
+				// are gathered with scalar loads
+				inline
+				typename M::Vector4F
+				valueVectorized( const typename M::Vector4F& xV, const typename M::Vector4F& yV ) const
+				{
+					typename M::Vector4F		texelsPerUnitV = M::vectorizeOne( this->texelsPerUnit );
+					typename M::Vector4F		uV = M::multiply( xV, texelsPerUnitV );
+					typename M::Vector4F		vV = M::multiply( yV, texelsPerUnitV );
+					typename M::Vector4F		intUV = M::floor( uV );
+					typename M::Vector4F		intVV = M::floor( vV );
+					typename M::Vector4F		aV = M::subtract( uV, intUV );
+					typename M::Vector4F		bV = M::subtract( vV, intVV );
+
+					VECTOR4_ALIGN( int32		iA[ 4 ] );
+					VECTOR4_ALIGN( int32		jA[ 4 ] );
+					M::storeToMemory( iA, wrapTexelVectorized( intUV ) );
+					M::storeToMemory( jA, wrapTexelVectorized( intVV ) );
+
+					// texelA[ row * 4 + column ] holds the texels of all four lanes
+					VECTOR4_ALIGN( ValueType	texelA[ 16 * 4 ] );
+
+					for( uint32 l = 0; l < 4; ++l )
+					{
+						const ValueType*	texel = this->footprint( uint32( iA[ l ] ), uint32( jA[ l ] ) );
+
+						for( uint32 r = 0; r < 4; ++r )
+						{
+							texelA[ (((r * 4) + 0) * 4) + l ] = texel[ 0 ];
+							texelA[ (((r * 4) + 1) * 4) + l ] = texel[ 1 ];
+							texelA[ (((r * 4) + 2) * 4) + l ] = texel[ 2 ];
+							texelA[ (((r * 4) + 3) * 4) + l ] = texel[ 3 ];
+							texel += this->stride;
+						}
+					}
+
+					typename M::Vector4F		rowsV[ 4 ];
+
+					for( uint32 r = 0; r < 4; ++r )
+					{
+						rowsV[ r ] = I::CubicInterpV( M::loadFromMemory( texelA + (((r * 4) + 0) * 4) ),
+													  M::loadFromMemory( texelA + (((r * 4) + 1) * 4) ),
+													  M::loadFromMemory( texelA + (((r * 4) + 2) * 4) ),
+													  M::loadFromMemory( texelA + (((r * 4) + 3) * 4) ),
+													  aV );
+					}
+
+					return I::CubicInterpV( rowsV[ 0 ], rowsV[ 1 ], rowsV[ 2 ], rowsV[ 3 ], bV );
+				}
+
+				// Vectorized BakedGaborBase::wrapTexel of floored texel coordinates
+				inline
+				typename M::Vector4I
+				wrapTexelVectorized( typename M::Vector4F tV ) const
+				{
+					typename M::Vector4F		resolutionV = M::vectorizeOne( ValueType( this->resolution ) );
+
+					tV = M::subtract( tV, M::multiply( resolutionV, M::floor( M::multiply( tV, M::vectorizeOne( ValueType( 1.0 ) / ValueType( this->resolution ) ) ) ) ) );
+					tV = M::subtract( tV, M::select( resolutionV, M::castToInt( M::equalGreaterThan( tV, resolutionV ) ) ) );
+					tV = M::add( tV, M::select( resolutionV, M::castToInt( M::lowerThan( tV, M::constZeroF() ) ) ) );
+
+					return M::floatToIntTruncated( tV );
+				}
+
+			};
+
+		}
+
+	}
+
+}
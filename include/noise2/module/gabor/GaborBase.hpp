@@ -2,12 +2,18 @@
 
 
 // Std C++
+#include <climits>
+#include <cmath>
+#include <cstddef>
 #include <vector>
 
 
 // libnoise2
 #include <noise2/Platform.hpp>
 #include <noise2/math/Math.hpp>
+#include <noise2/module/gabor/ImpulseCache.hpp>
+#include <noise2/module/gabor/PoissonTable.hpp>
+#include <noise2/module/gabor/SpectralGrid.hpp>
 
 
 
@@ -168,7 +174,10 @@ namespace noise2
 
 
 
-			template< typename ValueT >
+			// Dimension selects the impulse density and variance of the kernel. The carrier of
+			// a 3D kernel leaves the XY plane by up to half the angular spread, so a spread of
+			// pi or more gives isotropic noise.
+			template< typename ValueT, uint8 Dim = 2 >
 			class GaborBase
 			{
 
@@ -176,6 +185,14 @@ namespace noise2
 
 				typedef ValueT							ValueType;
 				typedef GaborDefaults< ValueType >		Defaults;
+				static const uint8						Dimension = Dim;
+
+				enum
+				{
+					// Longest period whose cells all get distinct Morton codes, which keep 16 bits
+					// per axis in 2D and 10 bits per axis in 3D
+					MaxPeriod = Dim == 3 ? 1024 : 65536
+				};
 
 
 
@@ -229,16 +246,88 @@ namespace noise2
 					  frequencyRangeEnd( ValueType( 0.0 ) ),
 					  angularRangeStart( ValueType( 0.0 ) ),
 					  angularRangeEnd( ValueType( 0.0 ) ),
+					  directionZRange( ValueType( 0.0 ) ),
 					  kernelRadius( ValueType( 0.0 ) ),
 					  impulseDensity( ValueType( 0.0 ) ),
-					  variance( ValueType( 0.0 ) )
+					  variance( ValueType( 0.0 ) ),
+					  impulseCountTable(),
+					  fixedFrequency( false ),
+					  fixedOrientation( false ),
+					  radial( false ),
+					  orientationX( ValueType( 0.0 ) ),
+					  orientationY( ValueType( 0.0 ) ),
+					  cacheTag( nextCacheTag() )
 					{
 						recalculateKernelProperties();
 						recalculateFrequencyProperties();
 						recalculateAngularProperties();
+						recalculateCarrierProperties();
 						recalculateVariance();
 					}
 
+					// Draws frequency and orientation of the next impulse, zero spread parameters
+					// are not drawn at all
+					template< typename PrngType >
+					inline
+					void
+					nextImpulseParameters( PrngType& prng, ValueType& impulseF0, ValueType& impulseOmega0 ) const
+					{
+						impulseF0 = fixedFrequency == true ? F0 : prng.uniformRange( frequencyRangeStart, frequencyRangeEnd );
+						impulseOmega0 = fixedOrientation == true ? omega0 : prng.uniformRange( angularRangeStart, angularRangeEnd );
+					}
+
+					// 3D impulses also draw the z component of their carrier direction
+					template< typename PrngType >
+					inline
+					void
+					nextImpulseParameters( PrngType& prng, ValueType& impulseF0, ValueType& impulseOmega0, ValueType& impulseDirectionZ ) const
+					{
+						nextImpulseParameters( prng, impulseF0, impulseOmega0 );
+						impulseDirectionZ = fixedOrientation == true ? ValueType( 0.0 ) : prng.uniformRange( -directionZRange, directionZRange );
+					}
+
+					// Carrier 2 * pi * F0 * ( cos( omega0 ), sin( omega0 ) ) of an impulse, the sine and
+					// cosine are only evaluated for widgets with orientation spread
+					inline
+					void
+					carrier( ValueType impulseF0, ValueType impulseOmega0, ValueType& cx, ValueType& cy ) const
+					{
+						if( fixedOrientation == true )
+						{
+							cx = impulseF0 * orientationX;
+							cy = impulseF0 * orientationY;
+						}
+						else
+						{
+							ValueType	sinOmega0;
+							ValueType	cosOmega0;
+
+							math::Math< ValueType >::sinCos( impulseOmega0, sinOmega0, cosOmega0 );
+							cx = ValueType( 2.0 ) * math::Math< ValueType >::Pi() * impulseF0 * cosOmega0;
+							cy = ValueType( 2.0 ) * math::Math< ValueType >::Pi() * impulseF0 * sinOmega0;
+						}
+					}
+
+					// 3D carrier, the direction ( cos( omega0 ), sin( omega0 ) ) is lifted out of the
+					// XY plane to the z component directionZ
+					inline
+					void
+					carrier( ValueType impulseF0, ValueType impulseOmega0, ValueType impulseDirectionZ, ValueType& cx, ValueType& cy, ValueType& cz ) const
+					{
+						if( fixedOrientation == true )
+						{
+							carrier( impulseF0, impulseOmega0, cx, cy );
+							cz = ValueType( 0.0 );
+						}
+						else
+						{
+							ValueType	planar = std::sqrt( ValueType( 1.0 ) - (impulseDirectionZ * impulseDirectionZ) );
+
+							carrier( impulseF0 * planar, impulseOmega0, cx, cy );
+							cz = ValueType( 2.0 ) * math::Math< ValueType >::Pi() * impulseF0 * impulseDirectionZ;
+						}
+					}
+
 
 					ValueType		K;
 					ValueType		a;
@@ -253,20 +342,68 @@ namespace noise2
 					ValueType		frequencyRangeEnd;
 					ValueType		angularRangeStart;
 					ValueType		angularRangeEnd;
+					// z components of 3D carrier directions are uniform in [ -directionZRange,
+					// directionZRange ], which covers all elevations up to half the angular spread
+					ValueType		directionZRange;
 
 					ValueType		kernelRadius;
 					ValueType		impulseDensity;
 					ValueType		variance;
 
+					// Number of impulses per cell, mean impulseDensity * kernelRadius^Dimension
+					PoissonTable< ValueType >	impulseCountTable;
+
+					// Zero spreads, impulses do not draw these parameters
+					bool			fixedFrequency;
+					bool			fixedOrientation;
+					// Fixed zero frequency, the kernel is just the Gaussian envelope
+					bool			radial;
+					// 2 * pi * ( cos( omega0 ), sin( omega0 ) )
+					ValueType		orientationX;
+					ValueType		orientationY;
+
+					// Identifies the widget parameters in the impulse cache
+					uint32			cacheTag;
+
 
 
 				private:
 
+					// Widgets prepared concurrently get distinct tags, zero is left for empty
+					// cache slots
+					static inline
+					uint32
+					nextCacheTag()
+					{
+						static volatile long	lastTag = 0;
+						uint32					tag;
+
+						do
+						{
+							tag = uint32( LIBNOISE2_ATOMIC_INCREMENT( lastTag ) );
+						}
+						while( tag == 0 );
+
+						return tag;
+					}
+
 					void
 					recalculateKernelProperties()
 					{
 						kernelRadius = std::sqrt( -std::log( ValueType( 0.05 ) ) / math::Math< ValueType >::Pi() ) / a;
-						impulseDensity = numberOfImpulses / (math::Math< ValueType >::Pi() * kernelRadius * kernelRadius);
+
+						if( Dimension == 3 )
+						{
+							ValueType	kernelVolume = kernelRadius * kernelRadius * kernelRadius;
+
+							impulseDensity = numberOfImpulses / ((ValueType( 4.0 ) / ValueType( 3.0 )) * math::Math< ValueType >::Pi() * kernelVolume);
+							impulseCountTable.build( impulseDensity * kernelVolume );
+						}
+						else
+						{
+							impulseDensity = numberOfImpulses / (math::Math< ValueType >::Pi() * kernelRadius * kernelRadius);
+							impulseCountTable.build( impulseDensity * kernelRadius * kernelRadius );
+						}
 					}
 
 					void
@@ -281,26 +418,114 @@ namespace noise2
 					{
 						angularRangeStart = omega0 - angularSpread / ValueType( 2.0 );
 						angularRangeEnd = omega0 + angularSpread / ValueType( 2.0 );
+
+						ValueType	halfSpread = angularSpread / ValueType( 2.0 );
+						directionZRange = halfSpread < math::Math< ValueType >::Pi() / ValueType( 2.0 ) ? std::sin( halfSpread ) : ValueType( 1.0 );
+					}
+
+					void
+					recalculateCarrierProperties()
+					{
+						ValueType	sinOmega0;
+						ValueType	cosOmega0;
+
+						fixedFrequency = frequencySpread == ValueType( 0.0 );
+						fixedOrientation = angularSpread == ValueType( 0.0 );
+						radial = fixedFrequency == true && F0 == ValueType( 0.0 );
+
+						math::Math< ValueType >::sinCos( omega0, sinOmega0, cosOmega0 );
+						orientationX = ValueType( 2.0 ) * math::Math< ValueType >::Pi() * cosOmega0;
+						orientationY = ValueType( 2.0 ) * math::Math< ValueType >::Pi() * sinOmega0;
 					}
 
 					void
 					recalculateVariance()
 					{
 						ValueType	integralGaborFilterSquared = ((K * K) / (ValueType( 4.0 ) * a * a)) * (ValueType( 1.0 ) + math::Math< ValueType >::exp( -(ValueType( 2.0 ) * math::Math< ValueType >::Pi() * F0 * F0) / (a * a) ));
+
+						if( Dimension == 3 )
+						{
+							// The envelope integrates to ( 2 * a^2 )^( -1 / 2 ) along the third axis
+							integralGaborFilterSquared /= std::sqrt( ValueType( 2.0 ) ) * a;
+						}
+
 						variance = impulseDensity * (ValueType( 1.0 ) / ValueType( 3.0 )) * integralGaborFilterSquared;
 					}
 
 				};
 
+				// Widgets with equal kernel radius share one cell traversal, and their impulses share
+				// vector lanes. Widgets with and without angular spread are kept in separate groups,
+				// so the carrier of fixed orientation impulses never needs a sine and cosine.
+				// K is folded into the impulse weights.
+				struct WidgetGroup
+				{
+
+					inline
+					WidgetGroup( const PreparedWidget& widget, uint32 index ):
+					  a( widget.a ),
+					  kernelRadius( widget.kernelRadius ),
+					  radial( widget.radial ),
+					  fixedOrientation( widget.fixedOrientation )
+					{
+						add( widget, index );
+					}
+
+					inline
+					bool
+					accepts( const PreparedWidget& widget ) const
+					{
+						return widget.kernelRadius == kernelRadius && widget.fixedOrientation == fixedOrientation;
+					}
+
+					inline
+					void
+					add( const PreparedWidget& widget, uint32 index )
+					{
+						radial = radial == true && widget.radial == true;
+
+						widgets.push_back( index );
+						seeds.push_back( widget.seed );
+						K.push_back( widget.K );
+					}
+
+					inline
+					uint32
+					size() const
+					{
+						return uint32( widgets.size() );
+					}
+
+
+					ValueType		a;
+					ValueType		kernelRadius;
+					// All members have F0 fixed at zero
+					bool			radial;
+					bool			fixedOrientation;
+
+					// Members, indices into preparedWidgets and the fields used by the traversal
+					std::vector< uint32 >		widgets;
+					std::vector< uint32 >		seeds;
+					std::vector< ValueType >	K;
+
+				};
+
 				std::vector< PreparedWidget >		preparedWidgets;
+				std::vector< WidgetGroup >			widgetGroups;
 				ValueType							combinedVariance;
+				bool								impulseCacheEnabled;
+				bool								periodic;
+				uint32								period;
 
 
 
 			public:
 
 				GaborBase():
-				  combinedVariance( 1.0 )
+				  combinedVariance( 1.0 ),
+				  impulseCacheEnabled( false ),
+				  periodic( false ),
+				  period( Defaults::period() )
 				{
 					AddWidget( Widget() );
 				}
@@ -311,6 +536,7 @@ namespace noise2
 				{
 					preparedWidgets.push_back( PreparedWidget( widget ) );
 					recalculateCombinedVariance();
+					recalculateWidgetGroups();
 				}
 
 				inline
@@ -337,12 +563,234 @@ namespace noise2
 				{
 					preparedWidgets[ index ] = PreparedWidget( widget );
 					recalculateCombinedVariance();
+					recalculateWidgetGroups();
+				}
+
+				inline
+				uint32
+				GetWidgetCount() const
+				{
+					return uint32( preparedWidgets.size() );
+				}
+
+				// When enabled, decoded cell impulses are kept in a bounded thread-local
+				// cache, so neighbouring samples do not regenerate them from the PRNG.
+				inline
+				void
+				EnableImpulseCache( bool enable )
+				{
+					impulseCacheEnabled = enable;
+				}
+
+				inline
+				bool
+				IsImpulseCacheEnabled() const
+				{
+					return impulseCacheEnabled;
+				}
+
+				// When enabled, cell coordinates wrap around after period cells, so every widget
+				// repeats with a period of ( period * kernel radius ) along each axis.
+				inline
+				void
+				EnablePeriodic( bool enable )
+				{
+					periodic = enable;
+				}
+
+				inline
+				bool
+				IsPeriodic() const
+				{
+					return periodic;
+				}
+
+				// Returns false and keeps the current period if newPeriod is zero or exceeds
+				// MaxPeriod
+				inline
+				bool
+				SetPeriod( uint32 newPeriod )
+				{
+					if( newPeriod == 0 || newPeriod > uint32( MaxPeriod ) )
+					{
+						return false;
+					}
+
+					period = newPeriod;
+					return true;
+				}
+
+				inline
+				uint32
+				GetPeriod() const
+				{
+					return period;
+				}
+
+				// Length of one period of the widget at index. Widgets with different kernel
+				// radii repeat only over a common multiple of their period lengths.
+				inline
+				ValueType
+				GetPeriodLength( uint32 index = 0 ) const
+				{
+					return ValueType( period ) * preparedWidgets[ index ].kernelRadius;
 				}
 
 			
 
+			protected:
+
+				// Seed of a cell for one widget, zero would keep the PRNG at zero
+				static inline
+				uint32
+				cellSeed( uint32 morton, uint32 widgetSeed )
+				{
+					uint32	s = morton + widgetSeed;
+
+					return s == 0 ? 1 : s;
+				}
+
+				// Cell coordinate as seen by the Morton code, wrapped into [ 0, period ) in periodic mode
+				inline
+				uint32
+				wrapCell( uint32 c ) const
+				{
+					if( periodic == false )
+					{
+						return c;
+					}
+
+					int32	wrapped = int32( c ) % int32( period );
+
+					return uint32( wrapped < 0 ? wrapped + int32( period ) : wrapped );
+				}
+
+				// 2D cell code, interleaving the bits of the wrapped cell coordinates
+				inline
+				uint32
+				morton( uint32 x, uint32 y ) const
+				{
+					x = wrapCell( x );
+					y = wrapCell( y );
+
+					uint32	z = 0;
+
+					for( uint32 i = 0; i < (sizeof( uint32 ) * CHAR_BIT); ++i )
+					{
+						z |= ((x & (1 << i)) << i) | ((y & (1 << i)) << (i + 1));
+					}
+
+					return z;
+				}
+
+				// 2D grid of width x height samples with the impulses convolved with the kernel in
+				// the frequency domain, see SpectralGrid. Pays off for large grids with dense
+				// sampling. Results differ from GetValue by the bilinear placement of impulses on
+				// the grid. Returns false, leaving output untouched, if a widget has a random
+				// frequency or orientation, which the convolution can not factor out.
+				bool
+				valueGridSpectral( ValueType originX, ValueType originY, ValueType stepX, ValueType stepY,
+								   size_t width, size_t height, ValueType* output ) const
+				{
+					for( size_t w = 0; w < preparedWidgets.size(); ++w )
+					{
+						if( preparedWidgets[ w ].fixedFrequency == false || preparedWidgets[ w ].fixedOrientation == false )
+						{
+							return false;
+						}
+					}
+
+					for( size_t s = 0; s < width * height; ++s )
+					{
+						output[ s ] = ValueType( 0.0 );
+					}
+
+					typename ImpulseCache< ValueType >::CellImpulses		impulses;
+
+					for( size_t w = 0; w < preparedWidgets.size(); ++w )
+					{
+						const PreparedWidget&		widget = preparedWidgets[ w ];
+						ValueType					r = widget.kernelRadius;
+						SpectralGrid< ValueType >	grid( stepX, stepY, r, widget.a, widget.K,
+														  widget.F0 * widget.orientationX, widget.F0 * widget.orientationY );
+						uint32						tileSize = grid.getTileSize();
+
+						for( size_t tileY = 0; tileY < height; tileY += tileSize )
+						{
+							for( size_t tileX = 0; tileX < width; tileX += tileSize )
+							{
+								ValueType	tileOriginX = originX + (ValueType( tileX ) * stepX);
+								ValueType	tileOriginY = originY + (ValueType( tileY ) * stepY);
+								int32		iBegin = int32( std::floor( (tileOriginX - r) / r ) );
+								int32		iEnd = int32( std::floor( (tileOriginX + (ValueType( tileSize ) * stepX) + r) / r ) );
+								int32		jBegin = int32( std::floor( (tileOriginY - r) / r ) );
+								int32		jEnd = int32( std::floor( (tileOriginY + (ValueType( tileSize ) * stepY) + r) / r ) );
+
+								grid.beginTile();
+
+								for( int32 j = jBegin; j <= jEnd; ++j )
+								{
+									for( int32 i = iBegin; i <= iEnd; ++i )
+									{
+										ImpulseCache< ValueType >::generate( impulses, widget, cellSeed( morton( i, j ), widget.seed ) );
+
+										ValueType	cellX = (ValueType( i ) * r) - tileOriginX;
+										ValueType	cellY = (ValueType( j ) * r) - tileOriginY;
+
+										for( uint32 k = 0; k < impulses.count; ++k )
+										{
+											grid.splat( cellX + (impulses.xi[ k ] * r), cellY + (impulses.yi[ k ] * r), impulses.wi[ k ] );
+										}
+									}
+								}
+
+								size_t	tileWidth = width - tileX < tileSize ? width - tileX : tileSize;
+								size_t	tileHeight = height - tileY < tileSize ? height - tileY : tileSize;
+
+								grid.endTile( output + (tileY * width) + tileX, width, uint32( tileWidth ), uint32( tileHeight ) );
+							}
+						}
+					}
+
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( 3.0 ) * std::sqrt( combinedVariance ));
+
+					for( size_t s = 0; s < width * height; ++s )
+					{
+						output[ s ] *= scale;
+					}
+
+					return true;
+				}
+
+
+
 			private:
 
+				void
+				recalculateWidgetGroups()
+				{
+					widgetGroups.clear();
+
+					for( size_t i = 0; i < preparedWidgets.size(); ++i )
+					{
+						size_t	g = 0;
+
+						while( g < widgetGroups.size() && widgetGroups[ g ].accepts( preparedWidgets[ i ] ) == false )
+						{
+							++g;
+						}
+
+						if( g == widgetGroups.size() )
+						{
+							widgetGroups.push_back( WidgetGroup( preparedWidgets[ i ], uint32( i ) ) );
+						}
+						else
+						{
+							widgetGroups[ g ].add( preparedWidgets[ i ], uint32( i ) );
+						}
+					}
+				}
+
 				void
 				recalculateCombinedVariance()
 				{
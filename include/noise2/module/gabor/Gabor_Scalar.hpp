@@ -8,8 +8,11 @@
 
 #include <noise2/module/Module.hpp>
 #include <noise2/math/Math.hpp>
+#include <noise2/math/Precision.hpp>
 #include <noise2/module/gabor/GaborBase.hpp>
+#include <noise2/module/gabor/ImpulseCache.hpp>
 #include <noise2/module/gabor/Prng.hpp>
+#include <noise2/module/gabor/SampleBins.hpp>
 
 
 
@@ -23,8 +26,8 @@ namespace noise2
 		namespace gabor
 		{
 
-			template< typename ValueT >
-			class GaborImpl< ValueT, 2, 1 >: public Module< ValueT, 2 >, public gabor::GaborBase< ValueT >
+			template< typename ValueT, typename PrecisionT >
+			class GaborImpl< ValueT, 2, 1, PrecisionT >: public Module< ValueT, 2 >, public gabor::GaborBase< ValueT >
 			{
 
 			public:
@@ -33,13 +36,17 @@ namespace noise2
 				static const uint32								Dimension = 2;
 				typedef Module< ValueType, Dimension >			ModuleType;
 				typedef gabor::GaborBase< ValueType >			BaseType;
-				typedef GaborImpl< ValueType, Dimension, 1 >	ThisType;
+				typedef GaborImpl< ValueType, Dimension, 1, PrecisionT >	ThisType;
 
 
 
 			private:
 				typedef gabor::Prng< ValueType >				PrngType;
-				typedef math::Math< ValueType >					M;
+				typedef gabor::ImpulseCache< ValueType >		CacheType;
+				typedef gabor::SampleBins< ValueType, 1 >		BinsType;
+				typedef math::MathPrecision< ValueType, PrecisionT >	M;
+
+				using BaseType::morton;
 
 
 
@@ -60,12 +67,12 @@ namespace noise2
 				{
 					ValueType	noise = ValueType( 0.0 );
 
-					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
 					{
-						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
 
-						ValueType	widgetX = x / widget.kernelRadius;
-						ValueType	widgetY = y / widget.kernelRadius;
+						ValueType	widgetX = x / group.kernelRadius;
+						ValueType	widgetY = y / group.kernelRadius;
 
 						ValueType	intX = M::floor( widgetX );
 						ValueType	intY = M::floor( widgetY );
@@ -78,7 +85,7 @@ namespace noise2
 						{
 							for( int32 dj = -1; dj <= 1; ++dj )
 							{
-								noise += cell( widget, i + di, j + dj, fracX - di, fracY - dj );
+								noise += cell( group, morton( i + di, j + dj ), fracX - di, fracY - dj );
 							}
 						}
 					}
@@ -86,35 +93,175 @@ namespace noise2
 					return noise / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
 				}
 
+				// Evaluates count arbitrary samples. Samples are grouped by cell so that the impulses
+				// of every cell are generated only once and applied to all samples they reach.
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					BinsType								bins;
+					typename CacheType::CellImpulses		impulses;
+
+					for( size_t s = 0; s < count; ++s )
+					{
+						output[ s ] = ValueType( 0.0 );
+					}
+
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
+					{
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
+
+						bins.build( inputX, inputY, count, group.kernelRadius );
+
+						for( size_t c = 0; c < bins.sourceCells.size(); ++c )
+						{
+							const typename BinsType::Cell&	source = bins.sourceCells[ c ];
+							const typename BinsType::Bin*	targets[ 9 ];
+
+							for( int32 t = 0; t < 9; ++t )
+							{
+								targets[ t ] = bins.find( source.i + (t / 3) - 1, source.j + (t % 3) - 1 );
+							}
+
+							uint32	m = morton( source.i, source.j );
+
+							for( uint32 k = 0; k < group.size(); ++k )
+							{
+								const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+								CacheType::generate( impulses, widget, BaseType::cellSeed( m, group.seeds[ k ] ) );
+
+								if( impulses.count == 0 )
+								{
+									continue;
+								}
+
+								for( int32 t = 0; t < 9; ++t )
+								{
+									if( targets[ t ] != 0 )
+									{
+										ValueType	dx = ValueType( (t / 3) - 1 );
+										ValueType	dy = ValueType( (t % 3) - 1 );
+
+										for( uint32 b = targets[ t ]->begin; b < targets[ t ]->end; ++b )
+										{
+											bins.accumulated[ b ] += cellCached( widget, impulses, bins.x[ b ] + dx, bins.y[ b ] + dy );
+										}
+									}
+								}
+							}
+						}
+
+						bins.scatter( output );
+					}
+
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+
+					for( size_t s = 0; s < count; ++s )
+					{
+						output[ s ] *= scale;
+					}
+				}
+
+				// Evaluates a width x height grid starting at origin, output is stored row by row
+				void
+				GetValueGrid( ValueType originX, ValueType originY, ValueType stepX, ValueType stepY,
+							  size_t width, size_t height, ValueType* output ) const
+				{
+					size_t	rowsPerStrip = LIBNOISE2_GABOR_GRID_STRIP_SAMPLES / (width > 0 ? width : 1);
+
+					if( rowsPerStrip == 0 )
+					{
+						rowsPerStrip = 1;
+					}
+
+					std::vector< ValueType >	stripX;
+					std::vector< ValueType >	stripY;
+
+					for( size_t row = 0; row < height; row += rowsPerStrip )
+					{
+						size_t	rows = height - row < rowsPerStrip ? height - row : rowsPerStrip;
+
+						stripX.resize( rows * width );
+						stripY.resize( rows * width );
+
+						for( size_t r = 0; r < rows; ++r )
+						{
+							for( size_t c = 0; c < width; ++c )
+							{
+								stripX[ (r * width) + c ] = originX + (ValueType( c ) * stepX);
+								stripY[ (r * width) + c ] = originY + (ValueType( row + r ) * stepY);
+							}
+						}
+
+						if( rows * width > 0 )
+						{
+							GetValueArray( &stripX[ 0 ], &stripY[ 0 ], output + (row * width), rows * width );
+						}
+					}
+				}
+
+				// Same as GetValueGrid, but impulses are convolved with the kernel on the grid in the
+				// frequency domain, see GaborBase::valueGridSpectral. Falls back to GetValueGrid
+				// unless all widgets have fixed frequency and orientation.
+				void
+				GetValueGridSpectral( ValueType originX, ValueType originY, ValueType stepX, ValueType stepY,
+									  size_t width, size_t height, ValueType* output ) const
+				{
+					if( this->valueGridSpectral( originX, originY, stepX, stepY, width, height, output ) == false )
+					{
+						GetValueGrid( originX, originY, stepX, stepY, width, height, output );
+					}
+				}
+
 
 
 			private:
 
 				inline
 				ValueType
-				gabor( float K, float a, float F0, float omega0, float x, float y ) const
+				gabor( const typename BaseType::PreparedWidget& widget, ValueType F0, ValueType omega0, ValueType x, ValueType y ) const
 				{
-					ValueType	gaussianEnvelop = K * M::exp( -M::Pi() * (a * a) * ((x * x) + (y * y)) );
-					ValueType	omega0Sin;
-					ValueType	omega0Cos;
-					M::sinCos( omega0, omega0Sin, omega0Cos );
-					ValueType	sinusoidalCarrier = M::cos( ValueType( 2.0 ) * M::Pi() * F0 * ((x * omega0Cos) + (y * omega0Sin)) );
+					ValueType	gaussianEnvelop = widget.K * M::exp( -M::Pi() * (widget.a * widget.a) * ((x * x) + (y * y)) );
+
+					if( widget.radial == true )
+					{
+						return gaussianEnvelop;
+					}
+
+					ValueType	cx;
+					ValueType	cy;
+					widget.carrier( F0, omega0, cx, cy );
+					ValueType	sinusoidalCarrier = M::cos( (x * cx) + (y * cy) );
 					return gaussianEnvelop * sinusoidalCarrier;
 				}
 
+				// Impulses of all group members in the cell with Morton code m
 				inline
 				ValueType
-				cell( const typename BaseType::PreparedWidget& widget, int32 i, int32 j, ValueType x, ValueType y ) const
+				cell( const typename BaseType::WidgetGroup& group, uint32 m, ValueType x, ValueType y ) const
 				{
-					uint32	s = morton( i, j ) + widget.seed;
+					ValueType	noise = ValueType( 0.0 );
 
-					if( s == 0 )
-						s = 1;
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						noise += cell( this->preparedWidgets[ group.widgets[ k ] ], BaseType::cellSeed( m, group.seeds[ k ] ), x, y );
+					}
+
+					return noise;
+				}
+
+				inline
+				ValueType
+				cell( const typename BaseType::PreparedWidget& widget, uint32 s, ValueType x, ValueType y ) const
+				{
+					if( this->impulseCacheEnabled == true )
+					{
+						return cellCached( widget, CacheType::forCurrentThread().lookup( widget, s ), x, y );
+					}
 
 					PrngType	prng( s );
 					
-					ValueType	numberOfImpulsesPerCell = widget.impulseDensity * widget.kernelRadius * widget.kernelRadius;
-					uint32		numberOfImpulses = prng.poisson( numberOfImpulsesPerCell );
+					uint32		numberOfImpulses = prng.poisson( widget.impulseCountTable );
 					ValueType	noise = ValueType( 0.0 );
 
 					for( uint32 i = 0; i < numberOfImpulses; ++i)
@@ -122,32 +269,233 @@ namespace noise2
 						ValueType	xi = prng.uniformNormalized();
 						ValueType	yi = prng.uniformNormalized();
 						ValueType	wi = prng.uniformRange( -1.0, +1.0 );
-						ValueType	F0 = prng.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
-						ValueType	omega0 = prng.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
+						ValueType	F0;
+						ValueType	omega0;
+						widget.nextImpulseParameters( prng, F0, omega0 );
 						ValueType	xix = x - xi;
 						ValueType	yiy = y - yi;
 
 						if( ((xix * xix) + (yiy * yiy)) < ValueType( 1.0 ) )
 						{
-							noise += wi * gabor( widget.K, widget.a, F0, omega0, xix * widget.kernelRadius, yiy * widget.kernelRadius ); // anisotropic
+							noise += wi * gabor( widget, F0, omega0, xix * widget.kernelRadius, yiy * widget.kernelRadius ); // anisotropic
 						}
 					}
 
 					return noise;
 				}
 
+				inline
+				ValueType
+				cellCached( const typename BaseType::PreparedWidget& widget, const typename CacheType::CellImpulses& impulses,
+							ValueType x, ValueType y ) const
+				{
+					ValueType	noise = ValueType( 0.0 );
+
+					for( uint32 i = 0; i < impulses.count; ++i )
+					{
+						ValueType	xix = x - impulses.xi[ i ];
+						ValueType	yiy = y - impulses.yi[ i ];
+
+						if( ((xix * xix) + (yiy * yiy)) < ValueType( 1.0 ) )
+						{
+							noise += impulses.wi[ i ] * gabor( widget, impulses.F0[ i ], impulses.omega0[ i ], xix * widget.kernelRadius, yiy * widget.kernelRadius );
+						}
+					}
+
+					return noise;
+				}
+
+			};
+
+
+			template< typename ValueT, typename PrecisionT >
+			class GaborImpl< ValueT, 3, 1, PrecisionT >: public Module< ValueT, 3 >, public gabor::GaborBase< ValueT, 3 >
+			{
+
+			public:
+
+				typedef ValueT									ValueType;
+				static const uint32								Dimension = 3;
+				typedef Module< ValueType, Dimension >			ModuleType;
+				typedef gabor::GaborBase< ValueType, 3 >		BaseType;
+				typedef GaborImpl< ValueType, Dimension, 1, PrecisionT >	ThisType;
+
+
+
+			private:
+				typedef gabor::Prng< ValueType >				PrngType;
+				typedef gabor::ImpulseCache< ValueType, 3 >		CacheType;
+				typedef math::MathPrecision< ValueType, PrecisionT >	M;
+
+
+
+			public:
+
+				GaborImpl():
+				  ModuleType( 0 ),
+				  BaseType()
+				{}
+
+				virtual
+				~GaborImpl()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					ValueType	noise = ValueType( 0.0 );
+
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
+					{
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
+
+						ValueType	widgetX = x / group.kernelRadius;
+						ValueType	widgetY = y / group.kernelRadius;
+						ValueType	widgetZ = z / group.kernelRadius;
+
+						ValueType	intX = M::floor( widgetX );
+						ValueType	intY = M::floor( widgetY );
+						ValueType	intZ = M::floor( widgetZ );
+						ValueType	fracX = widgetX - intX;
+						ValueType	fracY = widgetY - intY;
+						ValueType	fracZ = widgetZ - intZ;
+						int32		i = int( intX );
+						int32		j = int( intY );
+						int32		k = int( intZ );
+
+						for( int32 di = -1; di <= 1; ++di )
+						{
+							for( int32 dj = -1; dj <= 1; ++dj )
+							{
+								for( int32 dk = -1; dk <= 1; ++dk )
+								{
+									noise += cell( group, morton( i + di, j + dj, k + dk ), fracX - di, fracY - dj, fracZ - dk );
+								}
+							}
+						}
+					}
+
+					return noise / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+				}
+
+
+
+			private:
+
+				inline
+				ValueType
+				gabor( const typename BaseType::PreparedWidget& widget, ValueType F0, ValueType omega0, ValueType directionZ,
+					   ValueType x, ValueType y, ValueType z ) const
+				{
+					ValueType	gaussianEnvelop = widget.K * M::exp( -M::Pi() * (widget.a * widget.a) * ((x * x) + (y * y) + (z * z)) );
+
+					if( widget.radial == true )
+					{
+						return gaussianEnvelop;
+					}
+
+					ValueType	cx;
+					ValueType	cy;
+					ValueType	cz;
+					widget.carrier( F0, omega0, directionZ, cx, cy, cz );
+					ValueType	sinusoidalCarrier = M::cos( (x * cx) + (y * cy) + (z * cz) );
+					return gaussianEnvelop * sinusoidalCarrier;
+				}
+
+				// Impulses of all group members in the cell with Morton code m
+				inline
+				ValueType
+				cell( const typename BaseType::WidgetGroup& group, uint32 m, ValueType x, ValueType y, ValueType z ) const
+				{
+					ValueType	noise = ValueType( 0.0 );
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						noise += cell( this->preparedWidgets[ group.widgets[ k ] ], BaseType::cellSeed( m, group.seeds[ k ] ), x, y, z );
+					}
+
+					return noise;
+				}
+
+				inline
+				ValueType
+				cell( const typename BaseType::PreparedWidget& widget, uint32 s, ValueType x, ValueType y, ValueType z ) const
+				{
+					if( this->impulseCacheEnabled == true )
+					{
+						return cellCached( widget, CacheType::forCurrentThread().lookup( widget, s ), x, y, z );
+					}
+
+					PrngType	prng( s );
+
+					uint32		numberOfImpulses = prng.poisson( widget.impulseCountTable );
+					ValueType	noise = ValueType( 0.0 );
+
+					for( uint32 i = 0; i < numberOfImpulses; ++i)
+					{
+						ValueType	xi = prng.uniformNormalized();
+						ValueType	yi = prng.uniformNormalized();
+						ValueType	zi = prng.uniformNormalized();
+						ValueType	wi = prng.uniformRangeMinusOneToOne();
+						ValueType	F0;
+						ValueType	omega0;
+						ValueType	directionZ;
+						widget.nextImpulseParameters( prng, F0, omega0, directionZ );
+						ValueType	xix = x - xi;
+						ValueType	yiy = y - yi;
+						ValueType	ziz = z - zi;
+
+						if( ((xix * xix) + (yiy * yiy) + (ziz * ziz)) < ValueType( 1.0 ) )
+						{
+							noise += wi * gabor( widget, F0, omega0, directionZ, xix * widget.kernelRadius, yiy * widget.kernelRadius, ziz * widget.kernelRadius );
+						}
+					}
+
+					return noise;
+				}
+
+				inline
+				ValueType
+				cellCached( const typename BaseType::PreparedWidget& widget, const typename CacheType::CellImpulses& impulses,
+							ValueType x, ValueType y, ValueType z ) const
+				{
+					ValueType	noise = ValueType( 0.0 );
+
+					for( uint32 i = 0; i < impulses.count; ++i )
+					{
+						ValueType	xix = x - impulses.xi[ i ];
+						ValueType	yiy = y - impulses.yi[ i ];
+						ValueType	ziz = z - impulses.zi[ i ];
+
+						if( ((xix * xix) + (yiy * yiy) + (ziz * ziz)) < ValueType( 1.0 ) )
+						{
+							noise += impulses.wi[ i ] * gabor( widget, impulses.F0[ i ], impulses.omega0[ i ], impulses.directionZ[ i ],
+															   xix * widget.kernelRadius, yiy * widget.kernelRadius, ziz * widget.kernelRadius );
+						}
+					}
+
+					return noise;
+				}
+
+				// Interleaves the low 10 bits of every coordinate and mixes in a hash of the
+				// remaining bits, so the cells do not repeat every 1024 cells
 				inline
 				uint32
-				morton( uint32 x, uint32 y ) const
+				morton( uint32 x, uint32 y, uint32 z ) const
 				{
-					uint32	z = 0;
+					x = this->wrapCell( x );
+					y = this->wrapCell( y );
+					z = this->wrapCell( z );
+
+					uint32	m = 0;
 
-					for( uint32 i = 0; i < (sizeof( uint32 ) * CHAR_BIT); ++i )
+					for( uint32 i = 0; i < 10; ++i )
 					{
-						z |= ((x & (1 << i)) << i) | ((y & (1 << i)) << (i + 1));
+						m |= ((x & (1u << i)) << (i * 2)) | ((y & (1u << i)) << ((i * 2) + 1)) | ((z & (1u << i)) << ((i * 2) + 2));
 					}
 
-					return z;
+					return m ^ ((x >> 10) * 0x9E3779B1u) ^ ((y >> 10) * 0x85EBCA77u) ^ ((z >> 10) * 0xC2B2AE3Du);
 				}
 
 			};
@@ -7,10 +7,14 @@
 
 
 #include <noise2/math/Math.hpp>
+#include <noise2/math/Precision.hpp>
 #include <noise2/module/Module.hpp>
 #include <noise2/module/gabor/GaborBase.hpp>
+#include <noise2/module/gabor/ImpulseCache.hpp>
 #include <noise2/module/gabor/Prng.hpp>
 #include <noise2/module/gabor/PrngVector.hpp>
+#include <noise2/module/gabor/SampleBins.hpp>
+#include <noise2/module/gabor/Statistics.hpp>
 
 #include <noise2/debug/Debug.hpp>
 
@@ -26,8 +30,10 @@ namespace noise2
 		namespace gabor
 		{
 
-			template< typename ValueT >
-			class GaborImpl< ValueT, 2, 4 >: public Module< ValueT, 2 >, public gabor::GaborBase< ValueT >
+			// Four lanes only, unlike the Perlin family. PrngVector and MathPrecision have no lane
+			// count yet, and active lanes are compacted through four bit moveMask tables.
+			template< typename ValueT, typename PrecisionT >
+			class GaborImpl< ValueT, 2, 4, PrecisionT >: public Module< ValueT, 2 >, public gabor::GaborBase< ValueT >
 			{
 
 			public:
@@ -36,14 +42,18 @@ namespace noise2
 				static const unsigned							Dimension = 2;
 				typedef Module< ValueType, Dimension >			ModuleType;
 				typedef gabor::GaborBase< ValueType >			BaseType;
-				typedef GaborImpl< ValueType, Dimension, 4 >	ThisType;
+				typedef GaborImpl< ValueType, Dimension, 4, PrecisionT >	ThisType;
 
 
 
 			private:
 				typedef gabor::Prng< ValueType >			PrngType;
 				typedef gabor::PrngVector< ValueType >		PrngVectorType;
-				typedef math::Math< ValueType >				M;
+				typedef gabor::ImpulseCache< ValueType >	CacheType;
+				typedef gabor::SampleBins< ValueType, 4 >	BinsType;
+				typedef math::MathPrecision< ValueType, PrecisionT >	M;
+
+				using BaseType::morton;
 
 
 
@@ -64,12 +74,12 @@ namespace noise2
 				{
 					ValueType	noise = ValueType( 0.0 );
 
-					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
 					{
-						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
 
-						ValueType	widgetX = x / widget.kernelRadius;
-						ValueType	widgetY = y / widget.kernelRadius;
+						ValueType	widgetX = x / group.kernelRadius;
+						ValueType	widgetY = y / group.kernelRadius;
 
 						ValueType	intX = M::floor( widgetX );
 						ValueType	intY = M::floor( widgetY );
@@ -78,6 +88,21 @@ namespace noise2
 						int32		i = int32( intX );
 						int32		j = int32( intY );
 
+						if( this->impulseCacheEnabled == true )
+						{
+							CacheType&	cache = CacheType::forCurrentThread();
+
+							for( int32 di = -1; di <= 1; ++di )
+							{
+								for( int32 dj = -1; dj <= 1; ++dj )
+								{
+									noise += cellCached( group, cache, morton( i + di, j + dj ), fracX - di, fracY - dj );
+								}
+							}
+
+							continue;
+						}
+
 						typename M::Vector4F	fracXV = M::vectorizeOne( widgetX - intX );
 						typename M::Vector4F	fracYV = M::vectorizeOne( widgetY - intY );
 
@@ -131,15 +156,14 @@ namespace noise2
 							typename M::Vector4I	djjV = M::add( djV, jV );
 							typename M::Vector4F	xV = M::subtract( fracXV, M::intToFloat( diV ) );
 							typename M::Vector4F	yV = M::subtract( fracYV, M::intToFloat( djV ) );
-							typename M::Vector4I	mortonV = mortonVectorized( widget, diiV, djjV );
+							typename M::Vector4I	mortonV = mortonVectorized( diiV, djjV );
 							
-							noise += cellVectorized( widget, mortonV, xV, yV );
+							noise += cellVectorized( group, mortonV, xV, yV );
 						}
 
 						for( int32 c = 8; c < 9; ++c )
 						{
-							uint32	s = morton( widget, diA[ c ] + i, djA[ c ] + j );
-							noise += cell( widget, s, fracX - diA[ c ], fracY - djA[ c ] );
+							noise += cell( group, morton( diA[ c ] + i, djA[ c ] + j ), fracX - diA[ c ], fracY - djA[ c ] );
 						}
 					}
 
@@ -152,15 +176,15 @@ namespace noise2
 				{
 					typename M::Vector4F	noiseV = M::constZeroF();
 					
-					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
 					{
-						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
 
 						typename M::Vector4F	xV = M::loadFromMemory( inputX );
 						typename M::Vector4F	yV = M::loadFromMemory( inputY );
 
-						xV = M::divide( xV, M::vectorizeOne( widget.kernelRadius ) );
-						yV = M::divide( yV, M::vectorizeOne( widget.kernelRadius ) );
+						xV = M::divide( xV, M::vectorizeOne( group.kernelRadius ) );
+						yV = M::divide( yV, M::vectorizeOne( group.kernelRadius ) );
 						
 						typename M::Vector4F	intXV = M::floor( xV );
 						typename M::Vector4F	intYV = M::floor( yV );
@@ -196,9 +220,16 @@ namespace noise2
 							typename M::Vector4I	djjV = M::add( djV, jV );
 							typename M::Vector4F	fxV = M::subtract( fracXV, M::intToFloat( diV ) );
 							typename M::Vector4F	fyV = M::subtract( fracYV, M::intToFloat( djV ) );
-							typename M::Vector4I	mortonV = mortonVectorized( widget, diiV, djjV );
+							typename M::Vector4I	mortonV = mortonVectorized( diiV, djjV );
 							
-							noiseV = M::add( noiseV, cell4Vectorized( widget, mortonV, fxV, fyV ) );
+							if( this->impulseCacheEnabled == true )
+							{
+								noiseV = M::add( noiseV, cell4Cached( group, mortonV, fxV, fyV ) );
+							}
+							else
+							{
+								noiseV = M::add( noiseV, cell4Vectorized( group, mortonV, fxV, fyV ) );
+							}
 						}
 					}
 
@@ -206,222 +237,354 @@ namespace noise2
 					M::storeToMemory( output, noiseV );
 				}
 
+				// Evaluates count arbitrary samples. Samples are grouped by cell so that the impulses
+				// of every cell are generated only once and applied to all samples they reach.
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					BinsType								bins;
+					typename CacheType::CellImpulses		impulses;
+
+					for( size_t s = 0; s < count; ++s )
+					{
+						output[ s ] = ValueType( 0.0 );
+					}
+
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
+					{
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
+
+						bins.build( inputX, inputY, count, group.kernelRadius );
+
+						for( size_t c = 0; c < bins.sourceCells.size(); ++c )
+						{
+							const typename BinsType::Cell&	source = bins.sourceCells[ c ];
+							const typename BinsType::Bin*	targets[ 9 ];
+
+							for( int32 t = 0; t < 9; ++t )
+							{
+								targets[ t ] = bins.find( source.i + (t / 3) - 1, source.j + (t % 3) - 1 );
+							}
+
+							uint32	m = morton( source.i, source.j );
+
+							for( uint32 k = 0; k < group.size(); ++k )
+							{
+								const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+								CacheType::generate( impulses, widget, BaseType::cellSeed( m, group.seeds[ k ] ) );
+
+								if( impulses.count == 0 )
+								{
+									continue;
+								}
+
+								for( int32 t = 0; t < 9; ++t )
+								{
+									if( targets[ t ] != 0 )
+									{
+										binVectorized( group, widget, impulses, bins, *targets[ t ], ValueType( (t / 3) - 1 ), ValueType( (t % 3) - 1 ) );
+									}
+								}
+							}
+						}
+
+						bins.scatter( output );
+					}
+
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+
+					for( size_t s = 0; s < count; ++s )
+					{
+						output[ s ] *= scale;
+					}
+				}
+
+				// Evaluates a width x height grid starting at origin, output is stored row by row
+				void
+				GetValueGrid( ValueType originX, ValueType originY, ValueType stepX, ValueType stepY,
+							  size_t width, size_t height, ValueType* output ) const
+				{
+					size_t	rowsPerStrip = LIBNOISE2_GABOR_GRID_STRIP_SAMPLES / (width > 0 ? width : 1);
+
+					if( rowsPerStrip == 0 )
+					{
+						rowsPerStrip = 1;
+					}
+
+					std::vector< ValueType >	stripX;
+					std::vector< ValueType >	stripY;
+
+					for( size_t row = 0; row < height; row += rowsPerStrip )
+					{
+						size_t	rows = height - row < rowsPerStrip ? height - row : rowsPerStrip;
+
+						stripX.resize( rows * width );
+						stripY.resize( rows * width );
+
+						for( size_t r = 0; r < rows; ++r )
+						{
+							for( size_t c = 0; c < width; ++c )
+							{
+								stripX[ (r * width) + c ] = originX + (ValueType( c ) * stepX);
+								stripY[ (r * width) + c ] = originY + (ValueType( row + r ) * stepY);
+							}
+						}
+
+						if( rows * width > 0 )
+						{
+							GetValueArray( &stripX[ 0 ], &stripY[ 0 ], output + (row * width), rows * width );
+						}
+					}
+				}
+
+				// Same as GetValueGrid, but impulses are convolved with the kernel on the grid in the
+				// frequency domain, see GaborBase::valueGridSpectral. Falls back to GetValueGrid
+				// unless all widgets have fixed frequency and orientation.
+				void
+				GetValueGridSpectral( ValueType originX, ValueType originY, ValueType stepX, ValueType stepY,
+									  size_t width, size_t height, ValueType* output ) const
+				{
+					if( this->valueGridSpectral( originX, originY, stepX, stepY, width, height, output ) == false )
+					{
+						GetValueGrid( originX, originY, stepX, stepY, width, height, output );
+					}
+				}
+
 
 
 			private:
 
+				// One cell of one sample with scalar impulse draws, impulses of all group members share the batches
 				inline
 				ValueType
-				cell( const typename BaseType::PreparedWidget& widget, uint32 s, ValueType x, ValueType y ) const
+				cell( const typename BaseType::WidgetGroup& group, uint32 m, ValueType x, ValueType y ) const
 				{
 					ValueType		noise = ValueType( 0.0 );
 
-					PrngType	prng( s );
-					ValueType	numberOfImpulsesPerCell = widget.impulseDensity * widget.kernelRadius * widget.kernelRadius;
-					uint32		numberOfImpulses = prng.poisson( numberOfImpulsesPerCell );
-
 					uint32		toCalculate = 0;
 					VECTOR4_ALIGN( ValueType	xInputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
 					VECTOR4_ALIGN( ValueType	yInputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
 					VECTOR4_ALIGN( ValueType	wiInputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
-					VECTOR4_ALIGN( ValueType	F0InputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
-					VECTOR4_ALIGN( ValueType	omega0InputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
+					VECTOR4_ALIGN( ValueType	carrier0InputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
+					VECTOR4_ALIGN( ValueType	carrier1InputA[ 4 ] ) = { 0.0f, 0.0f, 0.0f, 0.0f };
 
-
-					for( uint32 i = 0; i < numberOfImpulses; ++i )
+					for( uint32 k = 0; k < group.size(); ++k )
 					{
-						ValueType	xi = prng.uniformNormalized();
-						ValueType	yi = prng.uniformNormalized();
-						ValueType	wi = prng.uniformRangeMinusOneToOne();
-						ValueType	F0 = prng.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
-						ValueType	omega0 = prng.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
-						ValueType	xix = x - xi;
-						ValueType	yiy = y - yi;
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+						PrngType	prng( BaseType::cellSeed( m, group.seeds[ k ] ) );
+						uint32		numberOfImpulses = prng.poisson( widget.impulseCountTable );
 
-						if( ((xix * xix) + (yiy * yiy)) < ValueType( 1.0 ) )
+						for( uint32 i = 0; i < numberOfImpulses; ++i )
 						{
-							xInputA[ toCalculate ] = xix * widget.kernelRadius;
-							yInputA[ toCalculate ] = yiy * widget.kernelRadius;
-							wiInputA[ toCalculate ] = wi;
-							F0InputA[ toCalculate ] = F0;
-							omega0InputA[ toCalculate ] = omega0;
-							++toCalculate;
+							ValueType	xi = prng.uniformNormalized();
+							ValueType	yi = prng.uniformNormalized();
+							ValueType	wi = prng.uniformRangeMinusOneToOne();
+							ValueType	F0;
+							ValueType	omega0;
+							widget.nextImpulseParameters( prng, F0, omega0 );
+							ValueType	xix = x - xi;
+							ValueType	yiy = y - yi;
+
+							if( ((xix * xix) + (yiy * yiy)) < ValueType( 1.0 ) )
+							{
+								xInputA[ toCalculate ] = xix * group.kernelRadius;
+								yInputA[ toCalculate ] = yiy * group.kernelRadius;
+								wiInputA[ toCalculate ] = wi * widget.K;
+								carrier( group, widget, F0, omega0, carrier0InputA[ toCalculate ], carrier1InputA[ toCalculate ] );
+								++toCalculate;
+							}
+
+							if( toCalculate == 4 )
+							{
+								noise += cellPartScalar( group, xInputA, yInputA, wiInputA, carrier0InputA, carrier1InputA, toCalculate );
+								toCalculate = 0;
+							}
 						}
+					}
 
-						if( toCalculate == 4 ||
-							(i == numberOfImpulses - 1 && toCalculate > 0) )
-						{
-							typename M::Vector4F		xInputV = M::loadFromMemory( xInputA );
-							typename M::Vector4F		yInputV = M::loadFromMemory( yInputA );
-							typename M::Vector4F		kV = M::vectorizeOne( widget.K );
-							typename M::Vector4F		aV = M::vectorizeOne( widget.a );
-							typename M::Vector4F		F0V = M::loadFromMemory( F0InputA );
-							typename M::Vector4F		omega0V = M::loadFromMemory( omega0InputA );
-							typename M::Vector4F		wiV = M::loadFromMemory( wiInputA );
+					if( toCalculate > 0 )
+					{
+						noise += cellPartScalar( group, xInputA, yInputA, wiInputA, carrier0InputA, carrier1InputA, toCalculate );
+					}
+
+					return noise;
+				}
 
-							typename M::Vector4F		gaborV = gaborVectorized( kV, aV, F0V, omega0V, xInputV, yInputV );
-							gaborV = M::multiply( wiV, gaborV );
+				inline
+				ValueType
+				cellPartScalar( const typename BaseType::WidgetGroup& group,
+								const ValueType* xInputA, const ValueType* yInputA, const ValueType* wiInputA,
+								const ValueType* carrier0InputA, const ValueType* carrier1InputA, uint32 toCalculate ) const
+				{
+					typename M::Vector4F		xInputV = M::loadFromMemory( xInputA );
+					typename M::Vector4F		yInputV = M::loadFromMemory( yInputA );
+					typename M::Vector4F		carrier0V = M::loadFromMemory( carrier0InputA );
+					typename M::Vector4F		carrier1V = M::loadFromMemory( carrier1InputA );
+					typename M::Vector4F		wiV = M::loadFromMemory( wiInputA );
 
-							VECTOR4_ALIGN( ValueType	gaborResult[ 4 ] );
-							M::storeToMemory( gaborResult, gaborV );
+					LIBNOISE2_GABOR_COUNT_KERNEL( toCalculate );
 
-							for( uint32 j = 0; j < toCalculate; ++j )
-							{
-								noise += gaborResult[ j ];
-							}
+					typename M::Vector4F		gaborV = gaborVectorized( group, carrier0V, carrier1V, xInputV, yInputV );
+					gaborV = M::multiply( wiV, gaborV );
 
-							toCalculate = 0;
-						}
+					VECTOR4_ALIGN( ValueType	gaborResult[ 4 ] );
+					M::storeToMemory( gaborResult, gaborV );
+
+					ValueType	noise = ValueType( 0.0 );
+
+					for( uint32 j = 0; j < toCalculate; ++j )
+					{
+						noise += gaborResult[ j ];
 					}
 
 					return noise;
 				}
 
+				// Collects impulses which passed the radius test into full four lane batches,
+				// so that the kernel is evaluated with as few empty lanes as possible
 				struct
-				Compacter
+				Batcher
 				{
 
-					typename M::Vector4F	xInputVPrev;
-					typename M::Vector4F	yInputVPrev;
-					typename M::Vector4F	wiVPrev;
-					typename M::Vector4F	F0VPrev;
-					typename M::Vector4F	omega0VPrev;
-					typename M::Vector4I	calcMaskVPrev;
+					VECTOR4_ALIGN( typename M::ScalarF	xInputA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	yInputA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	wiA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	carrier0A[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	carrier1A[ 8 ] );
+					uint32								count;
 
 					inline
-					Compacter():
-					  xInputVPrev( M::constZeroF() ),
-					  yInputVPrev( M::constZeroF() ),
-					  wiVPrev( M::constZeroF() ),
-					  F0VPrev( M::constZeroF() ),
-					  omega0VPrev( M::constZeroF() ),
-					  calcMaskVPrev( M::constZeroI() )
+					Batcher():
+					  count( 0 )
 					{
+						for( uint32 i = 0; i < 8; ++i )
+						{
+							xInputA[ i ] = ValueType( 0.0 );
+							yInputA[ i ] = ValueType( 0.0 );
+							wiA[ i ] = ValueType( 0.0 );
+							carrier0A[ i ] = ValueType( 0.0 );
+							carrier1A[ i ] = ValueType( 0.0 );
+						}
 					}
 
+					// Appends the lanes set in calcMaskV, returns true once a full batch is available
 					inline
 					bool
-					compact( typename M::Vector4F& xInputVNext,
-							 typename M::Vector4F& yInputVNext,
-							 typename M::Vector4F& wiVNext,
-							 typename M::Vector4F& F0VNext,
-							 typename M::Vector4F& omega0VNext,
-							 typename M::Vector4I& calcMaskVNext )
-					{
-						if( M::isAllZeros( calcMaskVNext ) == true )
+					push( const typename M::Vector4F& xInputV,
+						  const typename M::Vector4F& yInputV,
+						  const typename M::Vector4F& wiV,
+						  const typename M::Vector4F& carrier0V,
+						  const typename M::Vector4F& carrier1V,
+						  const typename M::Vector4I& calcMaskV )
+					{
+						int32	mask = M::moveMask( calcMaskV );
+
+						if( mask == 0 )
 						{
 							return false;
 						}
 
-						xInputVPrev = M::shiftRightLoop( xInputVPrev, 1 );
-						yInputVPrev = M::shiftRightLoop( yInputVPrev, 1 );
-						wiVPrev = M::shiftRightLoop( wiVPrev, 1 );
-						F0VPrev = M::shiftRightLoop( F0VPrev, 1 );
-						omega0VPrev = M::shiftRightLoop( omega0VPrev, 1 );
-						calcMaskVPrev = M::shiftRightLoop( calcMaskVPrev, 1 );
-
-						typename M::Vector4I	compactMaskV = M::bitXor( calcMaskVPrev, M::bitOr( calcMaskVPrev, calcMaskVNext ) );
-						typename M::Vector4I	keepMaskV = M::bitAnd( calcMaskVPrev, calcMaskVNext );
-						bool	calculate = !M::isAllZeros( keepMaskV );
-						
-						xInputVNext = compactOne( compactMaskV, keepMaskV, xInputVPrev, xInputVNext, calculate );
-						yInputVNext = compactOne( compactMaskV, keepMaskV, yInputVPrev, yInputVNext, calculate );
-						wiVNext = compactOne( compactMaskV, keepMaskV, wiVPrev, wiVNext, calculate );
-						F0VNext = compactOne( compactMaskV, keepMaskV, F0VPrev, F0VNext, calculate );
-						omega0VNext = compactOne( compactMaskV, keepMaskV, omega0VPrev, omega0VNext, calculate );
-
-						if( calculate == false )
-						{
-							calcMaskVPrev = M::bitOr( calcMaskVPrev, calcMaskVNext );
-						}
-						else
-						{
-							calcMaskVNext = M::bitOr( calcMaskVPrev, calcMaskVNext );
-							calcMaskVPrev = keepMaskV;
-						}
+						M::storeToMemoryUnaligned( xInputA + count, M::compact( xInputV, mask ) );
+						M::storeToMemoryUnaligned( yInputA + count, M::compact( yInputV, mask ) );
+						M::storeToMemoryUnaligned( wiA + count, M::compact( wiV, mask ) );
+						M::storeToMemoryUnaligned( carrier0A + count, M::compact( carrier0V, mask ) );
+						M::storeToMemoryUnaligned( carrier1A + count, M::compact( carrier1V, mask ) );
+						count += M::maskLaneCount( mask );
 
-						return calculate;
+						return count >= 4;
 					}
 
-
-
-				private:
-
+					// Evaluates the first batch, or the remaining partial batch when flushing
 					inline
 					typename M::Vector4F
-					compactOne( const typename M::Vector4I& compactMaskV, const typename M::Vector4I& keepMaskV,
-								typename M::Vector4F& vPrev, const typename M::Vector4F& vNext, bool calculate )
+					pop( const ThisType& gabor, const typename BaseType::WidgetGroup& group )
 					{
-						typename M::Vector4F	compactV = M::blend( vPrev, vNext, compactMaskV );
-						typename M::Vector4F	keepV = M::select( vNext, keepMaskV );
-						
-						if( calculate == false )
+						static VECTOR4_ALIGN( int32		laneA[ 4 ] ) = { 0, 1, 2, 3 };
+
+						typename M::Vector4I	calcMaskV = M::greaterThan( M::vectorizeOne( int32( count ) ), M::loadFromMemory( laneA ) );
+						typename M::Vector4F	noiseV = gabor.cellPart( group,
+																		 M::loadFromMemory( xInputA ),
+																		 M::loadFromMemory( yInputA ),
+																		 M::loadFromMemory( wiA ),
+																		 M::loadFromMemory( carrier0A ),
+																		 M::loadFromMemory( carrier1A ),
+																		 calcMaskV );
+
+						if( count > 4 )
 						{
-							vPrev = compactV;
-							return keepV;
+							M::storeToMemory( xInputA, M::loadFromMemory( xInputA + 4 ) );
+							M::storeToMemory( yInputA, M::loadFromMemory( yInputA + 4 ) );
+							M::storeToMemory( wiA, M::loadFromMemory( wiA + 4 ) );
+							M::storeToMemory( carrier0A, M::loadFromMemory( carrier0A + 4 ) );
+							M::storeToMemory( carrier1A, M::loadFromMemory( carrier1A + 4 ) );
+							count -= 4;
 						}
 						else
 						{
-							vPrev = keepV;
-							return compactV;
+							count = 0;
 						}
+
+						return noiseV;
 					}
 
 				};
 
+				// Four cells of one sample, impulses of all group members share the batches
 				inline
 				ValueType
-				cellVectorized( const typename BaseType::PreparedWidget& widget, const typename M::Vector4I sV, const typename M::Vector4F xV, const typename M::Vector4F yV ) const
+				cellVectorized( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV, const typename M::Vector4F xV, const typename M::Vector4F yV ) const
 				{
-					Compacter	compacter;
+					Batcher		batcher;
 
-					PrngVectorType			prngVector( sV );
-					typename M::Vector4F	impulseDensityV = M::vectorizeOne( widget.impulseDensity );
-					typename M::Vector4F	kernelRadiusV = M::vectorizeOne( widget.kernelRadius );
-					typename M::Vector4F	numberOfImpulsesPerCellV = M::multiply( impulseDensityV, M::multiply( kernelRadiusV, kernelRadiusV ) );
-					typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( numberOfImpulsesPerCellV );
-
-					VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
-					M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
-
-					uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
 					typename M::Vector4I	oneIV = M::constOneI();
 					typename M::Vector4F	oneFV = M::constOneF();
-
 					typename M::Vector4F	noiseV = M::constZeroF();
-					for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
-					{
-						typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
-						typename M::Vector4F	xiV = prngVector.uniformNormalized();
-						typename M::Vector4F	yiV = prngVector.uniformNormalized();
-						typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
-						typename M::Vector4F	F0V = prngVector.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
-						typename M::Vector4F	omega0V = prngVector.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
-						typename M::Vector4F	xInputV = M::subtract( xV, xiV );
-						typename M::Vector4F	yInputV = M::subtract( yV, yiV );
-
-						typename M::Vector4F	radiusXV = M::multiply( xInputV, xInputV );
-						typename M::Vector4F	radiusYV = M::multiply( yInputV, yInputV );
-						typename M::Vector4F	radiusV = M::add( radiusXV, radiusYV );
-						typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
-						typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
-
-						if( compacter.compact( xInputV, yInputV, wiV, F0V, omega0V, calcMaskV ) == true )
-						{
-							noiseV = M::add( noiseV, cellPart( widget, xInputV, yInputV, wiV, F0V, omega0V, calcMaskV ) );
-						}
-						if( i == maxNumberOfImpulses - 1 )
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+						PrngVectorType			prngVector( cellSeedVectorized( mV, group.seeds[ k ] ) );
+						typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( widget.impulseCountTable );
+						typename M::Vector4F	kV = M::vectorizeOne( widget.K );
+
+						VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
+						M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
+
+						uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
+
+						for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
 						{
-							noiseV = M::add( noiseV, cellPart( widget,
-															   compacter.xInputVPrev,
-															   compacter.yInputVPrev,
-															   compacter.wiVPrev,
-															   compacter.F0VPrev,
-															   compacter.omega0VPrev,
-															   compacter.calcMaskVPrev ) );
+							typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
+							typename M::Vector4F	xiV = prngVector.uniformNormalized();
+							typename M::Vector4F	yiV = prngVector.uniformNormalized();
+							typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							nextCarrierVectorized( group, widget, prngVector, carrier0V, carrier1V );
+							typename M::Vector4F	xInputV = M::subtract( xV, xiV );
+							typename M::Vector4F	yInputV = M::subtract( yV, yiV );
+
+							typename M::Vector4F	radiusXV = M::multiply( xInputV, xInputV );
+							typename M::Vector4F	radiusYV = M::multiply( yInputV, yInputV );
+							typename M::Vector4F	radiusV = M::add( radiusXV, radiusYV );
+							typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
+							typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
+
+							if( batcher.push( xInputV, yInputV, M::multiply( wiV, kV ), carrier0V, carrier1V, calcMaskV ) == true )
+							{
+								noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+							}
+
+							numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
 						}
+					}
 
-						numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
+					if( batcher.count > 0 )
+					{
+						noiseV = M::add( noiseV, batcher.pop( *this, group ) );
 					}
 
 					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
@@ -438,98 +601,203 @@ namespace noise2
 
 				inline
 				typename M::Vector4F
-				cell4Vectorized( const typename BaseType::PreparedWidget& widget, const typename M::Vector4I sV, const typename M::Vector4F xV, const typename M::Vector4F yV ) const
+				cell4Vectorized( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV, const typename M::Vector4F xV, const typename M::Vector4F yV ) const
 				{
-					PrngVectorType			prngVector( sV );
-					typename M::Vector4F	impulseDensityV = M::vectorizeOne( widget.impulseDensity );
-					typename M::Vector4F	kernelRadiusV = M::vectorizeOne( widget.kernelRadius );
-					typename M::Vector4F	numberOfImpulsesPerCellV = M::multiply( impulseDensityV, M::multiply( kernelRadiusV, kernelRadiusV ) );
-					typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( numberOfImpulsesPerCellV );
+					typename M::Vector4I	oneIV = M::constOneI();
+					typename M::Vector4F	oneFV = M::constOneF();
+					typename M::Vector4F	noiseV = M::constZeroF();
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
 
-					VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
-					M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
+						PrngVectorType			prngVector( cellSeedVectorized( mV, group.seeds[ k ] ) );
+						typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( widget.impulseCountTable );
+						typename M::Vector4F	kV = M::vectorizeOne( widget.K );
 
-					uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
-					typename M::Vector4I	oneIV = M::constOneI();
+						VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
+						M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
+
+						uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
+
+						for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
+						{
+							typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
+							typename M::Vector4F	xiV = prngVector.uniformNormalized();
+							typename M::Vector4F	yiV = prngVector.uniformNormalized();
+							typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							nextCarrierVectorized( group, widget, prngVector, carrier0V, carrier1V );
+							typename M::Vector4F	xInputV = M::subtract( xV, xiV );
+							typename M::Vector4F	yInputV = M::subtract( yV, yiV );
+
+							typename M::Vector4F	radiusXV = M::multiply( xInputV, xInputV );
+							typename M::Vector4F	radiusYV = M::multiply( yInputV, yInputV );
+							typename M::Vector4F	radiusV = M::add( radiusXV, radiusYV );
+							typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
+							typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
+
+							if( M::isAllZeros( calcMaskV ) == false )
+							{
+								noiseV = M::add( noiseV, cellPart( group, xInputV, yInputV, M::multiply( wiV, kV ), carrier0V, carrier1V, calcMaskV ) );
+							}
+
+							numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
+						}
+					}
+
+					return noiseV;
+				}
+
+				inline
+				ValueType
+				cellCached( const typename BaseType::WidgetGroup& group, CacheType& cache, uint32 m, ValueType x, ValueType y ) const
+				{
+					typename M::Vector4F	xV = M::vectorizeOne( x );
+					typename M::Vector4F	yV = M::vectorizeOne( y );
 					typename M::Vector4F	oneFV = M::constOneF();
+					Batcher					batcher;
 
 					typename M::Vector4F	noiseV = M::constZeroF();
-					for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
-					{
-						typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
-						typename M::Vector4F	xiV = prngVector.uniformNormalized();
-						typename M::Vector4F	yiV = prngVector.uniformNormalized();
-						typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
-						typename M::Vector4F	F0V = prngVector.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
-						typename M::Vector4F	omega0V = prngVector.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
-						typename M::Vector4F	xInputV = M::subtract( xV, xiV );
-						typename M::Vector4F	yInputV = M::subtract( yV, yiV );
-
-						typename M::Vector4F	radiusXV = M::multiply( xInputV, xInputV );
-						typename M::Vector4F	radiusYV = M::multiply( yInputV, yInputV );
-						typename M::Vector4F	radiusV = M::add( radiusXV, radiusYV );
-						typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
-						typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
-
-						if( M::isAllZeros( calcMaskV ) == false )
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+						const typename CacheType::CellImpulses&		impulses = cache.lookup( widget, BaseType::cellSeed( m, group.seeds[ k ] ) );
+						typename M::Vector4F						kV = M::vectorizeOne( widget.K );
+
+						for( uint32 i = 0; i < impulses.paddedCount; i += 4 )
 						{
-							noiseV = M::add( noiseV, cellPart( widget, xInputV, yInputV, wiV, F0V, omega0V, calcMaskV ) );
+							typename M::Vector4F	xInputV = M::subtract( xV, M::loadFromMemory( impulses.xi + i ) );
+							typename M::Vector4F	yInputV = M::subtract( yV, M::loadFromMemory( impulses.yi + i ) );
+
+							typename M::Vector4F	radiusV = M::add( M::multiply( xInputV, xInputV ), M::multiply( yInputV, yInputV ) );
+							typename M::Vector4I	calcMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							carrierVectorized( group, widget, M::loadFromMemory( impulses.F0 + i ), M::loadFromMemory( impulses.omega0 + i ), carrier0V, carrier1V );
+
+							if( batcher.push( xInputV, yInputV,
+											  M::multiply( M::loadFromMemory( impulses.wi + i ), kV ),
+											  carrier0V,
+											  carrier1V,
+											  calcMaskV ) == true )
+							{
+								noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+							}
 						}
+					}
 
-						numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
+					if( batcher.count > 0 )
+					{
+						noiseV = M::add( noiseV, batcher.pop( *this, group ) );
 					}
 
-					return noiseV;
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( noiseA, noiseV );
+
+					return noiseA[ 0 ] + noiseA[ 1 ] + noiseA[ 2 ] + noiseA[ 3 ];
 				}
 
 				inline
 				typename M::Vector4F
-				cellPart( const typename BaseType::PreparedWidget& widget,
-						  const typename M::Vector4F& xInputV, const typename M::Vector4F& yInputV,
-						  const typename M::Vector4F& wiV, const typename M::Vector4F& F0V,
-						  const typename M::Vector4F& omega0V, const typename M::Vector4I& calcMaskV ) const
+				cell4Cached( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV, const typename M::Vector4F xV, const typename M::Vector4F yV ) const
 				{
-					typename M::Vector4F	kernelRadiusV = M::vectorizeOne( widget.kernelRadius );
-					typename M::Vector4F	xV = M::multiply( xInputV, kernelRadiusV );
-					typename M::Vector4F	yV = M::multiply( yInputV, kernelRadiusV );
-					typename M::Vector4F	kV = M::vectorizeOne( widget.K );
-					typename M::Vector4F	aV = M::vectorizeOne( widget.a );
+					CacheType&	cache = CacheType::forCurrentThread();
 
-					typename M::Vector4F	gaborV = gaborVectorized( kV, aV, F0V, omega0V, xV, yV );
-					gaborV = M::multiply( wiV, gaborV );
-					gaborV = M::select( gaborV, calcMaskV );
+					VECTOR4_ALIGN( uint32					mA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		xA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		yA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( mA, mV );
+					M::storeToMemory( xA, xV );
+					M::storeToMemory( yA, yV );
 
-					return gaborV;
+					for( uint32 l = 0; l < 4; ++l )
+					{
+						noiseA[ l ] = cellCached( group, cache, mA[ l ], xA[ l ], yA[ l ] );
+					}
+
+					return M::loadFromMemory( noiseA );
 				}
 
+				// Adds the impulses of one cell to all samples of bin, (dx, dy) is the offset
+				// of the bin cell from the impulse cell
 				inline
-				uint32
-				morton( const typename BaseType::PreparedWidget& widget, uint32 x, uint32 y ) const
+				void
+				binVectorized( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget, const typename CacheType::CellImpulses& impulses,
+							   BinsType& bins, const typename BinsType::Bin& bin, ValueType dx, ValueType dy ) const
 				{
-					uint32	z = 0;
+					typename M::Vector4F	dxV = M::vectorizeOne( dx );
+					typename M::Vector4F	dyV = M::vectorizeOne( dy );
+					typename M::Vector4F	oneFV = M::constOneF();
 
-					for( uint32 i = 0; i < (sizeof( uint32 ) * CHAR_BIT); ++i )
+					for( uint32 b = bin.begin; b < bin.end; b += 4 )
 					{
-						z |= ((x & (1 << i)) << i) | ((y & (1 << i)) << (i + 1));
-					}
+						typename M::Vector4F	xV = M::add( M::loadFromMemory( bins.x.data() + b ), dxV );
+						typename M::Vector4F	yV = M::add( M::loadFromMemory( bins.y.data() + b ), dyV );
+						typename M::Vector4F	noiseV = M::loadFromMemory( bins.accumulated.data() + b );
+
+						for( uint32 i = 0; i < impulses.count; ++i )
+						{
+							typename M::Vector4F	xInputV = M::subtract( xV, M::vectorizeOne( impulses.xi[ i ] ) );
+							typename M::Vector4F	yInputV = M::subtract( yV, M::vectorizeOne( impulses.yi[ i ] ) );
 
-					z += widget.seed;
+							typename M::Vector4F	radiusV = M::add( M::multiply( xInputV, xInputV ), M::multiply( yInputV, yInputV ) );
+							typename M::Vector4I	calcMaskV = M::castToInt( M::lowerThan( radiusV, oneFV ) );
 
-					if( z == 0 )
-					{
-						z = 1;
+							if( M::isAllZeros( calcMaskV ) == false )
+							{
+								ValueType	carrier0;
+								ValueType	carrier1;
+								carrier( group, widget, impulses.F0[ i ], impulses.omega0[ i ], carrier0, carrier1 );
+
+								noiseV = M::add( noiseV, cellPart( group, xInputV, yInputV,
+																   M::vectorizeOne( impulses.wi[ i ] * widget.K ),
+																   M::vectorizeOne( carrier0 ),
+																   M::vectorizeOne( carrier1 ),
+																   calcMaskV ) );
+							}
+						}
+
+						M::storeToMemory( bins.accumulated.data() + b, noiseV );
 					}
+				}
+
+				// wiV carries the impulse weight already multiplied by K of its widget
+				inline
+				typename M::Vector4F
+				cellPart( const typename BaseType::WidgetGroup& group,
+						  const typename M::Vector4F& xInputV, const typename M::Vector4F& yInputV,
+						  const typename M::Vector4F& wiV, const typename M::Vector4F& carrier0V,
+						  const typename M::Vector4F& carrier1V, const typename M::Vector4I& calcMaskV ) const
+				{
+					typename M::Vector4F	kernelRadiusV = M::vectorizeOne( group.kernelRadius );
+					typename M::Vector4F	xV = M::multiply( xInputV, kernelRadiusV );
+					typename M::Vector4F	yV = M::multiply( yInputV, kernelRadiusV );
+
+					LIBNOISE2_GABOR_COUNT_KERNEL( M::maskLaneCount( M::moveMask( calcMaskV ) ) );
+
+					typename M::Vector4F	gaborV = gaborVectorized( group, carrier0V, carrier1V, xV, yV );
+					gaborV = M::multiply( wiV, gaborV );
+					gaborV = M::select( gaborV, calcMaskV );
 
-					return z;
+					return gaborV;
 				}
 
 				inline
 				typename M::Vector4I
-				mortonVectorized( const typename BaseType::PreparedWidget& widget, const typename M::Vector4I& xV, const typename M::Vector4I& yV ) const
+				mortonVectorized( typename M::Vector4I xV, typename M::Vector4I yV ) const
 				{
+					if( this->periodic == true )
+					{
+						xV = wrapCellVectorized( xV );
+						yV = wrapCellVectorized( yV );
+					}
+
 					typename M::Vector4I		zV = M::constZeroI();
 					typename M::Vector4I		oneV = M::constOneI();
-					typename M::Vector4I		seedV = M::vectorizeOne( widget.seed );
 
 					for( uint32 i = 0; i < (sizeof( uint32 ) * CHAR_BIT); ++i )
 					{
@@ -545,21 +813,122 @@ namespace noise2
 						zV = M::bitOr( zV, tmp );
 					}
 
-					zV = M::add( zV, seedV );
+					return zV;
+				}
+
+				// Vectorized GaborBase::wrapCell for periodic mode, the remainder is taken in floating
+				// point and corrected by one period where the reciprocal rounded the quotient
+				inline
+				typename M::Vector4I
+				wrapCellVectorized( const typename M::Vector4I& cV ) const
+				{
+					typename M::Vector4F		periodV = M::vectorizeOne( ValueType( this->period ) );
+					typename M::Vector4F		cF = M::intToFloat( cV );
+
+					cF = M::subtract( cF, M::multiply( periodV, M::floor( M::multiply( cF, M::vectorizeOne( ValueType( 1.0 ) / ValueType( this->period ) ) ) ) ) );
+					cF = M::subtract( cF, M::select( periodV, M::castToInt( M::equalGreaterThan( cF, periodV ) ) ) );
+					cF = M::add( cF, M::select( periodV, M::castToInt( M::lowerThan( cF, M::constZeroF() ) ) ) );
+
+					return M::floatToIntTruncated( cF );
+				}
+
+				// Vectorized GaborBase::cellSeed
+				inline
+				typename M::Vector4I
+				cellSeedVectorized( const typename M::Vector4I& mV, uint32 widgetSeed ) const
+				{
+					typename M::Vector4I		sV = M::add( mV, M::vectorizeOne( widgetSeed ) );
 
-					typename M::Vector4I		isZero = M::equal( zV, M::constZeroI() );
+					typename M::Vector4I		isZero = M::equal( sV, M::constZeroI() );
 					typename M::Vector4I		toOne = M::shiftRightLogical( isZero, 31 );
-					zV = M::add( zV, toOne );
 
-					return zV;
+					return M::add( sV, toOne );
+				}
+
+				// Vectorized PreparedWidget::nextImpulseParameters
+				inline
+				void
+				nextImpulseParametersVectorized( const typename BaseType::PreparedWidget& widget, PrngVectorType& prngVector,
+												 typename M::Vector4F& F0V, typename M::Vector4F& omega0V ) const
+				{
+					if( widget.fixedFrequency == true )
+					{
+						F0V = M::vectorizeOne( widget.F0 );
+					}
+					else
+					{
+						F0V = prngVector.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
+					}
+
+					if( widget.fixedOrientation == true )
+					{
+						omega0V = M::vectorizeOne( widget.omega0 );
+					}
+					else
+					{
+						omega0V = prngVector.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
+					}
+				}
+
+				// Carrier of impulses as stored in the batches. Groups with fixed orientation keep
+				// 2 * pi * F0 * ( cos( omega0 ), sin( omega0 ) ), other groups keep ( F0, omega0 ).
+				inline
+				void
+				carrierVectorized( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget,
+								   const typename M::Vector4F& F0V, const typename M::Vector4F& omega0V,
+								   typename M::Vector4F& carrier0V, typename M::Vector4F& carrier1V ) const
+				{
+					if( group.fixedOrientation == true )
+					{
+						carrier0V = M::multiply( F0V, M::vectorizeOne( widget.orientationX ) );
+						carrier1V = M::multiply( F0V, M::vectorizeOne( widget.orientationY ) );
+					}
+					else
+					{
+						carrier0V = F0V;
+						carrier1V = omega0V;
+					}
+				}
+
+				inline
+				void
+				nextCarrierVectorized( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget,
+									   PrngVectorType& prngVector, typename M::Vector4F& carrier0V, typename M::Vector4F& carrier1V ) const
+				{
+					typename M::Vector4F	F0V;
+					typename M::Vector4F	omega0V;
+
+					nextImpulseParametersVectorized( widget, prngVector, F0V, omega0V );
+					carrierVectorized( group, widget, F0V, omega0V, carrier0V, carrier1V );
+				}
+
+				// Scalar carrierVectorized
+				inline
+				void
+				carrier( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget,
+						 ValueType F0, ValueType omega0, ValueType& carrier0, ValueType& carrier1 ) const
+				{
+					if( group.fixedOrientation == true )
+					{
+						carrier0 = F0 * widget.orientationX;
+						carrier1 = F0 * widget.orientationY;
+					}
+					else
+					{
+						carrier0 = F0;
+						carrier1 = omega0;
+					}
 				}
 
+				// K is not applied here, it is part of the impulse weights. See carrierVectorized
+				// for the contents of carrier0V and carrier1V.
 				inline
 				typename M::Vector4F
-				gaborVectorized( const typename M::Vector4F& kV, const typename M::Vector4F& aV,
-								 const typename M::Vector4F& f0V, const typename M::Vector4F& omega0V,
+				gaborVectorized( const typename BaseType::WidgetGroup& group,
+								 const typename M::Vector4F& carrier0V, const typename M::Vector4F& carrier1V,
 								 const typename M::Vector4F& xV, const typename M::Vector4F& yV ) const
 				{
+					typename M::Vector4F		aV = M::vectorizeOne( group.a );
 					typename M::Vector4F		piV = M::constMinusPiF();
 					typename M::Vector4F		aa = M::multiply( aV, aV );
 					typename M::Vector4F		xx = M::multiply( xV, xV );
@@ -569,18 +938,727 @@ namespace noise2
 					typename M::Vector4F		gaussianEnvelop =  M::multiply( piV, aa );
 					gaussianEnvelop = M::multiply( gaussianEnvelop, xxyy );
 					gaussianEnvelop = M::exp( gaussianEnvelop );
-					gaussianEnvelop = M::multiply( gaussianEnvelop, kV );
-
-					typename M::Vector4F		sinOmega;
-					typename M::Vector4F		cosOmega;
-					M::sinCos( omega0V, sinOmega, cosOmega );
-					typename M::Vector4F		xCosOmega = M::multiply( xV, cosOmega );
-					typename M::Vector4F		ySinOmega = M::multiply( yV, sinOmega );
-					typename M::Vector4F		xCosYSin = M::add( xCosOmega, ySinOmega );
-					
-					typename M::Vector4F		sinusoidalCarrier = M::multiply( M::constTwoF(), piV );
-					sinusoidalCarrier = M::multiply( sinusoidalCarrier, f0V );
-					sinusoidalCarrier = M::multiply( sinusoidalCarrier, xCosYSin );
+
+					if( group.radial == true )
+					{
+						return gaussianEnvelop;
+					}
+
+					typename M::Vector4F		cxV = carrier0V;
+					typename M::Vector4F		cyV = carrier1V;
+
+					if( group.fixedOrientation == false )
+					{
+						typename M::Vector4F	sinOmega;
+						typename M::Vector4F	cosOmega;
+						M::sinCos( carrier1V, sinOmega, cosOmega );
+
+						typename M::Vector4F	twoPiF0V = M::multiply( M::multiply( M::constTwoF(), M::constPiF() ), carrier0V );
+						cxV = M::multiply( twoPiF0V, cosOmega );
+						cyV = M::multiply( twoPiF0V, sinOmega );
+					}
+
+					typename M::Vector4F		sinusoidalCarrier = M::add( M::multiply( xV, cxV ), M::multiply( yV, cyV ) );
+					sinusoidalCarrier = M::cos( sinusoidalCarrier );
+
+					return M::multiply( gaussianEnvelop, sinusoidalCarrier );
+				}
+
+				inline
+				uint32
+				findMax( uint32* a ) const
+				{
+					uint32	tmp1 = a[ 0 ] > a[ 1 ] ? a[ 0 ] : a[ 1 ];
+					uint32	tmp2 = a[ 2 ] > a[ 3 ] ? a[ 2 ] : a[ 3 ];
+					return tmp1 > tmp2 ? tmp1 : tmp2;
+				}
+
+			};
+
+
+			template< typename ValueT, typename PrecisionT >
+			class GaborImpl< ValueT, 3, 4, PrecisionT >: public Module< ValueT, 3 >, public gabor::GaborBase< ValueT, 3 >
+			{
+
+			public:
+
+				typedef ValueT									ValueType;
+				static const unsigned							Dimension = 3;
+				typedef Module< ValueType, Dimension >			ModuleType;
+				typedef gabor::GaborBase< ValueType, 3 >		BaseType;
+				typedef GaborImpl< ValueType, Dimension, 4, PrecisionT >	ThisType;
+
+
+
+			private:
+				typedef gabor::PrngVector< ValueType >			PrngVectorType;
+				typedef gabor::ImpulseCache< ValueType, 3 >		CacheType;
+				typedef math::MathPrecision< ValueType, PrecisionT >	M;
+
+
+
+			public:
+
+				GaborImpl():
+				  ModuleType( 0 ),
+				  BaseType()
+				{}
+
+				virtual
+				~GaborImpl()
+				{}
+
+				virtual
+				ValueType
+				GetValue( ValueType x, ValueType y, ValueType z ) const
+				{
+					ValueType	noise = ValueType( 0.0 );
+
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
+					{
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
+
+						ValueType	widgetX = x / group.kernelRadius;
+						ValueType	widgetY = y / group.kernelRadius;
+						ValueType	widgetZ = z / group.kernelRadius;
+
+						ValueType	intX = M::floor( widgetX );
+						ValueType	intY = M::floor( widgetY );
+						ValueType	intZ = M::floor( widgetZ );
+						ValueType	fracX = widgetX - intX;
+						ValueType	fracY = widgetY - intY;
+						ValueType	fracZ = widgetZ - intZ;
+						int32		i = int32( intX );
+						int32		j = int32( intY );
+						int32		k = int32( intZ );
+
+						if( this->impulseCacheEnabled == true )
+						{
+							CacheType&	cache = CacheType::forCurrentThread();
+
+							for( int32 di = -1; di <= 1; ++di )
+							{
+								for( int32 dj = -1; dj <= 1; ++dj )
+								{
+									for( int32 dk = -1; dk <= 1; ++dk )
+									{
+										noise += cellCached( group, cache, morton( i + di, j + dj, k + dk ), fracX - di, fracY - dj, fracZ - dk );
+									}
+								}
+							}
+
+							continue;
+						}
+
+						typename M::Vector4F	fracXV = M::vectorizeOne( fracX );
+						typename M::Vector4F	fracYV = M::vectorizeOne( fracY );
+						typename M::Vector4F	fracZV = M::vectorizeOne( fracZ );
+
+						// 27 neighbour cells in seven vectors, the last one has its fourth lane masked out
+						static VECTOR4_ALIGN( int32		diA[ 28 ] ) = { -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0 };
+						static VECTOR4_ALIGN( int32		djA[ 28 ] ) = { -1, -1, -1,  0,  0,  0,  1,  1,  1, -1, -1, -1,  0,  0,  0,  1,  1,  1, -1, -1, -1,  0,  0,  0,  1,  1,  1,  0 };
+						static VECTOR4_ALIGN( int32		dkA[ 28 ] ) = { -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1,  0 };
+						static VECTOR4_ALIGN( uint32	lastCellMaskA[ 4 ] ) = { 0xffffffff, 0xffffffff, 0xffffffff, 0x0 };
+
+						typename M::Vector4I	iV = M::vectorizeOne( i );
+						typename M::Vector4I	jV = M::vectorizeOne( j );
+						typename M::Vector4I	kV = M::vectorizeOne( k );
+
+						for( int32 m = 0; m < 7; ++m )
+						{
+							typename M::Vector4I	diV = M::loadFromMemory( diA + (m * 4) );
+							typename M::Vector4I	djV = M::loadFromMemory( djA + (m * 4) );
+							typename M::Vector4I	dkV = M::loadFromMemory( dkA + (m * 4) );
+							typename M::Vector4F	xV = M::subtract( fracXV, M::intToFloat( diV ) );
+							typename M::Vector4F	yV = M::subtract( fracYV, M::intToFloat( djV ) );
+							typename M::Vector4F	zV = M::subtract( fracZV, M::intToFloat( dkV ) );
+							typename M::Vector4I	mortonV = mortonVectorized( M::add( diV, iV ), M::add( djV, jV ), M::add( dkV, kV ) );
+							typename M::Vector4I	cellMaskV = m < 6 ? M::constFullMaskI() : M::loadFromMemory( lastCellMaskA );
+
+							noise += cellVectorized( group, mortonV, xV, yV, zV, cellMaskV );
+						}
+					}
+
+					return noise / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+				}
+
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+				{
+					typename M::Vector4F	noiseV = M::constZeroF();
+
+					for( size_t g = 0; g < this->widgetGroups.size(); ++g )
+					{
+						const typename BaseType::WidgetGroup&	group = this->widgetGroups[ g ];
+
+						typename M::Vector4F	kernelRadiusV = M::vectorizeOne( group.kernelRadius );
+						typename M::Vector4F	xV = M::divide( M::loadFromMemory( inputX ), kernelRadiusV );
+						typename M::Vector4F	yV = M::divide( M::loadFromMemory( inputY ), kernelRadiusV );
+						typename M::Vector4F	zV = M::divide( M::loadFromMemory( inputZ ), kernelRadiusV );
+
+						typename M::Vector4F	intXV = M::floor( xV );
+						typename M::Vector4F	intYV = M::floor( yV );
+						typename M::Vector4F	intZV = M::floor( zV );
+						typename M::Vector4F	fracXV = M::subtract( xV, intXV );
+						typename M::Vector4F	fracYV = M::subtract( yV, intYV );
+						typename M::Vector4F	fracZV = M::subtract( zV, intZV );
+						typename M::Vector4I	iV = M::floatToIntTruncated( intXV );
+						typename M::Vector4I	jV = M::floatToIntTruncated( intYV );
+						typename M::Vector4I	kV = M::floatToIntTruncated( intZV );
+
+						for( int32 di = -1; di <= 1; ++di )
+						{
+							for( int32 dj = -1; dj <= 1; ++dj )
+							{
+								for( int32 dk = -1; dk <= 1; ++dk )
+								{
+									typename M::Vector4I	diV = M::vectorizeOne( di );
+									typename M::Vector4I	djV = M::vectorizeOne( dj );
+									typename M::Vector4I	dkV = M::vectorizeOne( dk );
+									typename M::Vector4F	fxV = M::subtract( fracXV, M::intToFloat( diV ) );
+									typename M::Vector4F	fyV = M::subtract( fracYV, M::intToFloat( djV ) );
+									typename M::Vector4F	fzV = M::subtract( fracZV, M::intToFloat( dkV ) );
+									typename M::Vector4I	mortonV = mortonVectorized( M::add( diV, iV ), M::add( djV, jV ), M::add( dkV, kV ) );
+
+									if( this->impulseCacheEnabled == true )
+									{
+										noiseV = M::add( noiseV, cell4Cached( group, mortonV, fxV, fyV, fzV ) );
+									}
+									else
+									{
+										noiseV = M::add( noiseV, cell4Vectorized( group, mortonV, fxV, fyV, fzV ) );
+									}
+								}
+							}
+						}
+					}
+
+					noiseV = M::divide( noiseV, M::vectorizeOne( ValueType( 3.0 ) * std::sqrt( this->combinedVariance ) ) );
+					M::storeToMemory( output, noiseV );
+				}
+
+
+
+			private:
+
+				// Collects impulses which passed the radius test into full four lane batches
+				struct
+				Batcher
+				{
+
+					VECTOR4_ALIGN( typename M::ScalarF	xInputA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	yInputA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	zInputA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	wiA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	carrier0A[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	carrier1A[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	carrier2A[ 8 ] );
+					uint32								count;
+
+					inline
+					Batcher():
+					  count( 0 )
+					{
+						for( uint32 i = 0; i < 8; ++i )
+						{
+							xInputA[ i ] = ValueType( 0.0 );
+							yInputA[ i ] = ValueType( 0.0 );
+							zInputA[ i ] = ValueType( 0.0 );
+							wiA[ i ] = ValueType( 0.0 );
+							carrier0A[ i ] = ValueType( 0.0 );
+							carrier1A[ i ] = ValueType( 0.0 );
+							carrier2A[ i ] = ValueType( 0.0 );
+						}
+					}
+
+					// Appends the lanes set in calcMaskV, returns true once a full batch is available
+					inline
+					bool
+					push( const typename M::Vector4F& xInputV,
+						  const typename M::Vector4F& yInputV,
+						  const typename M::Vector4F& zInputV,
+						  const typename M::Vector4F& wiV,
+						  const typename M::Vector4F& carrier0V,
+						  const typename M::Vector4F& carrier1V,
+						  const typename M::Vector4F& carrier2V,
+						  const typename M::Vector4I& calcMaskV )
+					{
+						int32	mask = M::moveMask( calcMaskV );
+
+						if( mask == 0 )
+						{
+							return false;
+						}
+
+						M::storeToMemoryUnaligned( xInputA + count, M::compact( xInputV, mask ) );
+						M::storeToMemoryUnaligned( yInputA + count, M::compact( yInputV, mask ) );
+						M::storeToMemoryUnaligned( zInputA + count, M::compact( zInputV, mask ) );
+						M::storeToMemoryUnaligned( wiA + count, M::compact( wiV, mask ) );
+						M::storeToMemoryUnaligned( carrier0A + count, M::compact( carrier0V, mask ) );
+						M::storeToMemoryUnaligned( carrier1A + count, M::compact( carrier1V, mask ) );
+						M::storeToMemoryUnaligned( carrier2A + count, M::compact( carrier2V, mask ) );
+						count += M::maskLaneCount( mask );
+
+						return count >= 4;
+					}
+
+					// Evaluates the first batch, or the remaining partial batch when flushing
+					inline
+					typename M::Vector4F
+					pop( const ThisType& gabor, const typename BaseType::WidgetGroup& group )
+					{
+						static VECTOR4_ALIGN( int32		laneA[ 4 ] ) = { 0, 1, 2, 3 };
+
+						typename M::Vector4I	calcMaskV = M::greaterThan( M::vectorizeOne( int32( count ) ), M::loadFromMemory( laneA ) );
+						typename M::Vector4F	noiseV = gabor.cellPart( group,
+																		 M::loadFromMemory( xInputA ),
+																		 M::loadFromMemory( yInputA ),
+																		 M::loadFromMemory( zInputA ),
+																		 M::loadFromMemory( wiA ),
+																		 M::loadFromMemory( carrier0A ),
+																		 M::loadFromMemory( carrier1A ),
+																		 M::loadFromMemory( carrier2A ),
+																		 calcMaskV );
+
+						if( count > 4 )
+						{
+							M::storeToMemory( xInputA, M::loadFromMemory( xInputA + 4 ) );
+							M::storeToMemory( yInputA, M::loadFromMemory( yInputA + 4 ) );
+							M::storeToMemory( zInputA, M::loadFromMemory( zInputA + 4 ) );
+							M::storeToMemory( wiA, M::loadFromMemory( wiA + 4 ) );
+							M::storeToMemory( carrier0A, M::loadFromMemory( carrier0A + 4 ) );
+							M::storeToMemory( carrier1A, M::loadFromMemory( carrier1A + 4 ) );
+							M::storeToMemory( carrier2A, M::loadFromMemory( carrier2A + 4 ) );
+							count -= 4;
+						}
+						else
+						{
+							count = 0;
+						}
+
+						return noiseV;
+					}
+
+				};
+
+				// Four cells of one sample, lanes cleared in cellMaskV do not contribute. Impulses
+				// of all group members share the batches.
+				inline
+				ValueType
+				cellVectorized( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV,
+								const typename M::Vector4F xV, const typename M::Vector4F yV, const typename M::Vector4F zV,
+								const typename M::Vector4I cellMaskV ) const
+				{
+					Batcher		batcher;
+
+					typename M::Vector4I	oneIV = M::constOneI();
+					typename M::Vector4F	oneFV = M::constOneF();
+					typename M::Vector4F	noiseV = M::constZeroF();
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+						PrngVectorType			prngVector( cellSeedVectorized( mV, group.seeds[ k ] ) );
+						typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( widget.impulseCountTable );
+						numberOfImpulsesV = M::bitAnd( numberOfImpulsesV, cellMaskV );
+						typename M::Vector4F	kV = M::vectorizeOne( widget.K );
+
+						VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
+						M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
+
+						uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
+
+						for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
+						{
+							typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
+							typename M::Vector4F	xiV = prngVector.uniformNormalized();
+							typename M::Vector4F	yiV = prngVector.uniformNormalized();
+							typename M::Vector4F	ziV = prngVector.uniformNormalized();
+							typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							typename M::Vector4F	carrier2V;
+							nextCarrierVectorized( group, widget, prngVector, carrier0V, carrier1V, carrier2V );
+							typename M::Vector4F	xInputV = M::subtract( xV, xiV );
+							typename M::Vector4F	yInputV = M::subtract( yV, yiV );
+							typename M::Vector4F	zInputV = M::subtract( zV, ziV );
+
+							typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusSquared( xInputV, yInputV, zInputV ), oneFV ) );
+							typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
+
+							if( batcher.push( xInputV, yInputV, zInputV, M::multiply( wiV, kV ), carrier0V, carrier1V, carrier2V, calcMaskV ) == true )
+							{
+								noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+							}
+
+							numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
+						}
+					}
+
+					if( batcher.count > 0 )
+					{
+						noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+					}
+
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( noiseA, noiseV );
+
+					return noiseA[ 0 ] + noiseA[ 1 ] + noiseA[ 2 ] + noiseA[ 3 ];
+				}
+
+				inline
+				typename M::Vector4F
+				cell4Vectorized( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV,
+								 const typename M::Vector4F xV, const typename M::Vector4F yV, const typename M::Vector4F zV ) const
+				{
+					typename M::Vector4I	oneIV = M::constOneI();
+					typename M::Vector4F	oneFV = M::constOneF();
+					typename M::Vector4F	noiseV = M::constZeroF();
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+
+						PrngVectorType			prngVector( cellSeedVectorized( mV, group.seeds[ k ] ) );
+						typename M::Vector4I	numberOfImpulsesV = prngVector.poisson( widget.impulseCountTable );
+						typename M::Vector4F	kV = M::vectorizeOne( widget.K );
+
+						VECTOR4_ALIGN( uint32	numberOfImpulsesA[ 4 ] );
+						M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
+
+						uint32					maxNumberOfImpulses = findMax( numberOfImpulsesA );
+
+						for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
+						{
+							typename M::Vector4I	impulseMaskV = M::greaterThan( numberOfImpulsesV, M::constZeroI() );
+							typename M::Vector4F	xiV = prngVector.uniformNormalized();
+							typename M::Vector4F	yiV = prngVector.uniformNormalized();
+							typename M::Vector4F	ziV = prngVector.uniformNormalized();
+							typename M::Vector4F	wiV = prngVector.uniformRangeMinusOneToOne();
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							typename M::Vector4F	carrier2V;
+							nextCarrierVectorized( group, widget, prngVector, carrier0V, carrier1V, carrier2V );
+							typename M::Vector4F	xInputV = M::subtract( xV, xiV );
+							typename M::Vector4F	yInputV = M::subtract( yV, yiV );
+							typename M::Vector4F	zInputV = M::subtract( zV, ziV );
+
+							typename M::Vector4I	radiusMaskV = M::castToInt( M::lowerThan( radiusSquared( xInputV, yInputV, zInputV ), oneFV ) );
+							typename M::Vector4I	calcMaskV = M::bitAnd( radiusMaskV, impulseMaskV );
+
+							if( M::isAllZeros( calcMaskV ) == false )
+							{
+								noiseV = M::add( noiseV, cellPart( group, xInputV, yInputV, zInputV, M::multiply( wiV, kV ), carrier0V, carrier1V, carrier2V, calcMaskV ) );
+							}
+
+							numberOfImpulsesV = M::subtract( numberOfImpulsesV, M::bitAnd( impulseMaskV, oneIV ) );
+						}
+					}
+
+					return noiseV;
+				}
+
+				inline
+				ValueType
+				cellCached( const typename BaseType::WidgetGroup& group, CacheType& cache, uint32 m, ValueType x, ValueType y, ValueType z ) const
+				{
+					typename M::Vector4F	xV = M::vectorizeOne( x );
+					typename M::Vector4F	yV = M::vectorizeOne( y );
+					typename M::Vector4F	zV = M::vectorizeOne( z );
+					typename M::Vector4F	oneFV = M::constOneF();
+					Batcher					batcher;
+
+					typename M::Vector4F	noiseV = M::constZeroF();
+
+					for( uint32 k = 0; k < group.size(); ++k )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ group.widgets[ k ] ];
+						const typename CacheType::CellImpulses&		impulses = cache.lookup( widget, BaseType::cellSeed( m, group.seeds[ k ] ) );
+						typename M::Vector4F						kV = M::vectorizeOne( widget.K );
+
+						for( uint32 i = 0; i < impulses.paddedCount; i += 4 )
+						{
+							typename M::Vector4F	xInputV = M::subtract( xV, M::loadFromMemory( impulses.xi + i ) );
+							typename M::Vector4F	yInputV = M::subtract( yV, M::loadFromMemory( impulses.yi + i ) );
+							typename M::Vector4F	zInputV = M::subtract( zV, M::loadFromMemory( impulses.zi + i ) );
+
+							typename M::Vector4I	calcMaskV = M::castToInt( M::lowerThan( radiusSquared( xInputV, yInputV, zInputV ), oneFV ) );
+							typename M::Vector4F	carrier0V;
+							typename M::Vector4F	carrier1V;
+							typename M::Vector4F	carrier2V;
+							carrierVectorized( group, widget, M::loadFromMemory( impulses.F0 + i ), M::loadFromMemory( impulses.omega0 + i ),
+											   M::loadFromMemory( impulses.directionZ + i ), carrier0V, carrier1V, carrier2V );
+
+							if( batcher.push( xInputV, yInputV, zInputV,
+											  M::multiply( M::loadFromMemory( impulses.wi + i ), kV ),
+											  carrier0V,
+											  carrier1V,
+											  carrier2V,
+											  calcMaskV ) == true )
+							{
+								noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+							}
+						}
+					}
+
+					if( batcher.count > 0 )
+					{
+						noiseV = M::add( noiseV, batcher.pop( *this, group ) );
+					}
+
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( noiseA, noiseV );
+
+					return noiseA[ 0 ] + noiseA[ 1 ] + noiseA[ 2 ] + noiseA[ 3 ];
+				}
+
+				inline
+				typename M::Vector4F
+				cell4Cached( const typename BaseType::WidgetGroup& group, const typename M::Vector4I mV,
+							 const typename M::Vector4F xV, const typename M::Vector4F yV, const typename M::Vector4F zV ) const
+				{
+					CacheType&	cache = CacheType::forCurrentThread();
+
+					VECTOR4_ALIGN( uint32					mA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		xA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		yA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		zA[ 4 ] );
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( mA, mV );
+					M::storeToMemory( xA, xV );
+					M::storeToMemory( yA, yV );
+					M::storeToMemory( zA, zV );
+
+					for( uint32 l = 0; l < 4; ++l )
+					{
+						noiseA[ l ] = cellCached( group, cache, mA[ l ], xA[ l ], yA[ l ], zA[ l ] );
+					}
+
+					return M::loadFromMemory( noiseA );
+				}
+
+				inline
+				typename M::Vector4F
+				cellPart( const typename BaseType::WidgetGroup& group,
+						  const typename M::Vector4F& xInputV, const typename M::Vector4F& yInputV, const typename M::Vector4F& zInputV,
+						  const typename M::Vector4F& wiV, const typename M::Vector4F& carrier0V,
+						  const typename M::Vector4F& carrier1V, const typename M::Vector4F& carrier2V,
+						  const typename M::Vector4I& calcMaskV ) const
+				{
+					typename M::Vector4F	kernelRadiusV = M::vectorizeOne( group.kernelRadius );
+					typename M::Vector4F	xV = M::multiply( xInputV, kernelRadiusV );
+					typename M::Vector4F	yV = M::multiply( yInputV, kernelRadiusV );
+					typename M::Vector4F	zV = M::multiply( zInputV, kernelRadiusV );
+
+					LIBNOISE2_GABOR_COUNT_KERNEL( M::maskLaneCount( M::moveMask( calcMaskV ) ) );
+
+					typename M::Vector4F	gaborV = gaborVectorized( group, carrier0V, carrier1V, carrier2V, xV, yV, zV );
+					gaborV = M::multiply( wiV, gaborV );
+					gaborV = M::select( gaborV, calcMaskV );
+
+					return gaborV;
+				}
+
+				static inline
+				typename M::Vector4F
+				radiusSquared( const typename M::Vector4F& xV, const typename M::Vector4F& yV, const typename M::Vector4F& zV )
+				{
+					return M::add( M::add( M::multiply( xV, xV ), M::multiply( yV, yV ) ), M::multiply( zV, zV ) );
+				}
+
+				// Interleaves the low 10 bits of every coordinate and mixes in a hash of the
+				// remaining bits, same as the scalar implementation
+				inline
+				uint32
+				morton( uint32 x, uint32 y, uint32 z ) const
+				{
+					x = this->wrapCell( x );
+					y = this->wrapCell( y );
+					z = this->wrapCell( z );
+
+					uint32	m = 0;
+
+					for( uint32 i = 0; i < 10; ++i )
+					{
+						m |= ((x & (1u << i)) << (i * 2)) | ((y & (1u << i)) << ((i * 2) + 1)) | ((z & (1u << i)) << ((i * 2) + 2));
+					}
+
+					return m ^ ((x >> 10) * 0x9E3779B1u) ^ ((y >> 10) * 0x85EBCA77u) ^ ((z >> 10) * 0xC2B2AE3Du);
+				}
+
+				inline
+				typename M::Vector4I
+				mortonVectorized( typename M::Vector4I xV, typename M::Vector4I yV, typename M::Vector4I zV ) const
+				{
+					if( this->periodic == true )
+					{
+						xV = wrapCellVectorized( xV );
+						yV = wrapCellVectorized( yV );
+						zV = wrapCellVectorized( zV );
+					}
+
+					typename M::Vector4I		mV = M::constZeroI();
+					typename M::Vector4I		oneV = M::constOneI();
+
+					for( uint32 i = 0; i < 10; ++i )
+					{
+						typename M::Vector4I		bitV = M::shiftLeftLogical( oneV, i );
+
+						typename M::Vector4I		xPart = M::shiftLeftLogical( M::bitAnd( bitV, xV ), i * 2 );
+						typename M::Vector4I		yPart = M::shiftLeftLogical( M::bitAnd( bitV, yV ), (i * 2) + 1 );
+						typename M::Vector4I		zPart = M::shiftLeftLogical( M::bitAnd( bitV, zV ), (i * 2) + 2 );
+
+						mV = M::bitOr( mV, M::bitOr( M::bitOr( xPart, yPart ), zPart ) );
+					}
+
+					typename M::Vector4I		xHigh = M::multiply( M::shiftRightLogical( xV, 10 ), M::vectorizeOne( int32( 0x9E3779B1u ) ) );
+					typename M::Vector4I		yHigh = M::multiply( M::shiftRightLogical( yV, 10 ), M::vectorizeOne( int32( 0x85EBCA77u ) ) );
+					typename M::Vector4I		zHigh = M::multiply( M::shiftRightLogical( zV, 10 ), M::vectorizeOne( int32( 0xC2B2AE3Du ) ) );
+
+					return M::bitXor( mV, M::bitXor( M::bitXor( xHigh, yHigh ), zHigh ) );
+				}
+
+				// Vectorized GaborBase::wrapCell for periodic mode, the remainder is taken in floating
+				// point and corrected by one period where the reciprocal rounded the quotient
+				inline
+				typename M::Vector4I
+				wrapCellVectorized( const typename M::Vector4I& cV ) const
+				{
+					typename M::Vector4F		periodV = M::vectorizeOne( ValueType( this->period ) );
+					typename M::Vector4F		cF = M::intToFloat( cV );
+
+					cF = M::subtract( cF, M::multiply( periodV, M::floor( M::multiply( cF, M::vectorizeOne( ValueType( 1.0 ) / ValueType( this->period ) ) ) ) ) );
+					cF = M::subtract( cF, M::select( periodV, M::castToInt( M::equalGreaterThan( cF, periodV ) ) ) );
+					cF = M::add( cF, M::select( periodV, M::castToInt( M::lowerThan( cF, M::constZeroF() ) ) ) );
+
+					return M::floatToIntTruncated( cF );
+				}
+
+				// Vectorized GaborBase::cellSeed
+				inline
+				typename M::Vector4I
+				cellSeedVectorized( const typename M::Vector4I& mV, uint32 widgetSeed ) const
+				{
+					typename M::Vector4I		sV = M::add( mV, M::vectorizeOne( widgetSeed ) );
+
+					typename M::Vector4I		isZero = M::equal( sV, M::constZeroI() );
+					typename M::Vector4I		toOne = M::shiftRightLogical( isZero, 31 );
+
+					return M::add( sV, toOne );
+				}
+
+				inline
+				void
+				nextImpulseParametersVectorized( const typename BaseType::PreparedWidget& widget, PrngVectorType& prngVector,
+												 typename M::Vector4F& F0V, typename M::Vector4F& omega0V, typename M::Vector4F& directionZV ) const
+				{
+					if( widget.fixedFrequency == true )
+					{
+						F0V = M::vectorizeOne( widget.F0 );
+					}
+					else
+					{
+						F0V = prngVector.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
+					}
+
+					if( widget.fixedOrientation == true )
+					{
+						omega0V = M::vectorizeOne( widget.omega0 );
+						directionZV = M::constZeroF();
+					}
+					else
+					{
+						omega0V = prngVector.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
+						directionZV = prngVector.uniformRange( -widget.directionZRange, widget.directionZRange );
+					}
+				}
+
+				// Carrier of impulses as stored in the batches. Groups with fixed orientation keep
+				// 2 * pi * F0 * ( cos( omega0 ), sin( omega0 ), 0 ), other groups keep
+				// ( F0, omega0, directionZ ).
+				inline
+				void
+				carrierVectorized( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget,
+								   const typename M::Vector4F& F0V, const typename M::Vector4F& omega0V, const typename M::Vector4F& directionZV,
+								   typename M::Vector4F& carrier0V, typename M::Vector4F& carrier1V, typename M::Vector4F& carrier2V ) const
+				{
+					if( group.fixedOrientation == true )
+					{
+						carrier0V = M::multiply( F0V, M::vectorizeOne( widget.orientationX ) );
+						carrier1V = M::multiply( F0V, M::vectorizeOne( widget.orientationY ) );
+						carrier2V = M::constZeroF();
+					}
+					else
+					{
+						carrier0V = F0V;
+						carrier1V = omega0V;
+						carrier2V = directionZV;
+					}
+				}
+
+				inline
+				void
+				nextCarrierVectorized( const typename BaseType::WidgetGroup& group, const typename BaseType::PreparedWidget& widget,
+									   PrngVectorType& prngVector, typename M::Vector4F& carrier0V, typename M::Vector4F& carrier1V,
+									   typename M::Vector4F& carrier2V ) const
+				{
+					typename M::Vector4F	F0V;
+					typename M::Vector4F	omega0V;
+					typename M::Vector4F	directionZV;
+
+					nextImpulseParametersVectorized( widget, prngVector, F0V, omega0V, directionZV );
+					carrierVectorized( group, widget, F0V, omega0V, directionZV, carrier0V, carrier1V, carrier2V );
+				}
+
+				// Carriers of fixed orientation lie in the XY plane, so z only enters the Gaussian
+				// envelope there. K is part of the impulse weights, see carrierVectorized for the
+				// carrier vectors.
+				inline
+				typename M::Vector4F
+				gaborVectorized( const typename BaseType::WidgetGroup& group,
+								 const typename M::Vector4F& carrier0V, const typename M::Vector4F& carrier1V,
+								 const typename M::Vector4F& carrier2V,
+								 const typename M::Vector4F& xV, const typename M::Vector4F& yV, const typename M::Vector4F& zV ) const
+				{
+					typename M::Vector4F		aV = M::vectorizeOne( group.a );
+					typename M::Vector4F		piV = M::constMinusPiF();
+					typename M::Vector4F		aa = M::multiply( aV, aV );
+
+					typename M::Vector4F		gaussianEnvelop =  M::multiply( piV, aa );
+					gaussianEnvelop = M::multiply( gaussianEnvelop, radiusSquared( xV, yV, zV ) );
+					gaussianEnvelop = M::exp( gaussianEnvelop );
+
+					if( group.radial == true )
+					{
+						return gaussianEnvelop;
+					}
+
+					typename M::Vector4F		cxV = carrier0V;
+					typename M::Vector4F		cyV = carrier1V;
+					typename M::Vector4F		sinusoidalCarrier;
+
+					if( group.fixedOrientation == false )
+					{
+						typename M::Vector4F	sinOmega;
+						typename M::Vector4F	cosOmega;
+						M::sinCos( carrier1V, sinOmega, cosOmega );
+
+						typename M::Vector4F	twoPiF0V = M::multiply( M::multiply( M::constTwoF(), M::constPiF() ), carrier0V );
+						typename M::Vector4F	planarV = M::sqrtRecip( M::subtract( M::constOneF(), M::multiply( carrier2V, carrier2V ) ) );
+						typename M::Vector4F	twoPiF0PlanarV = M::multiply( twoPiF0V, planarV );
+						cxV = M::multiply( twoPiF0PlanarV, cosOmega );
+						cyV = M::multiply( twoPiF0PlanarV, sinOmega );
+
+						sinusoidalCarrier = M::add( M::add( M::multiply( xV, cxV ), M::multiply( yV, cyV ) ),
+													M::multiply( zV, M::multiply( twoPiF0V, carrier2V ) ) );
+					}
+					else
+					{
+						sinusoidalCarrier = M::add( M::multiply( xV, cxV ), M::multiply( yV, cyV ) );
+					}
+
 					sinusoidalCarrier = M::cos( sinusoidalCarrier );
 
 					return M::multiply( gaussianEnvelop, sinusoidalCarrier );
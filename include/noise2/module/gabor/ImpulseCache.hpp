@@ -0,0 +1,292 @@
+#pragma once
+
+
+#include <cstddef>
+
+
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+#include <noise2/module/gabor/Prng.hpp>
+
+
+
+
+// Number of cells remembered per thread, has to be a power of two
+#if !defined( LIBNOISE2_GABOR_IMPULSE_CACHE_SLOTS )
+#define LIBNOISE2_GABOR_IMPULSE_CACHE_SLOTS		256
+#endif
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			// Direct-mapped cache of decoded cell impulses, keyed by (widget tag, cell seed).
+			// One instance lives per thread and dimension, see forCurrentThread().
+			template< typename ValueT, uint8 Dim = 2 >
+			class ImpulseCache
+			{
+
+			public:
+
+				typedef ValueT						ValueType;
+				typedef Prng< ValueType >			PrngType;
+
+				enum
+				{
+					SlotCount = LIBNOISE2_GABOR_IMPULSE_CACHE_SLOTS,
+					Dimension = Dim,
+					// Impulse position, weight, frequency and orientation, 3D orientations also
+					// have a z component
+					FieldCount = Dim == 3 ? Dim + 4 : Dim + 3
+				};
+
+
+
+			public:
+
+				// Impulses of one cell in SoA form. Arrays are 16 byte aligned and padded
+				// to a multiple of four, padding impulses lie outside of the kernel radius
+				// and have zero weight. zi and directionZ are only stored for 3D cells.
+				struct CellImpulses
+				{
+
+					inline
+					CellImpulses():
+					  tag( 0 ),
+					  seed( 0 ),
+					  count( 0 ),
+					  paddedCount( 0 ),
+					  capacity( 0 ),
+					  xi( 0 ),
+					  yi( 0 ),
+					  zi( 0 ),
+					  wi( 0 ),
+					  F0( 0 ),
+					  omega0( 0 ),
+					  directionZ( 0 )
+					{
+					}
+
+					uint32						tag;
+					uint32						seed;
+					uint32						count;
+					uint32						paddedCount;
+					uint32						capacity;
+
+					ValueType*					xi;
+					ValueType*					yi;
+					ValueType*					zi;
+					ValueType*					wi;
+					ValueType*					F0;
+					ValueType*					omega0;
+					ValueType*					directionZ;
+
+					memory::AlignedArray< ValueType >	storage;
+
+				};
+
+
+
+			private:
+
+				CellImpulses	slots[ SlotCount ];
+				uint64			hits;
+				uint64			misses;
+
+
+
+			public:
+
+				inline
+				ImpulseCache():
+				  hits( 0 ),
+				  misses( 0 )
+				{
+				}
+
+				static inline
+				ImpulseCache&
+				forCurrentThread()
+				{
+					ImpulseCache*&	cache = threadCache();
+
+					if( cache == 0 )
+					{
+						cache = new ImpulseCache();
+					}
+
+					return *cache;
+				}
+
+				static inline
+				void
+				releaseCurrentThread()
+				{
+					ImpulseCache*&	cache = threadCache();
+
+					delete cache;
+					cache = 0;
+				}
+
+				template< typename WidgetType >
+				inline
+				const CellImpulses&
+				lookup( const WidgetType& widget, uint32 s )
+				{
+					CellImpulses&	slot = slots[ slotIndex( widget.cacheTag, s ) ];
+
+					if( slot.tag == widget.cacheTag && slot.seed == s )
+					{
+						++hits;
+						return slot;
+					}
+
+					++misses;
+					generate( slot, widget, s );
+					slot.tag = widget.cacheTag;
+					slot.seed = s;
+
+					return slot;
+				}
+
+				// Decodes the impulses of cell with seed s, used also by the batch evaluation
+				template< typename WidgetType >
+				static inline
+				void
+				generate( CellImpulses& slot, const WidgetType& widget, uint32 s )
+				{
+					PrngType	prng( s );
+					uint32		numberOfImpulses = prng.poisson( widget.impulseCountTable );
+
+					reserve( slot, numberOfImpulses );
+
+					for( uint32 i = 0; i < numberOfImpulses; ++i )
+					{
+						slot.xi[ i ] = prng.uniformNormalized();
+						slot.yi[ i ] = prng.uniformNormalized();
+						if( Dimension == 3 )
+						{
+							slot.zi[ i ] = prng.uniformNormalized();
+						}
+						slot.wi[ i ] = prng.uniformRangeMinusOneToOne();
+						if( Dimension == 3 )
+						{
+							widget.nextImpulseParameters( prng, slot.F0[ i ], slot.omega0[ i ], slot.directionZ[ i ] );
+						}
+						else
+						{
+							widget.nextImpulseParameters( prng, slot.F0[ i ], slot.omega0[ i ] );
+						}
+					}
+
+					slot.count = numberOfImpulses;
+					slot.paddedCount = (numberOfImpulses + 3) & ~3u;
+
+					for( uint32 i = numberOfImpulses; i < slot.paddedCount; ++i )
+					{
+						slot.xi[ i ] = ValueType( 4.0 );
+						slot.yi[ i ] = ValueType( 4.0 );
+						if( Dimension == 3 )
+						{
+							slot.zi[ i ] = ValueType( 4.0 );
+						}
+						slot.wi[ i ] = ValueType( 0.0 );
+						slot.F0[ i ] = ValueType( 0.0 );
+						slot.omega0[ i ] = ValueType( 0.0 );
+						if( Dimension == 3 )
+						{
+							slot.directionZ[ i ] = ValueType( 0.0 );
+						}
+					}
+				}
+
+				inline
+				void
+				clear()
+				{
+					for( uint32 i = 0; i < SlotCount; ++i )
+					{
+						slots[ i ].tag = 0;
+					}
+
+					hits = 0;
+					misses = 0;
+				}
+
+				inline
+				uint64
+				getHitCount() const
+				{
+					return hits;
+				}
+
+				inline
+				uint64
+				getMissCount() const
+				{
+					return misses;
+				}
+
+
+
+			private:
+
+				ImpulseCache( const ImpulseCache& )
+				{
+				}
+
+				static inline
+				ImpulseCache*&
+				threadCache()
+				{
+					static LIBNOISE2_THREAD_LOCAL ImpulseCache*		cache = 0;
+					return cache;
+				}
+
+				static inline
+				uint32
+				slotIndex( uint32 tag, uint32 s )
+				{
+					return (s ^ (tag * 2654435761u)) & (SlotCount - 1);
+				}
+
+				static inline
+				void
+				reserve( CellImpulses& slot, uint32 numberOfImpulses )
+				{
+					uint32	capacity = (numberOfImpulses + 3) & ~3u;
+
+					if( capacity <= slot.capacity && slot.xi != 0 )
+					{
+						return;
+					}
+
+					slot.storage.resize( FieldCount * capacity );
+
+					ValueType*	base = slot.storage.data();
+
+					slot.capacity = capacity;
+					slot.xi = base;
+					slot.yi = base + capacity;
+					slot.zi = Dimension == 3 ? base + (2 * capacity) : 0;
+					slot.wi = base + (Dimension * capacity);
+					slot.F0 = base + ((Dimension + 1) * capacity);
+					slot.omega0 = base + ((Dimension + 2) * capacity);
+					slot.directionZ = Dimension == 3 ? base + ((Dimension + 3) * capacity) : 0;
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -0,0 +1,196 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/BasicTypes.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			// Inverse CDF of the Poisson distribution with a fixed mean. A uniform u in [0, 1]
+			// maps to first + (number of stored CDF values lower than u). Values whose CDF is
+			// within 1e-9 of 0 or 1 are not stored, so the table stays short.
+			template< typename ValueT >
+			class PoissonTable
+			{
+
+			public:
+
+				typedef ValueT		ValueType;
+
+
+
+			private:
+
+				uint32									first;
+				uint32									size;
+				memory::AlignedArray< ValueType >		cdf;
+				// Every CDF value repeated four times, for the vectorized search
+				memory::AlignedArray< ValueType >		broadcastCdf;
+
+
+
+			public:
+
+				inline
+				PoissonTable():
+				  first( 0 ),
+				  size( 0 )
+				{
+				}
+
+				inline
+				explicit
+				PoissonTable( double mean ):
+				  first( 0 ),
+				  size( 0 )
+				{
+					build( mean );
+				}
+
+				void
+				build( double mean )
+				{
+					const double	tail = 1e-9;
+
+					first = 0;
+					size = 0;
+					cdf.resize( 0 );
+					broadcastCdf.resize( 0 );
+
+					if( !(mean > 0.0) )
+					{
+						return;
+					}
+
+					// Relative probabilities around the mode, the recurrence avoids exp( -mean ) underflow
+					uint32					mode = uint32( mean );
+					std::vector< double >	below;
+					std::vector< double >	above;
+					double					p = 1.0;
+
+					for( uint32 k = mode; k > 0 && p > tail * 1e-3; --k )
+					{
+						p *= double( k ) / mean;
+						below.push_back( p );
+					}
+
+					p = 1.0;
+					above.push_back( p );
+					for( uint32 k = mode; p > tail * 1e-3; ++k )
+					{
+						p *= mean / double( k + 1 );
+						above.push_back( p );
+					}
+
+					double	sum = 0.0;
+					for( size_t k = 0; k < below.size(); ++k )
+					{
+						sum += below[ k ];
+					}
+					for( size_t k = 0; k < above.size(); ++k )
+					{
+						sum += above[ k ];
+					}
+
+					std::vector< double >	values;
+					uint32					lowest = mode - uint32( below.size() );
+					double					cumulative = 0.0;
+
+					for( size_t k = below.size(); k > 0; --k )
+					{
+						cumulative += below[ k - 1 ];
+						values.push_back( cumulative / sum );
+					}
+					for( size_t k = 0; k < above.size(); ++k )
+					{
+						cumulative += above[ k ];
+						values.push_back( cumulative / sum );
+					}
+
+					size_t	begin = 0;
+					while( begin < values.size() && values[ begin ] < tail )
+					{
+						++begin;
+					}
+
+					size_t	end = begin;
+					while( end < values.size() && values[ end ] < 1.0 - tail )
+					{
+						++end;
+					}
+
+					first = lowest + uint32( begin );
+					size = uint32( end - begin );
+
+					uint32	paddedSize = (size + 3) & ~3u;
+					cdf.resize( paddedSize );
+					broadcastCdf.resize( size * 4 );
+
+					for( uint32 k = 0; k < paddedSize; ++k )
+					{
+						cdf[ k ] = k < size ? ValueType( values[ begin + k ] ) : ValueType( 2.0 );
+					}
+
+					for( uint32 k = 0; k < size; ++k )
+					{
+						for( uint32 l = 0; l < 4; ++l )
+						{
+							broadcastCdf[ (k * 4) + l ] = cdf[ k ];
+						}
+					}
+				}
+
+				inline
+				uint32
+				sample( ValueType u ) const
+				{
+					const ValueType*	begin = cdf.data();
+
+					return first + uint32( std::lower_bound( begin, begin + size, u ) - begin );
+				}
+
+				inline
+				uint32
+				getFirst() const
+				{
+					return first;
+				}
+
+				inline
+				uint32
+				getSize() const
+				{
+					return size;
+				}
+
+				inline
+				const ValueType*
+				getBroadcastCdf() const
+				{
+					return broadcastCdf.data();
+				}
+
+			};
+
+		}
+
+	}
+
+}
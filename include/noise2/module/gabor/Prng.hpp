@@ -7,6 +7,7 @@
 
 #include <noise2/BasicTypes.hpp>
 #include <noise2/math/Math.hpp>
+#include <noise2/module/gabor/PoissonTable.hpp>
 
 
 
@@ -104,6 +105,14 @@ namespace noise2
 					return em;
 				}
 
+				// Single uniform draw through the precomputed inverse CDF
+				inline
+				uint32
+				poisson( const PoissonTable< ValueType >& table )
+				{
+					return table.sample( uniformNormalized() );
+				}
+
 			};
 
 		}
@@ -7,6 +7,7 @@
 
 #include <noise2/debug/Debug.hpp>
 #include <noise2/math/Math.hpp>
+#include <noise2/module/gabor/PoissonTable.hpp>
 
 
 
@@ -128,6 +129,25 @@ namespace noise2
 					return emV;
 				}
 
+				// Single uniform draw per lane, the count is found by comparing it against
+				// every stored CDF value, so all lanes take the same path
+				inline
+				typename M::Vector4I
+				poisson( const PoissonTable< ValueType >& table )
+				{
+					typename M::Vector4F	uV = uniformNormalized();
+					typename M::Vector4I	countV = M::vectorizeOne( table.getFirst() );
+					const ValueType*		cdf = table.getBroadcastCdf();
+
+					for( uint32 k = 0; k < table.getSize(); ++k )
+					{
+						typename M::Vector4I	belowV = M::castToInt( M::lowerThan( M::loadFromMemory( cdf + (k * 4) ), uV ) );
+						countV = M::subtract( countV, belowV );
+					}
+
+					return countV;
+				}
+
 			};
 
 		}
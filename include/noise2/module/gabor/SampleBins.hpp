@@ -0,0 +1,250 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+
+
+
+
+// Number of samples evaluated at once by GetValueGrid, bounds its temporary memory
+#if !defined( LIBNOISE2_GABOR_GRID_STRIP_SAMPLES )
+#define LIBNOISE2_GABOR_GRID_STRIP_SAMPLES		262144
+#endif
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			// Groups a batch of 2D samples by the kernel-radius sized cell they fall into.
+			// Samples of one cell are stored contiguously in cell-local coordinates and
+			// padded to a multiple of Lanes, padding samples lie far outside of any kernel.
+			template< typename ValueT, uint32 Lanes >
+			class SampleBins
+			{
+
+			public:
+
+				typedef ValueT						ValueType;
+
+				static const uint32					NoSample = 0xFFFFFFFFu;
+
+				struct Cell
+				{
+					int32	i;
+					int32	j;
+
+					inline
+					bool
+					operator < ( const Cell& other ) const
+					{
+						return i < other.i || (i == other.i && j < other.j);
+					}
+
+					inline
+					bool
+					operator == ( const Cell& other ) const
+					{
+						return i == other.i && j == other.j;
+					}
+				};
+
+				struct Bin
+				{
+					Cell	cell;
+					uint32	begin;
+					uint32	end;
+				};
+
+
+
+			public:
+
+				memory::AlignedArray< ValueType >	x;
+				memory::AlignedArray< ValueType >	y;
+				memory::AlignedArray< ValueType >	accumulated;
+				std::vector< uint32 >				sampleIndex;
+
+				// Sorted by cell
+				std::vector< Bin >					bins;
+				// Cells whose impulses reach at least one bin, sorted
+				std::vector< Cell >					sourceCells;
+
+
+
+			private:
+
+				typedef math::Math< ValueType >		M;
+
+				struct Entry
+				{
+					Cell		cell;
+					uint32		index;
+					ValueType	fracX;
+					ValueType	fracY;
+
+					inline
+					bool
+					operator < ( const Entry& other ) const
+					{
+						return cell < other.cell;
+					}
+				};
+
+				std::vector< Entry >				entries;
+
+
+
+			public:
+
+				inline
+				void
+				build( const ValueType* inputX, const ValueType* inputY, size_t count, ValueType kernelRadius )
+				{
+					entries.resize( count );
+					bins.clear();
+					sourceCells.clear();
+
+					for( size_t s = 0; s < count; ++s )
+					{
+						ValueType	widgetX = inputX[ s ] / kernelRadius;
+						ValueType	widgetY = inputY[ s ] / kernelRadius;
+						ValueType	intX = M::floor( widgetX );
+						ValueType	intY = M::floor( widgetY );
+
+						entries[ s ].cell.i = int32( intX );
+						entries[ s ].cell.j = int32( intY );
+						entries[ s ].index = uint32( s );
+						entries[ s ].fracX = widgetX - intX;
+						entries[ s ].fracY = widgetY - intY;
+					}
+
+					std::sort( entries.begin(), entries.end() );
+
+					size_t	padded = 0;
+					for( size_t s = 0; s < count; )
+					{
+						size_t	e = s + 1;
+						while( e < count && entries[ e ].cell == entries[ s ].cell )
+						{
+							++e;
+						}
+
+						Bin		bin;
+						bin.cell = entries[ s ].cell;
+						bin.begin = uint32( padded );
+						padded += ((e - s) + (Lanes - 1)) / Lanes * Lanes;
+						bin.end = uint32( padded );
+						bins.push_back( bin );
+
+						s = e;
+					}
+
+					x.resize( padded );
+					y.resize( padded );
+					accumulated.resize( padded );
+					sampleIndex.resize( padded );
+
+					size_t	s = 0;
+					for( size_t b = 0; b < bins.size(); ++b )
+					{
+						uint32	slot = bins[ b ].begin;
+
+						for( ; s < count && entries[ s ].cell == bins[ b ].cell; ++s, ++slot )
+						{
+							x[ slot ] = entries[ s ].fracX;
+							y[ slot ] = entries[ s ].fracY;
+							accumulated[ slot ] = ValueType( 0.0 );
+							sampleIndex[ slot ] = entries[ s ].index;
+						}
+
+						for( ; slot < bins[ b ].end; ++slot )
+						{
+							x[ slot ] = ValueType( 8.0 );
+							y[ slot ] = ValueType( 8.0 );
+							accumulated[ slot ] = ValueType( 0.0 );
+							sampleIndex[ slot ] = NoSample;
+						}
+
+						for( int32 di = -1; di <= 1; ++di )
+						{
+							for( int32 dj = -1; dj <= 1; ++dj )
+							{
+								Cell	source;
+								source.i = bins[ b ].cell.i + di;
+								source.j = bins[ b ].cell.j + dj;
+								sourceCells.push_back( source );
+							}
+						}
+					}
+
+					std::sort( sourceCells.begin(), sourceCells.end() );
+					sourceCells.erase( std::unique( sourceCells.begin(), sourceCells.end() ), sourceCells.end() );
+				}
+
+				inline
+				const Bin*
+				find( int32 i, int32 j ) const
+				{
+					Bin		key;
+					key.cell.i = i;
+					key.cell.j = j;
+
+					typename std::vector< Bin >::const_iterator	it = std::lower_bound( bins.begin(), bins.end(), key, lessBin );
+
+					if( it == bins.end() || !(it->cell == key.cell) )
+					{
+						return 0;
+					}
+
+					return &(*it);
+				}
+
+				// Adds the accumulated values to the output in the original sample order
+				inline
+				void
+				scatter( ValueType* output ) const
+				{
+					for( size_t slot = 0; slot < sampleIndex.size(); ++slot )
+					{
+						if( sampleIndex[ slot ] != NoSample )
+						{
+							output[ sampleIndex[ slot ] ] += accumulated[ slot ];
+						}
+					}
+				}
+
+
+
+			private:
+
+				static inline
+				bool
+				lessBin( const Bin& a, const Bin& b )
+				{
+					return a.cell < b.cell;
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -0,0 +1,219 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Fft.hpp>
+#include <noise2/math/Math.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			// Synthesizes one widget with fixed frequency and orientation over square tiles
+			// of a regular grid. The carrier is factored out of the sum of kernels,
+			//
+			//   sum( w * K * envelope( p - q ) * cos( c . ( p - q ) ) )
+			//     = Re( exp( i c . p ) * sum( w * exp( -i c . q ) * K * envelope( p - q ) ) ),
+			//
+			// so impulses are splatted bilinearly as complex Dirac points and only the smooth
+			// truncated Gaussian envelope is convolved, in the frequency domain. Positions are
+			// relative to the first output sample of the current tile.
+			template< typename ValueT >
+			class SpectralGrid
+			{
+
+			public:
+
+				typedef ValueT							ValueType;
+				typedef math::Fft< ValueType >			FftType;
+				typedef typename FftType::Complex		Complex;
+
+
+
+			private:
+
+				typedef math::Math< ValueType >			M;
+
+				ValueType					stepX;
+				ValueType					stepY;
+				ValueType					cx;
+				ValueType					cy;
+				// Grid samples around a tile reached by the kernel
+				uint32						padding;
+				FftType						fft;
+				uint32						tileSize;
+				std::vector< Complex >		kernelSpectrum;
+				std::vector< Complex >		grid;
+
+
+
+			public:
+
+				SpectralGrid( ValueType newStepX, ValueType newStepY, ValueType kernelRadius, ValueType a, ValueType K, ValueType newCx, ValueType newCy ):
+				  stepX( newStepX ),
+				  stepY( newStepY ),
+				  cx( newCx ),
+				  cy( newCy ),
+				  padding( paddingFor( kernelRadius, newStepX, newStepY ) ),
+				  fft( sizeFor( padding ) ),
+				  tileSize( fft.getSize() - (2 * padding) - 1 ),
+				  kernelSpectrum( size_t( fft.getSize() ) * fft.getSize() ),
+				  grid( size_t( fft.getSize() ) * fft.getSize() )
+				{
+					uint32		size = fft.getSize();
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( size ) * ValueType( size ));
+
+					for( int32 dy = -int32( padding ); dy <= int32( padding ); ++dy )
+					{
+						for( int32 dx = -int32( padding ); dx <= int32( padding ); ++dx )
+						{
+							ValueType	x = ValueType( dx ) * stepX;
+							ValueType	y = ValueType( dy ) * stepY;
+							ValueType	r2 = (x * x) + (y * y);
+
+							if( r2 < kernelRadius * kernelRadius )
+							{
+								size_t	index = (size_t( (dy + int32( size )) % int32( size ) ) * size) + size_t( (dx + int32( size )) % int32( size ) );
+
+								kernelSpectrum[ index ] = Complex( scale * K * M::exp( -M::Pi() * (a * a) * r2 ), ValueType( 0.0 ) );
+							}
+						}
+					}
+
+					fft.transform2D( &kernelSpectrum[ 0 ], false );
+				}
+
+				// Output samples covered by one tile along each axis
+				inline
+				uint32
+				getTileSize() const
+				{
+					return tileSize;
+				}
+
+				inline
+				void
+				beginTile()
+				{
+					std::fill( grid.begin(), grid.end(), Complex( ValueType( 0.0 ), ValueType( 0.0 ) ) );
+				}
+
+				inline
+				void
+				splat( ValueType x, ValueType y, ValueType w )
+				{
+					ValueType	u = (x / stepX) + ValueType( padding );
+					ValueType	v = (y / stepY) + ValueType( padding );
+					ValueType	intU = M::floor( u );
+					ValueType	intV = M::floor( v );
+					int32		i = int32( intU );
+					int32		j = int32( intV );
+					int32		last = int32( fft.getSize() ) - 1;
+
+					if( i < 0 || j < 0 || i >= last || j >= last )
+					{
+						return;
+					}
+
+					ValueType	fu = u - intU;
+					ValueType	fv = v - intV;
+					ValueType	phase = (cx * x) + (cy * y);
+					Complex		weight = Complex( w * std::cos( phase ), -w * std::sin( phase ) );
+					Complex*	cell = &grid[ (size_t( j ) * fft.getSize()) + size_t( i ) ];
+
+					cell[ 0 ] += weight * ((ValueType( 1.0 ) - fu) * (ValueType( 1.0 ) - fv));
+					cell[ 1 ] += weight * (fu * (ValueType( 1.0 ) - fv));
+					cell[ fft.getSize() ] += weight * ((ValueType( 1.0 ) - fu) * fv);
+					cell[ fft.getSize() + 1 ] += weight * (fu * fv);
+				}
+
+				// Convolves the splatted impulses and adds the first width x height samples of
+				// the tile to output, whose rows are outputStride values apart
+				void
+				endTile( ValueType* output, size_t outputStride, uint32 width, uint32 height )
+				{
+					uint32	size = fft.getSize();
+
+					fft.transform2D( &grid[ 0 ], false );
+
+					for( size_t k = 0; k < grid.size(); ++k )
+					{
+						grid[ k ] *= kernelSpectrum[ k ];
+					}
+
+					fft.transform2D( &grid[ 0 ], true );
+
+					std::vector< Complex >	columnCarrier( width );
+					for( uint32 c = 0; c < width; ++c )
+					{
+						ValueType	phase = cx * ValueType( c ) * stepX;
+
+						columnCarrier[ c ] = Complex( std::cos( phase ), std::sin( phase ) );
+					}
+
+					for( uint32 r = 0; r < height; ++r )
+					{
+						ValueType		phase = cy * ValueType( r ) * stepY;
+						Complex			rowCarrier( std::cos( phase ), std::sin( phase ) );
+						const Complex*	row = &grid[ (size_t( r + padding ) * size) + padding ];
+						ValueType*		out = output + (size_t( r ) * outputStride);
+
+						for( uint32 c = 0; c < width; ++c )
+						{
+							out[ c ] += std::real( row[ c ] * (rowCarrier * columnCarrier[ c ]) );
+						}
+					}
+				}
+
+
+
+			private:
+
+				static inline
+				uint32
+				paddingFor( ValueType kernelRadius, ValueType stepX, ValueType stepY )
+				{
+					ValueType	samples = std::ceil( kernelRadius / (stepX < stepY ? stepX : stepY) );
+
+					return uint32( samples ) + 1;
+				}
+
+				// Power of two holding a tile at least twice as wide as the kernel
+				static inline
+				uint32
+				sizeFor( uint32 padding )
+				{
+					uint32	size = 64;
+
+					while( size < 4 * ((2 * padding) + 1) )
+					{
+						size *= 2;
+					}
+
+					return size;
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+
+#include <noise2/Platform.hpp>
+#include <noise2/BasicTypes.hpp>
+
+
+
+
+// Define LIBNOISE2_GABOR_STATISTICS to count Gabor kernel evaluations and culled cells per thread
+#if defined( LIBNOISE2_GABOR_STATISTICS )
+#define LIBNOISE2_GABOR_COUNT_KERNEL( activeLanes )		noise2::module::gabor::Statistics::forCurrentThread().countKernel( activeLanes )
+#define LIBNOISE2_GABOR_COUNT_CELLS( visited, culled )		noise2::module::gabor::Statistics::forCurrentThread().countCells( visited, culled )
+#else
+#define LIBNOISE2_GABOR_COUNT_KERNEL( activeLanes )
+#define LIBNOISE2_GABOR_COUNT_CELLS( visited, culled )
+#endif
+
+
+
+namespace noise2
+{
+
+	namespace module
+	{
+
+		namespace gabor
+		{
+
+			struct Statistics
+			{
+
+				// Vectorized exp/cos evaluations, four lanes each
+				uint64		kernelEvaluations;
+				// Lanes of those evaluations which carried an impulse
+				uint64		activeLanes;
+				// Neighbour cells considered by GaborSurface, and those of them culled before
+				// their impulses were generated
+				uint64		cellsVisited;
+				uint64		cellsCulled;
+
+				inline
+				Statistics():
+				  kernelEvaluations( 0 ),
+				  activeLanes( 0 ),
+				  cellsVisited( 0 ),
+				  cellsCulled( 0 )
+				{
+				}
+
+				static inline
+				Statistics&
+				forCurrentThread()
+				{
+					Statistics*&	statistics = threadStatistics();
+
+					if( statistics == 0 )
+					{
+						statistics = new Statistics();
+					}
+
+					return *statistics;
+				}
+
+				// Frees the counters of the calling thread, to be called before a short-lived
+				// thread exits
+				static inline
+				void
+				releaseCurrentThread()
+				{
+					Statistics*&	statistics = threadStatistics();
+
+					delete statistics;
+					statistics = 0;
+				}
+
+				inline
+				void
+				countKernel( uint32 lanes )
+				{
+					++kernelEvaluations;
+					activeLanes += lanes;
+				}
+
+				inline
+				void
+				countCells( uint32 visited, uint32 culled )
+				{
+					cellsVisited += visited;
+					cellsCulled += culled;
+				}
+
+				inline
+				void
+				reset()
+				{
+					kernelEvaluations = 0;
+					activeLanes = 0;
+					cellsVisited = 0;
+					cellsCulled = 0;
+				}
+
+				static inline
+				Statistics*&
+				threadStatistics()
+				{
+					static LIBNOISE2_THREAD_LOCAL Statistics*	statistics = 0;
+					return statistics;
+				}
+
+			};
+
+		}
+
+	}
+
+}
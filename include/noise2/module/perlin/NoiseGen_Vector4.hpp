@@ -123,15 +123,29 @@ namespace noise2
 				GradientCoherentNoise4( const typename M::Vector4F& xV, const typename M::Vector4I& seedV,
 										NoiseQuality noiseQuality = QUALITY_STD )
 				{
+					return GradientCoherentNoiseV< 4 >( xV, seedV, noiseQuality );
+				}
+
+				// Any multiple of four lanes, see math::Math_Wide
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientCoherentNoiseV( const typename math::Math< ValueType, Width >::VectorF& xV,
+										const typename math::Math< ValueType, Width >::VectorI& seedV,
+										NoiseQuality noiseQuality = QUALITY_STD )
+				{
+					typedef math::Math< ValueType, Width >				MW;
+					typedef math::Interpolations< ValueType, Width >	InterpW;
+
 					// Create a unit-length cube aligned along an integer boundary.  This cube
 					// surrounds the input point.
-					typename M::Vector4I	x0V = M::floatToIntTruncated( xV );
-					x0V = M::subtract( x0V, M::signToOne( xV ) );
-					typename M::Vector4I	x1V = M::add( x0V, M::constOneI() );
+					typename MW::VectorI	x0V = MW::floatToIntTruncated( xV );
+					x0V = MW::subtract( x0V, MW::signToOne( xV ) );
+					typename MW::VectorI	x1V = MW::add( x0V, MW::constOneI() );
 
 					// Map the difference between the coordinates of the input value and the
 					// coordinates of the cube's outer-lower-left vertex onto an S-curve.
-					typename M::Vector4F	xsV = M::subtract( xV, M::intToFloat( x0V ) );
+					typename MW::VectorF	xsV = MW::subtract( xV, MW::intToFloat( x0V ) );
 					
 					switch( noiseQuality )
 					{
@@ -144,14 +158,14 @@ namespace noise2
 
 						case QUALITY_STD:
 
-						xsV = Interp::SCurve3V( xsV );
+						xsV = InterpW::SCurve3V( xsV );
 						
 						break;
 
 
 						case QUALITY_BEST:
 
-						xsV = Interp::SCurve5V( xsV );
+						xsV = InterpW::SCurve5V( xsV );
 						
 						break;
 					}
@@ -160,39 +174,51 @@ namespace noise2
 					// the coherent-noise value at the input point, interpolate these eight
 					// noise values using the S-curve value as the interpolant (trilinear
 					// interpolation.)
-					typename M::Vector4F	n0V;
-					typename M::Vector4F	n1V;
+					typename MW::VectorF	n0V;
+					typename MW::VectorF	n1V;
 					
-					n0V = GradientNoise4( xV, x0V, seedV );
-					n1V = GradientNoise4( xV, x1V, seedV );
+					n0V = GradientNoiseV< Width >( xV, x0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, x1V, seedV );
 
-					return Interp::LinearInterpV( n0V, n1V, xsV );
+					return InterpW::LinearInterpV( n0V, n1V, xsV );
 				}
 
 
 
 			private:
 				
+				template< uint32 Width >
 				static inline
-				typename M::Vector4F
-				GradientNoise4( const typename M::Vector4F& fxV, const typename M::Vector4I& ixV,
-								const typename M::Vector4I& seedV )
+				typename math::Math< ValueType, Width >::VectorF
+				GradientNoiseV( const typename math::Math< ValueType, Width >::VectorF& fxV,
+								const typename math::Math< ValueType, Width >::VectorI& ixV,
+								const typename math::Math< ValueType, Width >::VectorI& seedV )
 				{
-					static VECTOR4_ALIGN( uint32	seedNoiseGenA[ 4 ] ) = { SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	xNoiseGenA[ 4 ] ) = { X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN };
-					typename M::Vector4I	seedNoiseGenV = M::loadFromMemory( seedNoiseGenA );
-					typename M::Vector4I	xNoiseGenV = M::loadFromMemory( xNoiseGenA );
+					typedef math::Math< ValueType, Width >		MW;
 
 					// Randomly generate a gradient vector given the integer coordinates of the
 					// input value.  This implementation generates a random number and uses it
 					// as an index into a normalized-vector lookup table.
-					typename M::Vector4I	vectorIndexV = M::multiply( seedNoiseGenV, seedV );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( xNoiseGenV, ixV ) );
+					typename MW::VectorI	vectorIndexV = MW::multiply( MW::vectorizeOne( uint32( SEED_NOISE_GEN ) ), seedV );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( X_NOISE_GEN ) ), ixV ) );
+
+					vectorIndexV = MW::bitXor( vectorIndexV, MW::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
+					vectorIndexV = MW::bitAnd( vectorIndexV, MW::vectorizeOne( 0xff ) );
+					vectorIndexV = MW::multiply( vectorIndexV, MW::constFourI() );
+
+					typename MW::VectorF	xvGradientV;
+					gatherGradients( vectorIndexV, xvGradientV );
 
-					vectorIndexV = M::bitXor( vectorIndexV, M::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
-					vectorIndexV = M::bitAnd( vectorIndexV, M::vectorizeOne( 0xff ) );
-					vectorIndexV = M::multiply( vectorIndexV, M::constFourI() );
+					typename MW::VectorF	xvPointV = MW::subtract( fxV, MW::intToFloat( ixV ) );
 
+					return MW::multiply( MW::multiply( xvGradientV, xvPointV ), MW::vectorizeOne( ValueType( 2.12 ) ) );
+				}
+
+				// Loads the four table rows and transposes their x values into one vector
+				static inline
+				void
+				gatherGradients( const typename M::Vector4I& vectorIndexV, typename M::Vector4F& xvGradientV )
+				{
 					VECTOR4_ALIGN( uint32	vectorIndexA[ 4 ] );
 					M::storeToMemory( vectorIndexA, vectorIndexV );
 
@@ -200,11 +226,34 @@ namespace noise2
 																		 M::loadFromMemory( Table::values() + vectorIndexA[ 1 ] ) );
 					typename M::Vector4F	gx3x4____ = M::interleaveLo( M::loadFromMemory( Table::values() + vectorIndexA[ 2 ] ),
 																		 M::loadFromMemory( Table::values() + vectorIndexA[ 3 ] ) );
-					typename M::Vector4F	xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2____, gx3x4____ );
-					typename M::Vector4F	xvPointV = M::subtract( fxV, M::intToFloat( ixV ) );
+					xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2____, gx3x4____ );
+				}
 
-					return M::multiply( M::multiply( xvGradientV, xvPointV ), M::vectorizeOne( ValueType( 2.12 ) ) );
+				// Wider vectors gather part by part
+				template< typename VectorI, typename VectorF >
+				static inline
+				void
+				gatherGradients( const VectorI& vectorIndexV, VectorF& xvGradientV )
+				{
+					const uint32	partCount = sizeof( vectorIndexV.part ) / sizeof( vectorIndexV.part[ 0 ] );
+
+					for( uint32 p = 0; p < partCount; ++p )
+					{
+						gatherGradients( vectorIndexV.part[ p ], xvGradientV.part[ p ] );
+					}
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+				// Native eight lane float gathers the table columns directly
+				static inline
+				void
+				gatherGradients( const __m256i& vectorIndexV, __m256& xvGradientV )
+				{
+					typedef math::Math< ValueType, 8 >		M8;
+
+					xvGradientV = M8::gather( Table::values(), vectorIndexV );
 				}
+#endif
 
 			};
 
@@ -373,19 +422,34 @@ namespace noise2
 				GradientCoherentNoise4( const typename M::Vector4F& xV, const typename M::Vector4F& yV,
 										const typename M::Vector4I& seedV, NoiseQuality noiseQuality = QUALITY_STD )
 				{
+					return GradientCoherentNoiseV< 4 >( xV, yV, seedV, noiseQuality );
+				}
+
+				// Any multiple of four lanes, see math::Math_Wide
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientCoherentNoiseV( const typename math::Math< ValueType, Width >::VectorF& xV,
+										const typename math::Math< ValueType, Width >::VectorF& yV,
+										const typename math::Math< ValueType, Width >::VectorI& seedV,
+										NoiseQuality noiseQuality = QUALITY_STD )
+				{
+					typedef math::Math< ValueType, Width >				MW;
+					typedef math::Interpolations< ValueType, Width >	InterpW;
+
 					// Create a unit-length cube aligned along an integer boundary.  This cube
 					// surrounds the input point.
-					typename M::Vector4I	x0V = M::floatToIntTruncated( xV );
-					x0V = M::subtract( x0V, M::signToOne( xV ) );
-					typename M::Vector4I	x1V = M::add( x0V, M::constOneI() );
-					typename M::Vector4I	y0V = M::floatToIntTruncated( yV );
-					y0V = M::subtract( y0V, M::signToOne( yV ) );
-					typename M::Vector4I	y1V = M::add( y0V, M::constOneI() );
+					typename MW::VectorI	x0V = MW::floatToIntTruncated( xV );
+					x0V = MW::subtract( x0V, MW::signToOne( xV ) );
+					typename MW::VectorI	x1V = MW::add( x0V, MW::constOneI() );
+					typename MW::VectorI	y0V = MW::floatToIntTruncated( yV );
+					y0V = MW::subtract( y0V, MW::signToOne( yV ) );
+					typename MW::VectorI	y1V = MW::add( y0V, MW::constOneI() );
 
 					// Map the difference between the coordinates of the input value and the
 					// coordinates of the cube's outer-lower-left vertex onto an S-curve.
-					typename M::Vector4F	xsV = M::subtract( xV, M::intToFloat( x0V ) );
-					typename M::Vector4F	ysV = M::subtract( yV, M::intToFloat( y0V ) );
+					typename MW::VectorF	xsV = MW::subtract( xV, MW::intToFloat( x0V ) );
+					typename MW::VectorF	ysV = MW::subtract( yV, MW::intToFloat( y0V ) );
 					
 					switch( noiseQuality )
 					{
@@ -398,16 +462,16 @@ namespace noise2
 
 						case QUALITY_STD:
 
-						xsV = Interp::SCurve3V( xsV );
-						ysV = Interp::SCurve3V( ysV );
+						xsV = InterpW::SCurve3V( xsV );
+						ysV = InterpW::SCurve3V( ysV );
 						
 						break;
 
 
 						case QUALITY_BEST:
 
-						xsV = Interp::SCurve5V( xsV );
-						ysV = Interp::SCurve5V( ysV );
+						xsV = InterpW::SCurve5V( xsV );
+						ysV = InterpW::SCurve5V( ysV );
 						
 						break;
 					}
@@ -416,50 +480,65 @@ namespace noise2
 					// the coherent-noise value at the input point, interpolate these eight
 					// noise values using the S-curve value as the interpolant (trilinear
 					// interpolation.)
-					typename M::Vector4F	n0V;
-					typename M::Vector4F	n1V;
-					typename M::Vector4F	ix0V;
-					typename M::Vector4F	ix1V;
+					typename MW::VectorF	n0V;
+					typename MW::VectorF	n1V;
+					typename MW::VectorF	ix0V;
+					typename MW::VectorF	ix1V;
 					
-					n0V = GradientNoise4( xV, yV, x0V, y0V, seedV );
-					n1V = GradientNoise4( xV, yV, x1V, y0V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, x0V, y0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, x1V, y0V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
 
-					n0V = GradientNoise4( xV, yV, x0V, y1V, seedV );
-					n1V = GradientNoise4( xV, yV, x1V, y1V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, x0V, y1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, x1V, y1V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
 
-					return Interp::LinearInterpV( ix0V, ix1V, ysV );
+					return InterpW::LinearInterpV( ix0V, ix1V, ysV );
 				}
 
 
 
 			private:
 				
+				template< uint32 Width >
 				static inline
-				typename M::Vector4F
-				GradientNoise4( const typename M::Vector4F& fxV, const typename M::Vector4F& fyV,
-								const typename M::Vector4I& ixV, const typename M::Vector4I& iyV,
-								const typename M::Vector4I& seedV )
+				typename math::Math< ValueType, Width >::VectorF
+				GradientNoiseV( const typename math::Math< ValueType, Width >::VectorF& fxV,
+								const typename math::Math< ValueType, Width >::VectorF& fyV,
+								const typename math::Math< ValueType, Width >::VectorI& ixV,
+								const typename math::Math< ValueType, Width >::VectorI& iyV,
+								const typename math::Math< ValueType, Width >::VectorI& seedV )
 				{
-					static VECTOR4_ALIGN( uint32	seedNoiseGenA[ 4 ] ) = { SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	xNoiseGenA[ 4 ] ) = { X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	yNoiseGenA[ 4 ] ) = { Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN };
-					typename M::Vector4I	seedNoiseGenV = M::loadFromMemory( seedNoiseGenA );
-					typename M::Vector4I	xNoiseGenV = M::loadFromMemory( xNoiseGenA );
-					typename M::Vector4I	yNoiseGenV = M::loadFromMemory( yNoiseGenA );
+					typedef math::Math< ValueType, Width >		MW;
 
 					// Randomly generate a gradient vector given the integer coordinates of the
 					// input value.  This implementation generates a random number and uses it
 					// as an index into a normalized-vector lookup table.
-					typename M::Vector4I	vectorIndexV = M::multiply( seedNoiseGenV, seedV );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( xNoiseGenV, ixV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( yNoiseGenV, iyV ) );
+					typename MW::VectorI	vectorIndexV = MW::multiply( MW::vectorizeOne( uint32( SEED_NOISE_GEN ) ), seedV );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( X_NOISE_GEN ) ), ixV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Y_NOISE_GEN ) ), iyV ) );
+
+					vectorIndexV = MW::bitXor( vectorIndexV, MW::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
+					vectorIndexV = MW::bitAnd( vectorIndexV, MW::vectorizeOne( 0xff ) );
+					vectorIndexV = MW::multiply( vectorIndexV, MW::constFourI() );
 
-					vectorIndexV = M::bitXor( vectorIndexV, M::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
-					vectorIndexV = M::bitAnd( vectorIndexV, M::vectorizeOne( 0xff ) );
-					vectorIndexV = M::multiply( vectorIndexV, M::constFourI() );
+					typename MW::VectorF	xvGradientV;
+					typename MW::VectorF	yvGradientV;
+					gatherGradients( vectorIndexV, xvGradientV, yvGradientV );
 
+					typename MW::VectorF	xvPointV = MW::subtract( fxV, MW::intToFloat( ixV ) );
+					typename MW::VectorF	yvPointV = MW::subtract( fyV, MW::intToFloat( iyV ) );
+
+					typename MW::VectorF	nV = MW::multiply( xvGradientV, xvPointV );
+					nV = MW::add( nV, MW::multiply( yvGradientV, yvPointV ) );
+					return MW::multiply( nV, MW::vectorizeOne( ValueType( 2.12 ) ) );
+				}
+
+				// Loads the four table rows and transposes them into x and y vectors
+				static inline
+				void
+				gatherGradients( const typename M::Vector4I& vectorIndexV, typename M::Vector4F& xvGradientV, typename M::Vector4F& yvGradientV )
+				{
 					VECTOR4_ALIGN( uint32	vectorIndexA[ 4 ] );
 					M::storeToMemory( vectorIndexA, vectorIndexV );
 
@@ -467,16 +546,36 @@ namespace noise2
 																		 M::loadFromMemory( Table::values() + vectorIndexA[ 1 ] ) );
 					typename M::Vector4F	gx3x4y3y4 = M::interleaveLo( M::loadFromMemory( Table::values() + vectorIndexA[ 2 ] ),
 																		 M::loadFromMemory( Table::values() + vectorIndexA[ 3 ] ) );
-					typename M::Vector4F	xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
-					typename M::Vector4F	yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
+					xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
+					yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
+				}
+
+				// Wider vectors gather part by part
+				template< typename VectorI, typename VectorF >
+				static inline
+				void
+				gatherGradients( const VectorI& vectorIndexV, VectorF& xvGradientV, VectorF& yvGradientV )
+				{
+					const uint32	partCount = sizeof( vectorIndexV.part ) / sizeof( vectorIndexV.part[ 0 ] );
 
-					typename M::Vector4F	xvPointV = M::subtract( fxV, M::intToFloat( ixV ) );
-					typename M::Vector4F	yvPointV = M::subtract( fyV, M::intToFloat( iyV ) );
+					for( uint32 p = 0; p < partCount; ++p )
+					{
+						gatherGradients( vectorIndexV.part[ p ], xvGradientV.part[ p ], yvGradientV.part[ p ] );
+					}
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+				// Native eight lane float gathers the table columns directly
+				static inline
+				void
+				gatherGradients( const __m256i& vectorIndexV, __m256& xvGradientV, __m256& yvGradientV )
+				{
+					typedef math::Math< ValueType, 8 >		M8;
 
-					typename M::Vector4F	nV = M::multiply( xvGradientV, xvPointV );
-					nV = M::add( nV, M::multiply( yvGradientV, yvPointV ) );
-					return M::multiply( nV, M::vectorizeOne( ValueType( 2.12 ) ) );
+					xvGradientV = M8::gather( Table::values(), vectorIndexV );
+					yvGradientV = M8::gather( Table::values() + 1, vectorIndexV );
 				}
+#endif
 
 			};
 
@@ -661,23 +760,39 @@ namespace noise2
 										const typename M::Vector4F& zV,
 										const typename M::Vector4I& seedV, NoiseQuality noiseQuality = QUALITY_STD )
 				{
+					return GradientCoherentNoiseV< 4 >( xV, yV, zV, seedV, noiseQuality );
+				}
+
+				// Any multiple of four lanes, see math::Math_Wide
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientCoherentNoiseV( const typename math::Math< ValueType, Width >::VectorF& xV,
+										const typename math::Math< ValueType, Width >::VectorF& yV,
+										const typename math::Math< ValueType, Width >::VectorF& zV,
+										const typename math::Math< ValueType, Width >::VectorI& seedV,
+										NoiseQuality noiseQuality = QUALITY_STD )
+				{
+					typedef math::Math< ValueType, Width >				MW;
+					typedef math::Interpolations< ValueType, Width >	InterpW;
+
 					// Create a unit-length cube aligned along an integer boundary.  This cube
 					// surrounds the input point.
-					typename M::Vector4I	x0V = M::floatToIntTruncated( xV );
-					x0V = M::subtract( x0V, M::signToOne( xV ) );
-					typename M::Vector4I	x1V = M::add( x0V, M::constOneI() );
-					typename M::Vector4I	y0V = M::floatToIntTruncated( yV );
-					y0V = M::subtract( y0V, M::signToOne( yV ) );
-					typename M::Vector4I	y1V = M::add( y0V, M::constOneI() );
-					typename M::Vector4I	z0V = M::floatToIntTruncated( zV );
-					z0V = M::subtract( z0V, M::signToOne( zV ) );
-					typename M::Vector4I	z1V = M::add( z0V, M::constOneI() );
+					typename MW::VectorI	x0V = MW::floatToIntTruncated( xV );
+					x0V = MW::subtract( x0V, MW::signToOne( xV ) );
+					typename MW::VectorI	x1V = MW::add( x0V, MW::constOneI() );
+					typename MW::VectorI	y0V = MW::floatToIntTruncated( yV );
+					y0V = MW::subtract( y0V, MW::signToOne( yV ) );
+					typename MW::VectorI	y1V = MW::add( y0V, MW::constOneI() );
+					typename MW::VectorI	z0V = MW::floatToIntTruncated( zV );
+					z0V = MW::subtract( z0V, MW::signToOne( zV ) );
+					typename MW::VectorI	z1V = MW::add( z0V, MW::constOneI() );
 
 					// Map the difference between the coordinates of the input value and the
 					// coordinates of the cube's outer-lower-left vertex onto an S-curve.
-					typename M::Vector4F	xsV = M::subtract( xV, M::intToFloat( x0V ) );
-					typename M::Vector4F	ysV = M::subtract( yV, M::intToFloat( y0V ) );
-					typename M::Vector4F	zsV = M::subtract( zV, M::intToFloat( z0V ) );
+					typename MW::VectorF	xsV = MW::subtract( xV, MW::intToFloat( x0V ) );
+					typename MW::VectorF	ysV = MW::subtract( yV, MW::intToFloat( y0V ) );
+					typename MW::VectorF	zsV = MW::subtract( zV, MW::intToFloat( z0V ) );
 					
 					switch( noiseQuality )
 					{
@@ -690,18 +805,18 @@ namespace noise2
 
 						case QUALITY_STD:
 
-						xsV = Interp::SCurve3V( xsV );
-						ysV = Interp::SCurve3V( ysV );
-						zsV = Interp::SCurve3V( zsV );
+						xsV = InterpW::SCurve3V( xsV );
+						ysV = InterpW::SCurve3V( ysV );
+						zsV = InterpW::SCurve3V( zsV );
 						
 						break;
 
 
 						case QUALITY_BEST:
 
-						xsV = Interp::SCurve5V( xsV );
-						ysV = Interp::SCurve5V( ysV );
-						zsV = Interp::SCurve5V( zsV );
+						xsV = InterpW::SCurve5V( xsV );
+						ysV = InterpW::SCurve5V( ysV );
+						zsV = InterpW::SCurve5V( zsV );
 						
 						break;
 					}
@@ -710,65 +825,181 @@ namespace noise2
 					// the coherent-noise value at the input point, interpolate these eight
 					// noise values using the S-curve value as the interpolant (trilinear
 					// interpolation.)
-					typename M::Vector4F	n0V;
-					typename M::Vector4F	n1V;
-					typename M::Vector4F	ix0V;
-					typename M::Vector4F	ix1V;
-					typename M::Vector4F	iy0V;
-					typename M::Vector4F	iy1V;
+					typename MW::VectorF	n0V;
+					typename MW::VectorF	n1V;
+					typename MW::VectorF	ix0V;
+					typename MW::VectorF	ix1V;
+					typename MW::VectorF	iy0V;
+					typename MW::VectorF	iy1V;
 					
-					n0V = GradientNoise4( xV, yV, zV, x0V, y0V, z0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, x1V, y0V, z0V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, x0V, y1V, z0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, x1V, y1V, z0V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy0V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-
-					n0V = GradientNoise4( xV, yV, zV, x0V, y0V, z1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, x1V, y0V, z1V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, x0V, y1V, z1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, x1V, y1V, z1V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy1V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-
-					return Interp::LinearInterpV( iy0V, iy1V, zsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, x0V, y0V, z0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, x1V, y0V, z0V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, x0V, y1V, z0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, x1V, y1V, z0V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy0V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+
+					n0V = GradientNoiseV< Width >( xV, yV, zV, x0V, y0V, z1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, x1V, y0V, z1V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, x0V, y1V, z1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, x1V, y1V, z1V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy1V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+
+					return InterpW::LinearInterpV( iy0V, iy1V, zsV );
+				}
+
+				// GradientCoherentNoiseV in the plane z = 0. There the cube spans z = -1 to 0 and
+				// the point lies on its upper face, whose S-curve weight is 1, so only the four
+				// corners at z = 0 count; their hash has no z term and their gradients no z
+				// distance.
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientCoherentNoiseSliceV( const typename math::Math< ValueType, Width >::VectorF& xV,
+											 const typename math::Math< ValueType, Width >::VectorF& yV,
+											 const typename math::Math< ValueType, Width >::VectorI& seedV,
+											 NoiseQuality noiseQuality = QUALITY_STD )
+				{
+					typedef math::Math< ValueType, Width >				MW;
+					typedef math::Interpolations< ValueType, Width >	InterpW;
+
+					typename MW::VectorI	x0V = MW::floatToIntTruncated( xV );
+					x0V = MW::subtract( x0V, MW::signToOne( xV ) );
+					typename MW::VectorI	x1V = MW::add( x0V, MW::constOneI() );
+					typename MW::VectorI	y0V = MW::floatToIntTruncated( yV );
+					y0V = MW::subtract( y0V, MW::signToOne( yV ) );
+					typename MW::VectorI	y1V = MW::add( y0V, MW::constOneI() );
+
+					typename MW::VectorF	xsV = MW::subtract( xV, MW::intToFloat( x0V ) );
+					typename MW::VectorF	ysV = MW::subtract( yV, MW::intToFloat( y0V ) );
+
+					switch( noiseQuality )
+					{
+						case QUALITY_FAST:
+
+						// do nothing more
+
+						break;
+
+
+						case QUALITY_STD:
+
+						xsV = InterpW::SCurve3V( xsV );
+						ysV = InterpW::SCurve3V( ysV );
+
+						break;
+
+
+						case QUALITY_BEST:
+
+						xsV = InterpW::SCurve5V( xsV );
+						ysV = InterpW::SCurve5V( ysV );
+
+						break;
+					}
+
+					typename MW::VectorF	n0V;
+					typename MW::VectorF	n1V;
+					typename MW::VectorF	ix0V;
+					typename MW::VectorF	ix1V;
+
+					n0V = GradientNoiseSliceV< Width >( xV, yV, x0V, y0V, seedV );
+					n1V = GradientNoiseSliceV< Width >( xV, yV, x1V, y0V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseSliceV< Width >( xV, yV, x0V, y1V, seedV );
+					n1V = GradientNoiseSliceV< Width >( xV, yV, x1V, y1V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+
+					return InterpW::LinearInterpV( ix0V, ix1V, ysV );
 				}
 
 
 
 			private:
 				
+				template< uint32 Width >
 				static inline
-				typename M::Vector4F
-				GradientNoise4( const typename M::Vector4F& fxV, const typename M::Vector4F& fyV,
-								const typename M::Vector4F& fzV,
-								const typename M::Vector4I& ixV, const typename M::Vector4I& iyV,
-								const typename M::Vector4I& izV,
-								const typename M::Vector4I& seedV )
+				typename math::Math< ValueType, Width >::VectorF
+				GradientNoiseV( const typename math::Math< ValueType, Width >::VectorF& fxV,
+								const typename math::Math< ValueType, Width >::VectorF& fyV,
+								const typename math::Math< ValueType, Width >::VectorF& fzV,
+								const typename math::Math< ValueType, Width >::VectorI& ixV,
+								const typename math::Math< ValueType, Width >::VectorI& iyV,
+								const typename math::Math< ValueType, Width >::VectorI& izV,
+								const typename math::Math< ValueType, Width >::VectorI& seedV )
 				{
-					static VECTOR4_ALIGN( uint32	seedNoiseGenA[ 4 ] ) = { SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	xNoiseGenA[ 4 ] ) = { X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	yNoiseGenA[ 4 ] ) = { Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	zNoiseGenA[ 4 ] ) = { Z_NOISE_GEN, Z_NOISE_GEN, Z_NOISE_GEN, Z_NOISE_GEN };
-					typename M::Vector4I	seedNoiseGenV = M::loadFromMemory( seedNoiseGenA );
-					typename M::Vector4I	xNoiseGenV = M::loadFromMemory( xNoiseGenA );
-					typename M::Vector4I	yNoiseGenV = M::loadFromMemory( yNoiseGenA );
-					typename M::Vector4I	zNoiseGenV = M::loadFromMemory( zNoiseGenA );
+					typedef math::Math< ValueType, Width >		MW;
 
 					// Randomly generate a gradient vector given the integer coordinates of the
 					// input value.  This implementation generates a random number and uses it
 					// as an index into a normalized-vector lookup table.
-					typename M::Vector4I	vectorIndexV = M::multiply( seedNoiseGenV, seedV );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( xNoiseGenV, ixV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( yNoiseGenV, iyV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( zNoiseGenV, izV ) );
+					typename MW::VectorI	vectorIndexV = MW::multiply( MW::vectorizeOne( uint32( SEED_NOISE_GEN ) ), seedV );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( X_NOISE_GEN ) ), ixV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Y_NOISE_GEN ) ), iyV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Z_NOISE_GEN ) ), izV ) );
+
+					vectorIndexV = MW::bitXor( vectorIndexV, MW::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
+					vectorIndexV = MW::bitAnd( vectorIndexV, MW::vectorizeOne( 0xff ) );
+					vectorIndexV = MW::multiply( vectorIndexV, MW::constFourI() );
+
+					typename MW::VectorF	xvGradientV;
+					typename MW::VectorF	yvGradientV;
+					typename MW::VectorF	zvGradientV;
+					gatherGradients( vectorIndexV, xvGradientV, yvGradientV, zvGradientV );
+
+					typename MW::VectorF	xvPointV = MW::subtract( fxV, MW::intToFloat( ixV ) );
+					typename MW::VectorF	yvPointV = MW::subtract( fyV, MW::intToFloat( iyV ) );
+					typename MW::VectorF	zvPointV = MW::subtract( fzV, MW::intToFloat( izV ) );
+
+					typename MW::VectorF	nV = MW::multiply( xvGradientV, xvPointV );
+					nV = MW::add( nV, MW::multiply( yvGradientV, yvPointV ) );
+					nV = MW::add( nV, MW::multiply( zvGradientV, zvPointV ) );
+					return MW::multiply( nV, MW::vectorizeOne( ValueType( 2.12 ) ) );
+				}
+
+				// GradientNoiseV of a corner at z = 0 for a point at z = 0
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientNoiseSliceV( const typename math::Math< ValueType, Width >::VectorF& fxV,
+									 const typename math::Math< ValueType, Width >::VectorF& fyV,
+									 const typename math::Math< ValueType, Width >::VectorI& ixV,
+									 const typename math::Math< ValueType, Width >::VectorI& iyV,
+									 const typename math::Math< ValueType, Width >::VectorI& seedV )
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorI	vectorIndexV = MW::multiply( MW::vectorizeOne( uint32( SEED_NOISE_GEN ) ), seedV );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( X_NOISE_GEN ) ), ixV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Y_NOISE_GEN ) ), iyV ) );
+
+					vectorIndexV = MW::bitXor( vectorIndexV, MW::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
+					vectorIndexV = MW::bitAnd( vectorIndexV, MW::vectorizeOne( 0xff ) );
+					vectorIndexV = MW::multiply( vectorIndexV, MW::constFourI() );
+
+					// The z gradients are not used, the compiler drops their gather
+					typename MW::VectorF	xvGradientV;
+					typename MW::VectorF	yvGradientV;
+					typename MW::VectorF	zvGradientV;
+					gatherGradients( vectorIndexV, xvGradientV, yvGradientV, zvGradientV );
 
-					vectorIndexV = M::bitXor( vectorIndexV, M::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
-					vectorIndexV = M::bitAnd( vectorIndexV, M::vectorizeOne( 0xff ) );
-					vectorIndexV = M::multiply( vectorIndexV, M::constFourI() );
+					typename MW::VectorF	xvPointV = MW::subtract( fxV, MW::intToFloat( ixV ) );
+					typename MW::VectorF	yvPointV = MW::subtract( fyV, MW::intToFloat( iyV ) );
 
+					typename MW::VectorF	nV = MW::multiply( xvGradientV, xvPointV );
+					nV = MW::add( nV, MW::multiply( yvGradientV, yvPointV ) );
+					return MW::multiply( nV, MW::vectorizeOne( ValueType( 2.12 ) ) );
+				}
+
+				// Loads the four table rows and transposes them into x, y and z vectors
+				static inline
+				void
+				gatherGradients( const typename M::Vector4I& vectorIndexV, typename M::Vector4F& xvGradientV,
+								 typename M::Vector4F& yvGradientV, typename M::Vector4F& zvGradientV )
+				{
 					VECTOR4_ALIGN( uint32	vectorIndexA[ 4 ] );
 					M::storeToMemory( vectorIndexA, vectorIndexV );
 
@@ -778,21 +1009,42 @@ namespace noise2
 					typename M::Vector4F	g4 = M::loadFromMemory( Table::values() + vectorIndexA[ 3 ] );
 					typename M::Vector4F	gx1x2y1y2 = M::interleaveLo( g1, g2 );
 					typename M::Vector4F	gx3x4y3y4 = M::interleaveLo( g3, g4 );
-					typename M::Vector4F	xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
-					typename M::Vector4F	yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
+					xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
+					yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
 					typename M::Vector4F	gz1z2____ = M::interleaveHi( g1, g2 );
 					typename M::Vector4F	gz3z4____ = M::interleaveHi( g3, g4 );
-					typename M::Vector4F	zvGradientV = M::template shuffle< 0, 1, 0, 1 >( gz1z2____, gz3z4____ );
+					zvGradientV = M::template shuffle< 0, 1, 0, 1 >( gz1z2____, gz3z4____ );
+				}
+
+				// Wider vectors gather part by part
+				template< typename VectorI, typename VectorF >
+				static inline
+				void
+				gatherGradients( const VectorI& vectorIndexV, VectorF& xvGradientV,
+								 VectorF& yvGradientV, VectorF& zvGradientV )
+				{
+					const uint32	partCount = sizeof( vectorIndexV.part ) / sizeof( vectorIndexV.part[ 0 ] );
 
-					typename M::Vector4F	xvPointV = M::subtract( fxV, M::intToFloat( ixV ) );
-					typename M::Vector4F	yvPointV = M::subtract( fyV, M::intToFloat( iyV ) );
-					typename M::Vector4F	zvPointV = M::subtract( fzV, M::intToFloat( izV ) );
+					for( uint32 p = 0; p < partCount; ++p )
+					{
+						gatherGradients( vectorIndexV.part[ p ], xvGradientV.part[ p ], yvGradientV.part[ p ], zvGradientV.part[ p ] );
+					}
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+				// Native eight lane float gathers the table columns directly
+				static inline
+				void
+				gatherGradients( const __m256i& vectorIndexV, __m256& xvGradientV,
+								 __m256& yvGradientV, __m256& zvGradientV )
+				{
+					typedef math::Math< ValueType, 8 >		M8;
 
-					typename M::Vector4F	nV = M::multiply( xvGradientV, xvPointV );
-					nV = M::add( nV, M::multiply( yvGradientV, yvPointV ) );
-					nV = M::add( nV, M::multiply( zvGradientV, zvPointV ) );
-					return M::multiply( nV, M::vectorizeOne( ValueType( 2.12 ) ) );
+					xvGradientV = M8::gather( Table::values(), vectorIndexV );
+					yvGradientV = M8::gather( Table::values() + 1, vectorIndexV );
+					zvGradientV = M8::gather( Table::values() + 2, vectorIndexV );
 				}
+#endif
 
 			};
 
@@ -1003,27 +1255,44 @@ namespace noise2
 										const typename M::Vector4F& zV, const typename M::Vector4F& wV,
 										const typename M::Vector4I& seedV, NoiseQuality noiseQuality = QUALITY_STD )
 				{
+					return GradientCoherentNoiseV< 4 >( xV, yV, zV, wV, seedV, noiseQuality );
+				}
+
+				// Any multiple of four lanes, see math::Math_Wide
+				template< uint32 Width >
+				static inline
+				typename math::Math< ValueType, Width >::VectorF
+				GradientCoherentNoiseV( const typename math::Math< ValueType, Width >::VectorF& xV,
+										const typename math::Math< ValueType, Width >::VectorF& yV,
+										const typename math::Math< ValueType, Width >::VectorF& zV,
+										const typename math::Math< ValueType, Width >::VectorF& wV,
+										const typename math::Math< ValueType, Width >::VectorI& seedV,
+										NoiseQuality noiseQuality = QUALITY_STD )
+				{
+					typedef math::Math< ValueType, Width >				MW;
+					typedef math::Interpolations< ValueType, Width >	InterpW;
+
 					// Create a unit-length cube aligned along an integer boundary.  This cube
 					// surrounds the input point.
-					typename M::Vector4I	x0V = M::floatToIntTruncated( xV );
-					x0V = M::subtract( x0V, M::signToOne( xV ) );
-					typename M::Vector4I	x1V = M::add( x0V, M::constOneI() );
-					typename M::Vector4I	y0V = M::floatToIntTruncated( yV );
-					y0V = M::subtract( y0V, M::signToOne( yV ) );
-					typename M::Vector4I	y1V = M::add( y0V, M::constOneI() );
-					typename M::Vector4I	z0V = M::floatToIntTruncated( zV );
-					z0V = M::subtract( z0V, M::signToOne( zV ) );
-					typename M::Vector4I	z1V = M::add( z0V, M::constOneI() );
-					typename M::Vector4I	w0V = M::floatToIntTruncated( wV );
-					w0V = M::subtract( w0V, M::signToOne( wV ) );
-					typename M::Vector4I	w1V = M::add( w0V, M::constOneI() );
+					typename MW::VectorI	x0V = MW::floatToIntTruncated( xV );
+					x0V = MW::subtract( x0V, MW::signToOne( xV ) );
+					typename MW::VectorI	x1V = MW::add( x0V, MW::constOneI() );
+					typename MW::VectorI	y0V = MW::floatToIntTruncated( yV );
+					y0V = MW::subtract( y0V, MW::signToOne( yV ) );
+					typename MW::VectorI	y1V = MW::add( y0V, MW::constOneI() );
+					typename MW::VectorI	z0V = MW::floatToIntTruncated( zV );
+					z0V = MW::subtract( z0V, MW::signToOne( zV ) );
+					typename MW::VectorI	z1V = MW::add( z0V, MW::constOneI() );
+					typename MW::VectorI	w0V = MW::floatToIntTruncated( wV );
+					w0V = MW::subtract( w0V, MW::signToOne( wV ) );
+					typename MW::VectorI	w1V = MW::add( w0V, MW::constOneI() );
 
 					// Map the difference between the coordinates of the input value and the
 					// coordinates of the cube's outer-lower-left vertex onto an S-curve.
-					typename M::Vector4F	xsV = M::subtract( xV, M::intToFloat( x0V ) );
-					typename M::Vector4F	ysV = M::subtract( yV, M::intToFloat( y0V ) );
-					typename M::Vector4F	zsV = M::subtract( zV, M::intToFloat( z0V ) );
-					typename M::Vector4F	wsV = M::subtract( wV, M::intToFloat( w0V ) );
+					typename MW::VectorF	xsV = MW::subtract( xV, MW::intToFloat( x0V ) );
+					typename MW::VectorF	ysV = MW::subtract( yV, MW::intToFloat( y0V ) );
+					typename MW::VectorF	zsV = MW::subtract( zV, MW::intToFloat( z0V ) );
+					typename MW::VectorF	wsV = MW::subtract( wV, MW::intToFloat( w0V ) );
 					
 					switch( noiseQuality )
 					{
@@ -1036,20 +1305,20 @@ namespace noise2
 
 						case QUALITY_STD:
 
-						xsV = Interp::SCurve3V( xsV );
-						ysV = Interp::SCurve3V( ysV );
-						zsV = Interp::SCurve3V( zsV );
-						wsV = Interp::SCurve3V( wsV );
+						xsV = InterpW::SCurve3V( xsV );
+						ysV = InterpW::SCurve3V( ysV );
+						zsV = InterpW::SCurve3V( zsV );
+						wsV = InterpW::SCurve3V( wsV );
 						
 						break;
 
 
 						case QUALITY_BEST:
 
-						xsV = Interp::SCurve5V( xsV );
-						ysV = Interp::SCurve5V( ysV );
-						zsV = Interp::SCurve5V( zsV );
-						wsV = Interp::SCurve5V( wsV );
+						xsV = InterpW::SCurve5V( xsV );
+						ysV = InterpW::SCurve5V( ysV );
+						zsV = InterpW::SCurve5V( zsV );
+						wsV = InterpW::SCurve5V( wsV );
 						
 						break;
 					}
@@ -1058,88 +1327,109 @@ namespace noise2
 					// the coherent-noise value at the input point, interpolate these eight
 					// noise values using the S-curve value as the interpolant (trilinear
 					// interpolation.)
-					typename M::Vector4F	n0V;
-					typename M::Vector4F	n1V;
-					typename M::Vector4F	ix0V;
-					typename M::Vector4F	ix1V;
-					typename M::Vector4F	iy0V;
-					typename M::Vector4F	iy1V;
-					typename M::Vector4F	iz0V;
-					typename M::Vector4F	iz1V;
+					typename MW::VectorF	n0V;
+					typename MW::VectorF	n1V;
+					typename MW::VectorF	ix0V;
+					typename MW::VectorF	ix1V;
+					typename MW::VectorF	iy0V;
+					typename MW::VectorF	iy1V;
+					typename MW::VectorF	iz0V;
+					typename MW::VectorF	iz1V;
 					
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y0V, z0V, w0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y0V, z0V, w0V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y1V, z0V, w0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y1V, z0V, w0V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy0V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y0V, z1V, w0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y0V, z1V, w0V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y1V, z1V, w0V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y1V, z1V, w0V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy1V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-					iz0V = Interp::LinearInterpV( iy0V, iy1V, zsV );
-
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y0V, z0V, w1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y0V, z0V, w1V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y1V, z0V, w1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y1V, z0V, w1V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy0V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y0V, z1V, w1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y0V, z1V, w1V, seedV );
-					ix0V = Interp::LinearInterpV( n0V, n1V, xsV );
-					n0V = GradientNoise4( xV, yV, zV, wV, x0V, y1V, z1V, w1V, seedV );
-					n1V = GradientNoise4( xV, yV, zV, wV, x1V, y1V, z1V, w1V, seedV );
-					ix1V = Interp::LinearInterpV( n0V, n1V, xsV );
-					iy1V = Interp::LinearInterpV( ix0V, ix1V, ysV );
-					iz1V = Interp::LinearInterpV( iy0V, iy1V, zsV );
-
-					return Interp::LinearInterpV( iz0V, iz1V, wsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y0V, z0V, w0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y0V, z0V, w0V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y1V, z0V, w0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y1V, z0V, w0V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy0V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y0V, z1V, w0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y0V, z1V, w0V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y1V, z1V, w0V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y1V, z1V, w0V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy1V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+					iz0V = InterpW::LinearInterpV( iy0V, iy1V, zsV );
+
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y0V, z0V, w1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y0V, z0V, w1V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y1V, z0V, w1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y1V, z0V, w1V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy0V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y0V, z1V, w1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y0V, z1V, w1V, seedV );
+					ix0V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					n0V = GradientNoiseV< Width >( xV, yV, zV, wV, x0V, y1V, z1V, w1V, seedV );
+					n1V = GradientNoiseV< Width >( xV, yV, zV, wV, x1V, y1V, z1V, w1V, seedV );
+					ix1V = InterpW::LinearInterpV( n0V, n1V, xsV );
+					iy1V = InterpW::LinearInterpV( ix0V, ix1V, ysV );
+					iz1V = InterpW::LinearInterpV( iy0V, iy1V, zsV );
+
+					return InterpW::LinearInterpV( iz0V, iz1V, wsV );
 				}
 
 
 
 			private:
 				
+				template< uint32 Width >
 				static inline
-				typename M::Vector4F
-				GradientNoise4( const typename M::Vector4F& fxV, const typename M::Vector4F& fyV,
-								const typename M::Vector4F& fzV, const typename M::Vector4F& fwV,
-								const typename M::Vector4I& ixV, const typename M::Vector4I& iyV,
-								const typename M::Vector4I& izV, const typename M::Vector4I& iwV,
-								const typename M::Vector4I& seedV )
+				typename math::Math< ValueType, Width >::VectorF
+				GradientNoiseV( const typename math::Math< ValueType, Width >::VectorF& fxV,
+								const typename math::Math< ValueType, Width >::VectorF& fyV,
+								const typename math::Math< ValueType, Width >::VectorF& fzV,
+								const typename math::Math< ValueType, Width >::VectorF& fwV,
+								const typename math::Math< ValueType, Width >::VectorI& ixV,
+								const typename math::Math< ValueType, Width >::VectorI& iyV,
+								const typename math::Math< ValueType, Width >::VectorI& izV,
+								const typename math::Math< ValueType, Width >::VectorI& iwV,
+								const typename math::Math< ValueType, Width >::VectorI& seedV )
 				{
-					static VECTOR4_ALIGN( uint32	seedNoiseGenA[ 4 ] ) = { SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN, SEED_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	xNoiseGenA[ 4 ] ) = { X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN, X_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	yNoiseGenA[ 4 ] ) = { Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN, Y_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	zNoiseGenA[ 4 ] ) = { Z_NOISE_GEN, Z_NOISE_GEN, Z_NOISE_GEN, Z_NOISE_GEN };
-					static VECTOR4_ALIGN( uint32	wNoiseGenA[ 4 ] ) = { W_NOISE_GEN, W_NOISE_GEN, W_NOISE_GEN, W_NOISE_GEN };
-					typename M::Vector4I	seedNoiseGenV = M::loadFromMemory( seedNoiseGenA );
-					typename M::Vector4I	xNoiseGenV = M::loadFromMemory( xNoiseGenA );
-					typename M::Vector4I	yNoiseGenV = M::loadFromMemory( yNoiseGenA );
-					typename M::Vector4I	zNoiseGenV = M::loadFromMemory( zNoiseGenA );
-					typename M::Vector4I	wNoiseGenV = M::loadFromMemory( wNoiseGenA );
+					typedef math::Math< ValueType, Width >		MW;
 
 					// Randomly generate a gradient vector given the integer coordinates of the
 					// input value.  This implementation generates a random number and uses it
 					// as an index into a normalized-vector lookup table.
-					typename M::Vector4I	vectorIndexV = M::multiply( seedNoiseGenV, seedV );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( xNoiseGenV, ixV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( yNoiseGenV, iyV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( zNoiseGenV, izV ) );
-					vectorIndexV = M::add( vectorIndexV, M::multiply( wNoiseGenV, iwV ) );
-
-					vectorIndexV = M::bitXor( vectorIndexV, M::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
-					vectorIndexV = M::bitAnd( vectorIndexV, M::vectorizeOne( 0xff ) );
-					vectorIndexV = M::multiply( vectorIndexV, M::constFourI() );
+					typename MW::VectorI	vectorIndexV = MW::multiply( MW::vectorizeOne( uint32( SEED_NOISE_GEN ) ), seedV );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( X_NOISE_GEN ) ), ixV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Y_NOISE_GEN ) ), iyV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( Z_NOISE_GEN ) ), izV ) );
+					vectorIndexV = MW::add( vectorIndexV, MW::multiply( MW::vectorizeOne( uint32( W_NOISE_GEN ) ), iwV ) );
+
+					vectorIndexV = MW::bitXor( vectorIndexV, MW::shiftRightLogical( vectorIndexV, SHIFT_NOISE_GEN ) );
+					vectorIndexV = MW::bitAnd( vectorIndexV, MW::vectorizeOne( 0xff ) );
+					vectorIndexV = MW::multiply( vectorIndexV, MW::constFourI() );
+
+					typename MW::VectorF	xvGradientV;
+					typename MW::VectorF	yvGradientV;
+					typename MW::VectorF	zvGradientV;
+					typename MW::VectorF	wvGradientV;
+					gatherGradients( vectorIndexV, xvGradientV, yvGradientV, zvGradientV, wvGradientV );
+
+					typename MW::VectorF	xvPointV = MW::subtract( fxV, MW::intToFloat( ixV ) );
+					typename MW::VectorF	yvPointV = MW::subtract( fyV, MW::intToFloat( iyV ) );
+					typename MW::VectorF	zvPointV = MW::subtract( fzV, MW::intToFloat( izV ) );
+					typename MW::VectorF	wvPointV = MW::subtract( fwV, MW::intToFloat( iwV ) );
+
+					typename MW::VectorF	nV = MW::multiply( xvGradientV, xvPointV );
+					nV = MW::add( nV, MW::multiply( yvGradientV, yvPointV ) );
+					nV = MW::add( nV, MW::multiply( zvGradientV, zvPointV ) );
+					nV = MW::add( nV, MW::multiply( wvGradientV, wvPointV ) );
+					return MW::multiply( nV, MW::vectorizeOne( ValueType( 2.12 ) ) );
+				}
 
+				// Loads the four table rows and transposes them into x, y, z and w vectors
+				static inline
+				void
+				gatherGradients( const typename M::Vector4I& vectorIndexV, typename M::Vector4F& xvGradientV,
+								 typename M::Vector4F& yvGradientV, typename M::Vector4F& zvGradientV,
+								 typename M::Vector4F& wvGradientV )
+				{
 					VECTOR4_ALIGN( uint32	vectorIndexA[ 4 ] );
 					M::storeToMemory( vectorIndexA, vectorIndexV );
 
@@ -1149,24 +1439,44 @@ namespace noise2
 					typename M::Vector4F	g4 = M::loadFromMemory( Table::values() + vectorIndexA[ 3 ] );
 					typename M::Vector4F	gx1x2y1y2 = M::interleaveLo( g1, g2 );
 					typename M::Vector4F	gx3x4y3y4 = M::interleaveLo( g3, g4 );
-					typename M::Vector4F	xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
-					typename M::Vector4F	yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
+					xvGradientV = M::template shuffle< 0, 1, 0, 1 >( gx1x2y1y2, gx3x4y3y4 );
+					yvGradientV = M::template shuffle< 2, 3, 2, 3 >( gx1x2y1y2, gx3x4y3y4 );
 					typename M::Vector4F	gz1z2w1w2 = M::interleaveHi( g1, g2 );
 					typename M::Vector4F	gz3z4w3w4 = M::interleaveHi( g3, g4 );
-					typename M::Vector4F	zvGradientV = M::template shuffle< 0, 1, 0, 1 >( gz1z2w1w2, gz3z4w3w4 );
-					typename M::Vector4F	wvGradientV = M::template shuffle< 2, 3, 2, 3 >( gz1z2w1w2, gz3z4w3w4 );
-
-					typename M::Vector4F	xvPointV = M::subtract( fxV, M::intToFloat( ixV ) );
-					typename M::Vector4F	yvPointV = M::subtract( fyV, M::intToFloat( iyV ) );
-					typename M::Vector4F	zvPointV = M::subtract( fzV, M::intToFloat( izV ) );
-					typename M::Vector4F	wvPointV = M::subtract( fwV, M::intToFloat( iwV ) );
-
-					typename M::Vector4F	nV = M::multiply( xvGradientV, xvPointV );
-					nV = M::add( nV, M::multiply( yvGradientV, yvPointV ) );
-					nV = M::add( nV, M::multiply( zvGradientV, zvPointV ) );
-					nV = M::add( nV, M::multiply( wvGradientV, wvPointV ) );
-					return M::multiply( nV, M::vectorizeOne( ValueType( 2.12 ) ) );
+					zvGradientV = M::template shuffle< 0, 1, 0, 1 >( gz1z2w1w2, gz3z4w3w4 );
+					wvGradientV = M::template shuffle< 2, 3, 2, 3 >( gz1z2w1w2, gz3z4w3w4 );
+				}
+
+				// Wider vectors gather part by part
+				template< typename VectorI, typename VectorF >
+				static inline
+				void
+				gatherGradients( const VectorI& vectorIndexV, VectorF& xvGradientV, VectorF& yvGradientV,
+								 VectorF& zvGradientV, VectorF& wvGradientV )
+				{
+					const uint32	partCount = sizeof( vectorIndexV.part ) / sizeof( vectorIndexV.part[ 0 ] );
+
+					for( uint32 p = 0; p < partCount; ++p )
+					{
+						gatherGradients( vectorIndexV.part[ p ], xvGradientV.part[ p ], yvGradientV.part[ p ], zvGradientV.part[ p ], wvGradientV.part[ p ] );
+					}
+				}
+
+#if defined( LIBNOISE2_AT_LEAST_AVX2 )
+				// Native eight lane float gathers the table columns directly
+				static inline
+				void
+				gatherGradients( const __m256i& vectorIndexV, __m256& xvGradientV, __m256& yvGradientV,
+								 __m256& zvGradientV, __m256& wvGradientV )
+				{
+					typedef math::Math< ValueType, 8 >		M8;
+
+					xvGradientV = M8::gather( Table::values(), vectorIndexV );
+					yvGradientV = M8::gather( Table::values() + 1, vectorIndexV );
+					zvGradientV = M8::gather( Table::values() + 2, vectorIndexV );
+					wvGradientV = M8::gather( Table::values() + 3, vectorIndexV );
 				}
+#endif
 
 			};
 
@@ -84,41 +84,87 @@ namespace noise2
 					return value;
 				}
 
+				virtual
+				void
+				GetValue4( const ValueType* inputX, ValueType* output ) const
+				{
+					GetValueV< 4 >( inputX, output );
+				}
+
+				// Native width points at a time, the rest padded to a full vector so that all
+				// points go through the same kernel
+				virtual
 				void
-				GetValue4( const ValueType* inputX, ValueType* output )
+				GetValueArray( const ValueType* inputX, ValueType* output, size_t count ) const
 				{
-					typename M::Vector4F	xV = M::loadFromMemory( inputX );
+					const uint32	Width = math::NativeWidth< ValueType >::Value;
+					size_t			i = 0;
 
-					typename M::Vector4F	frequencyV = M::vectorizeOne( this->GetFrequency() );
-					typename M::Vector4F	lacunarityV = M::vectorizeOne( this->GetLacunarity() );
+					for( ; i + Width <= count; i += Width )
+					{
+						GetValueV< Width >( inputX + i, output + i );
+					}
+
+					if( i < count )
+					{
+						VECTOR4_ALIGN( ValueType	x[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	values[ Width ] );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							x[ k - i ] = inputX[ k ];
+						}
+
+						GetValueV< Width >( x, values );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							output[ k ] = values[ k - i ];
+						}
+					}
+				}
+
+				// Width points at once, Width a multiple of four, see math::Math
+				template< uint32 Width >
+				void
+				GetValueV( const ValueType* inputX, ValueType* output ) const
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorF	xV = MW::loadFromMemory( inputX );
+
+					typename MW::VectorF	frequencyV = MW::vectorizeOne( this->GetFrequency() );
+					typename MW::VectorF	lacunarityV = MW::vectorizeOne( this->GetLacunarity() );
 					uint32					octaveCount = this->GetOctaveCount();
-					typename M::Vector4F	persistenceV = M::vectorizeOne( this->GetPersistence() );
-					typename M::Vector4I	seedV = M::vectorizeOne( this->GetSeed() );
+					typename MW::VectorF	persistenceV = MW::vectorizeOne( this->GetPersistence() );
+					typename MW::VectorI	seedV = MW::vectorizeOne( this->GetSeed() );
 					NoiseQuality			noiseQuality = this->GetNoiseQuality();
 
-					typename M::Vector4F	valueV = M::constZeroF();
-					typename M::Vector4F	signalV = M::constZeroF();
-					typename M::Vector4F	curPersistenceV = M::constOneF();
-					typename M::Vector4F	nxV;
+					typename MW::VectorF	valueV = MW::constZeroF();
+					typename MW::VectorF	signalV = MW::constZeroF();
+					typename MW::VectorF	curPersistenceV = MW::constOneF();
+					typename MW::VectorF	nxV;
 					
+					xV = MW::multiply( xV, frequencyV );
+
 					for( uint32 curOctave = 0; curOctave < octaveCount; curOctave++ ) 
 					{
 						// Make sure that these floating-point values have the same range as a 32-
 						// bit integer so that we can pass them to the coherent-noise functions.
-						nxV = M::makeInt32Range( xV );
+						nxV = MW::makeInt32Range( xV );
 						
 						// Get the coherent-noise value from the input value and add it to the
 						// final result.
-						signalV = Noise::GradientCoherentNoise4( nxV, seedV, noiseQuality );
-						valueV = M::add( valueV, M::multiply( signalV, curPersistenceV ) );
+						signalV = Noise::template GradientCoherentNoiseV< Width >( nxV, seedV, noiseQuality );
+						valueV = MW::add( valueV, MW::multiply( signalV, curPersistenceV ) );
 
 						// Prepare the next octave.
-						xV = M::multiply( xV, lacunarityV );
-						curPersistenceV = M::multiply( curPersistenceV, persistenceV );
-						seedV = M::add( seedV, M::constOneI() );
+						xV = MW::multiply( xV, lacunarityV );
+						curPersistenceV = MW::multiply( curPersistenceV, persistenceV );
+						seedV = MW::add( seedV, MW::constOneI() );
 					}
 
-					M::storeToMemory( output, valueV );
+					MW::storeToMemory( output, valueV );
 				}
 
 			};
@@ -193,45 +239,94 @@ namespace noise2
 					return value;
 				}
 
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+				{
+					GetValueV< 4 >( inputX, inputY, output );
+				}
+
+				// Native width points at a time, the rest padded to a full vector so that all
+				// points go through the same kernel
+				virtual
 				void
-				GetValue4( const ValueType* inputX, const ValueType* inputY, ValueType* output )
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
 				{
-					typename M::Vector4F	xV = M::loadFromMemory( inputX );
-					typename M::Vector4F	yV = M::loadFromMemory( inputY );
+					const uint32	Width = math::NativeWidth< ValueType >::Value;
+					size_t			i = 0;
 
-					typename M::Vector4F	frequencyV = M::vectorizeOne( this->GetFrequency() );
-					typename M::Vector4F	lacunarityV = M::vectorizeOne( this->GetLacunarity() );
+					for( ; i + Width <= count; i += Width )
+					{
+						GetValueV< Width >( inputX + i, inputY + i, output + i );
+					}
+
+					if( i < count )
+					{
+						VECTOR4_ALIGN( ValueType	x[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	y[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	values[ Width ] );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							x[ k - i ] = inputX[ k ];
+							y[ k - i ] = inputY[ k ];
+						}
+
+						GetValueV< Width >( x, y, values );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							output[ k ] = values[ k - i ];
+						}
+					}
+				}
+
+				// Width points at once, Width a multiple of four, see math::Math
+				template< uint32 Width >
+				void
+				GetValueV( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorF	xV = MW::loadFromMemory( inputX );
+					typename MW::VectorF	yV = MW::loadFromMemory( inputY );
+
+					typename MW::VectorF	frequencyV = MW::vectorizeOne( this->GetFrequency() );
+					typename MW::VectorF	lacunarityV = MW::vectorizeOne( this->GetLacunarity() );
 					uint32					octaveCount = this->GetOctaveCount();
-					typename M::Vector4F	persistenceV = M::vectorizeOne( this->GetPersistence() );
-					typename M::Vector4I	seedV = M::vectorizeOne( this->GetSeed() );
+					typename MW::VectorF	persistenceV = MW::vectorizeOne( this->GetPersistence() );
+					typename MW::VectorI	seedV = MW::vectorizeOne( this->GetSeed() );
 					NoiseQuality			noiseQuality = this->GetNoiseQuality();
 
-					typename M::Vector4F	valueV = M::constZeroF();
-					typename M::Vector4F	signalV = M::constZeroF();
-					typename M::Vector4F	curPersistenceV = M::constOneF();
-					typename M::Vector4F	nxV;
-					typename M::Vector4F	nyV;
+					typename MW::VectorF	valueV = MW::constZeroF();
+					typename MW::VectorF	signalV = MW::constZeroF();
+					typename MW::VectorF	curPersistenceV = MW::constOneF();
+					typename MW::VectorF	nxV;
+					typename MW::VectorF	nyV;
+
+					xV = MW::multiply( xV, frequencyV );
+					yV = MW::multiply( yV, frequencyV );
 
 					for( uint32 curOctave = 0; curOctave < octaveCount; curOctave++ ) 
 					{
 						// Make sure that these floating-point values have the same range as a 32-
 						// bit integer so that we can pass them to the coherent-noise functions.
-						nxV = M::makeInt32Range( xV );
-						nyV = M::makeInt32Range( yV );
+						nxV = MW::makeInt32Range( xV );
+						nyV = MW::makeInt32Range( yV );
 						
 						// Get the coherent-noise value from the input value and add it to the
 						// final result.
-						signalV = Noise::GradientCoherentNoise4( nxV, nyV, seedV, noiseQuality );
-						valueV = M::add( valueV, M::multiply( signalV, curPersistenceV ) );
+						signalV = Noise::template GradientCoherentNoiseV< Width >( nxV, nyV, seedV, noiseQuality );
+						valueV = MW::add( valueV, MW::multiply( signalV, curPersistenceV ) );
 
 						// Prepare the next octave.
-						xV = M::multiply( xV, lacunarityV );
-						yV = M::multiply( yV, lacunarityV );
-						curPersistenceV = M::multiply( curPersistenceV, persistenceV );
-						seedV = M::add( seedV, M::constOneI() );
+						xV = MW::multiply( xV, lacunarityV );
+						yV = MW::multiply( yV, lacunarityV );
+						curPersistenceV = MW::multiply( curPersistenceV, persistenceV );
+						seedV = MW::add( seedV, MW::constOneI() );
 					}
 
-					M::storeToMemory( output, valueV );
+					MW::storeToMemory( output, valueV );
 				}
 
 			};
@@ -306,49 +401,197 @@ namespace noise2
 					return value;
 				}
 
+				virtual
+				void
+				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
+				{
+					GetValueV< 4 >( inputX, inputY, inputZ, output );
+				}
+
+				// Native width points at a time, the rest padded to a full vector so that all
+				// points go through the same kernel
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output,
+							   size_t count ) const
+				{
+					const uint32	Width = math::NativeWidth< ValueType >::Value;
+					size_t			i = 0;
+
+					for( ; i + Width <= count; i += Width )
+					{
+						GetValueV< Width >( inputX + i, inputY + i, inputZ + i, output + i );
+					}
+
+					if( i < count )
+					{
+						VECTOR4_ALIGN( ValueType	x[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	y[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	z[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	values[ Width ] );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							x[ k - i ] = inputX[ k ];
+							y[ k - i ] = inputY[ k ];
+							z[ k - i ] = inputZ[ k ];
+						}
+
+						GetValueV< Width >( x, y, z, values );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							output[ k ] = values[ k - i ];
+						}
+					}
+				}
+
+				// Width points at once, Width a multiple of four, see math::Math
+				template< uint32 Width >
 				void
-				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output )
+				GetValueV( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, ValueType* output ) const
 				{
-					typename M::Vector4F	xV = M::loadFromMemory( inputX );
-					typename M::Vector4F	yV = M::loadFromMemory( inputY );
-					typename M::Vector4F	zV = M::loadFromMemory( inputZ );
+					typedef math::Math< ValueType, Width >		MW;
+
+					MW::storeToMemory( output, GetValueVector< Width >( MW::loadFromMemory( inputX ), MW::loadFromMemory( inputY ),
+																		MW::loadFromMemory( inputZ ) ) );
+				}
 
-					typename M::Vector4F	frequencyV = M::vectorizeOne( this->GetFrequency() );
-					typename M::Vector4F	lacunarityV = M::vectorizeOne( this->GetLacunarity() );
+				// GetValueV on values already in registers, used by expression::Kernel
+				template< uint32 Width >
+				typename math::Math< ValueType, Width >::VectorF
+				GetValueVector( typename math::Math< ValueType, Width >::VectorF xV, typename math::Math< ValueType, Width >::VectorF yV,
+								typename math::Math< ValueType, Width >::VectorF zV ) const
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorF	frequencyV = MW::vectorizeOne( this->GetFrequency() );
+					typename MW::VectorF	lacunarityV = MW::vectorizeOne( this->GetLacunarity() );
+					uint32					octaveCount = this->GetOctaveCount();
+					typename MW::VectorF	persistenceV = MW::vectorizeOne( this->GetPersistence() );
+					typename MW::VectorI	seedV = MW::vectorizeOne( this->GetSeed() );
+					NoiseQuality			noiseQuality = this->GetNoiseQuality();
+
+					typename MW::VectorF	valueV = MW::constZeroF();
+					typename MW::VectorF	signalV = MW::constZeroF();
+					typename MW::VectorF	curPersistenceV = MW::constOneF();
+					typename MW::VectorF	nxV;
+					typename MW::VectorF	nyV;
+					typename MW::VectorF	nzV;
+
+					xV = MW::multiply( xV, frequencyV );
+					yV = MW::multiply( yV, frequencyV );
+					zV = MW::multiply( zV, frequencyV );
+
+					for( uint32 curOctave = 0; curOctave < octaveCount; curOctave++ ) 
+					{
+						// Make sure that these floating-point values have the same range as a 32-
+						// bit integer so that we can pass them to the coherent-noise functions.
+						nxV = MW::makeInt32Range( xV );
+						nyV = MW::makeInt32Range( yV );
+						nzV = MW::makeInt32Range( zV );
+						
+						// Get the coherent-noise value from the input value and add it to the
+						// final result.
+						signalV = Noise::template GradientCoherentNoiseV< Width >( nxV, nyV, nzV, seedV, noiseQuality );
+						valueV = MW::add( valueV, MW::multiply( signalV, curPersistenceV ) );
+
+						// Prepare the next octave.
+						xV = MW::multiply( xV, lacunarityV );
+						yV = MW::multiply( yV, lacunarityV );
+						zV = MW::multiply( zV, lacunarityV );
+						curPersistenceV = MW::multiply( curPersistenceV, persistenceV );
+						seedV = MW::add( seedV, MW::constOneI() );
+					}
+
+					return valueV;
+				}
+
+				// GetValueArray in the plane z = 0, on the slice kernel of NoiseGen, used by
+				// DimensionAdapter
+				void
+				GetSliceValueArray( const ValueType* inputX, const ValueType* inputY, ValueType* output, size_t count ) const
+				{
+					const uint32	Width = math::NativeWidth< ValueType >::Value;
+					size_t			i = 0;
+
+					for( ; i + Width <= count; i += Width )
+					{
+						GetSliceValueV< Width >( inputX + i, inputY + i, output + i );
+					}
+
+					if( i < count )
+					{
+						VECTOR4_ALIGN( ValueType	x[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	y[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	values[ Width ] );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							x[ k - i ] = inputX[ k ];
+							y[ k - i ] = inputY[ k ];
+						}
+
+						GetSliceValueV< Width >( x, y, values );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							output[ k ] = values[ k - i ];
+						}
+					}
+				}
+
+				template< uint32 Width >
+				void
+				GetSliceValueV( const ValueType* inputX, const ValueType* inputY, ValueType* output ) const
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					MW::storeToMemory( output, GetSliceValueVector< Width >( MW::loadFromMemory( inputX ), MW::loadFromMemory( inputY ) ) );
+				}
+
+				template< uint32 Width >
+				typename math::Math< ValueType, Width >::VectorF
+				GetSliceValueVector( typename math::Math< ValueType, Width >::VectorF xV, typename math::Math< ValueType, Width >::VectorF yV ) const
+				{
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorF	frequencyV = MW::vectorizeOne( this->GetFrequency() );
+					typename MW::VectorF	lacunarityV = MW::vectorizeOne( this->GetLacunarity() );
 					uint32					octaveCount = this->GetOctaveCount();
-					typename M::Vector4F	persistenceV = M::vectorizeOne( this->GetPersistence() );
-					typename M::Vector4I	seedV = M::vectorizeOne( this->GetSeed() );
+					typename MW::VectorF	persistenceV = MW::vectorizeOne( this->GetPersistence() );
+					typename MW::VectorI	seedV = MW::vectorizeOne( this->GetSeed() );
 					NoiseQuality			noiseQuality = this->GetNoiseQuality();
 
-					typename M::Vector4F	valueV = M::constZeroF();
-					typename M::Vector4F	signalV = M::constZeroF();
-					typename M::Vector4F	curPersistenceV = M::constOneF();
-					typename M::Vector4F	nxV;
-					typename M::Vector4F	nyV;
-					typename M::Vector4F	nzV;
+					typename MW::VectorF	valueV = MW::constZeroF();
+					typename MW::VectorF	signalV = MW::constZeroF();
+					typename MW::VectorF	curPersistenceV = MW::constOneF();
+					typename MW::VectorF	nxV;
+					typename MW::VectorF	nyV;
+
+					xV = MW::multiply( xV, frequencyV );
+					yV = MW::multiply( yV, frequencyV );
 
 					for( uint32 curOctave = 0; curOctave < octaveCount; curOctave++ ) 
 					{
 						// Make sure that these floating-point values have the same range as a 32-
 						// bit integer so that we can pass them to the coherent-noise functions.
-						nxV = M::makeInt32Range( xV );
-						nyV = M::makeInt32Range( yV );
-						nzV = M::makeInt32Range( zV );
+						nxV = MW::makeInt32Range( xV );
+						nyV = MW::makeInt32Range( yV );
 						
 						// Get the coherent-noise value from the input value and add it to the
 						// final result.
-						signalV = Noise::GradientCoherentNoise4( nxV, nyV, nzV, seedV, noiseQuality );
-						valueV = M::add( valueV, M::multiply( signalV, curPersistenceV ) );
+						signalV = Noise::template GradientCoherentNoiseSliceV< Width >( nxV, nyV, seedV, noiseQuality );
+						valueV = MW::add( valueV, MW::multiply( signalV, curPersistenceV ) );
 
 						// Prepare the next octave.
-						xV = M::multiply( xV, lacunarityV );
-						yV = M::multiply( yV, lacunarityV );
-						zV = M::multiply( zV, lacunarityV );
-						curPersistenceV = M::multiply( curPersistenceV, persistenceV );
-						seedV = M::add( seedV, M::constOneI() );
+						xV = MW::multiply( xV, lacunarityV );
+						yV = MW::multiply( yV, lacunarityV );
+						curPersistenceV = MW::multiply( curPersistenceV, persistenceV );
+						seedV = MW::add( seedV, MW::constOneI() );
 					}
 
-					M::storeToMemory( output, valueV );
+					return valueV;
 				}
 
 			};
@@ -423,54 +666,111 @@ namespace noise2
 					return value;
 				}
 
+				virtual
 				void
 				GetValue4( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
-						   ValueType* output )
+						   ValueType* output ) const
+				{
+					GetValueV< 4 >( inputX, inputY, inputZ, inputW, output );
+				}
+
+				// Native width points at a time, the rest padded to a full vector so that all
+				// points go through the same kernel
+				virtual
+				void
+				GetValueArray( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+							   ValueType* output, size_t count ) const
+				{
+					const uint32	Width = math::NativeWidth< ValueType >::Value;
+					size_t			i = 0;
+
+					for( ; i + Width <= count; i += Width )
+					{
+						GetValueV< Width >( inputX + i, inputY + i, inputZ + i, inputW + i, output + i );
+					}
+
+					if( i < count )
+					{
+						VECTOR4_ALIGN( ValueType	x[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	y[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	z[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	w[ Width ] ) = { 0 };
+						VECTOR4_ALIGN( ValueType	values[ Width ] );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							x[ k - i ] = inputX[ k ];
+							y[ k - i ] = inputY[ k ];
+							z[ k - i ] = inputZ[ k ];
+							w[ k - i ] = inputW[ k ];
+						}
+
+						GetValueV< Width >( x, y, z, w, values );
+
+						for( size_t k = i; k < count; ++k )
+						{
+							output[ k ] = values[ k - i ];
+						}
+					}
+				}
+
+				// Width points at once, Width a multiple of four, see math::Math
+				template< uint32 Width >
+				void
+				GetValueV( const ValueType* inputX, const ValueType* inputY, const ValueType* inputZ, const ValueType* inputW,
+						   ValueType* output ) const
 				{
-					typename M::Vector4F	xV = M::loadFromMemory( inputX );
-					typename M::Vector4F	yV = M::loadFromMemory( inputY );
-					typename M::Vector4F	zV = M::loadFromMemory( inputZ );
-					typename M::Vector4F	wV = M::loadFromMemory( inputW );
+					typedef math::Math< ValueType, Width >		MW;
+
+					typename MW::VectorF	xV = MW::loadFromMemory( inputX );
+					typename MW::VectorF	yV = MW::loadFromMemory( inputY );
+					typename MW::VectorF	zV = MW::loadFromMemory( inputZ );
+					typename MW::VectorF	wV = MW::loadFromMemory( inputW );
 
-					typename M::Vector4F	frequencyV = M::vectorizeOne( this->GetFrequency() );
-					typename M::Vector4F	lacunarityV = M::vectorizeOne( this->GetLacunarity() );
+					typename MW::VectorF	frequencyV = MW::vectorizeOne( this->GetFrequency() );
+					typename MW::VectorF	lacunarityV = MW::vectorizeOne( this->GetLacunarity() );
 					uint32					octaveCount = this->GetOctaveCount();
-					typename M::Vector4F	persistenceV = M::vectorizeOne( this->GetPersistence() );
-					typename M::Vector4I	seedV = M::vectorizeOne( this->GetSeed() );
+					typename MW::VectorF	persistenceV = MW::vectorizeOne( this->GetPersistence() );
+					typename MW::VectorI	seedV = MW::vectorizeOne( this->GetSeed() );
 					NoiseQuality			noiseQuality = this->GetNoiseQuality();
 
-					typename M::Vector4F	valueV = M::constZeroF();
-					typename M::Vector4F	signalV = M::constZeroF();
-					typename M::Vector4F	curPersistenceV = M::constOneF();
-					typename M::Vector4F	nxV;
-					typename M::Vector4F	nyV;
-					typename M::Vector4F	nzV;
-					typename M::Vector4F	nwV;
+					typename MW::VectorF	valueV = MW::constZeroF();
+					typename MW::VectorF	signalV = MW::constZeroF();
+					typename MW::VectorF	curPersistenceV = MW::constOneF();
+					typename MW::VectorF	nxV;
+					typename MW::VectorF	nyV;
+					typename MW::VectorF	nzV;
+					typename MW::VectorF	nwV;
+
+					xV = MW::multiply( xV, frequencyV );
+					yV = MW::multiply( yV, frequencyV );
+					zV = MW::multiply( zV, frequencyV );
+					wV = MW::multiply( wV, frequencyV );
 
 					for( uint32 curOctave = 0; curOctave < octaveCount; curOctave++ ) 
 					{
 						// Make sure that these floating-point values have the same range as a 32-
 						// bit integer so that we can pass them to the coherent-noise functions.
-						nxV = M::makeInt32Range( xV );
-						nyV = M::makeInt32Range( yV );
-						nzV = M::makeInt32Range( zV );
-						nwV = M::makeInt32Range( wV );
+						nxV = MW::makeInt32Range( xV );
+						nyV = MW::makeInt32Range( yV );
+						nzV = MW::makeInt32Range( zV );
+						nwV = MW::makeInt32Range( wV );
 						
 						// Get the coherent-noise value from the input value and add it to the
 						// final result.
-						signalV = Noise::GradientCoherentNoise4( nxV, nyV, nzV, nwV, seedV, noiseQuality );
-						valueV = M::add( valueV, M::multiply( signalV, curPersistenceV ) );
+						signalV = Noise::template GradientCoherentNoiseV< Width >( nxV, nyV, nzV, nwV, seedV, noiseQuality );
+						valueV = MW::add( valueV, MW::multiply( signalV, curPersistenceV ) );
 
 						// Prepare the next octave.
-						xV = M::multiply( xV, lacunarityV );
-						yV = M::multiply( yV, lacunarityV );
-						zV = M::multiply( zV, lacunarityV );
-						wV = M::multiply( wV, lacunarityV );
-						curPersistenceV = M::multiply( curPersistenceV, persistenceV );
-						seedV = M::add( seedV, M::constOneI() );
+						xV = MW::multiply( xV, lacunarityV );
+						yV = MW::multiply( yV, lacunarityV );
+						zV = MW::multiply( zV, lacunarityV );
+						wV = MW::multiply( wV, lacunarityV );
+						curPersistenceV = MW::multiply( curPersistenceV, persistenceV );
+						seedV = MW::add( seedV, MW::constOneI() );
 					}
 
-					M::storeToMemory( output, valueV );
+					MW::storeToMemory( output, valueV );
 				}
 
 			};
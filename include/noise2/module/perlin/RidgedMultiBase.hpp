@@ -22,6 +22,7 @@
 
 // libnoise
 #include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
 #include <noise2/module/perlin/NoiseGen.hpp>
 
 
@@ -267,7 +268,7 @@ namespace noise2
 					for( uint32 i = 0; i < Defaults::OctaveCountMax(); i++ )
 					{
 						// Compute weight for each frequency.
-						spectralWeights[ i ] = pow( frequency, -h );
+						spectralWeights[ i ] = math::Math< ValueType >::pow( frequency, -h );
 						frequency *= lacunarity;
 					}
 				}
@@ -0,0 +1,162 @@
+#pragma once
+
+
+// Std C++
+#include <cmath>
+
+
+// libnoise2
+#include <noise2/BasicTypes.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace proto
+	{
+
+		namespace gaborSurface
+		{
+
+			// Conservative culling of the 27 cells around a surface point. An impulse q only
+			// contributes to p when its projection lies within the unit disk and |n.(q - p)| <= 1,
+			// so it lies in a cylinder around p. A cell is kept when it intersects the ball of
+			// radius sqrt( 2 ) around p and is not separated from the box bounding the cylinder
+			// along the normal or either tangent. Normals are expected to be unit length.
+			template< typename ValueT >
+			class CellCulling
+			{
+
+			public:
+
+				typedef ValueT		ValueType;
+
+
+
+			public:
+
+				// Bit ( di + 1 ) * 9 + ( dj + 1 ) * 3 + ( dk + 1 ) is set for every cell that may
+				// contribute, p is relative to the origin of its cell
+				static inline
+				uint32
+				reachedCells( ValueType pX, ValueType pY, ValueType pZ,
+							  ValueType nX, ValueType nY, ValueType nZ )
+				{
+					// Slack for the rounding of the projection, culling stays conservative
+					const ValueType	slack = ValueType( 1e-4 );
+
+					// Tangents of the frame Projection builds with up = ( 1, 0, 0 ), both of length
+					// |( 0, nZ, -nY )| which scales their limits instead of being divided out. The
+					// frame degenerates for normals along x, the projection does not bound the disk
+					// then and the tangents are not tested.
+					ValueType	tangentLength = std::sqrt( (nY * nY) + (nZ * nZ) );
+					bool		degenerate = !(tangentLength > ValueType( 1e-3 ));
+					ValueType	axisX[ 3 ] = { nX, ValueType( 0.0 ), (nZ * nZ) + (nY * nY) };
+					ValueType	axisY[ 3 ] = { nY, nZ, -nY * nX };
+					ValueType	axisZ[ 3 ] = { nZ, -nY, -nZ * nX };
+					ValueType	axisScale[ 3 ] = { ValueType( 1.0 ), tangentLength, tangentLength };
+
+					// Distances of the cell centres from p along every axis, split per coordinate
+					ValueType	limit[ 3 ];
+					ValueType	centreX[ 3 ][ 3 ];
+					ValueType	centreY[ 3 ][ 3 ];
+					ValueType	centreZ[ 3 ][ 3 ];
+
+					for( uint32 a = 0; a < 3; ++a )
+					{
+						limit[ a ] = (ValueType( 1.0 ) + slack) * axisScale[ a ] +
+									 ValueType( 0.5 ) * (std::fabs( axisX[ a ] ) + std::fabs( axisY[ a ] ) + std::fabs( axisZ[ a ] ));
+
+						for( int32 d = -1; d <= +1; ++d )
+						{
+							centreX[ a ][ d + 1 ] = axisX[ a ] * (ValueType( d ) + ValueType( 0.5 ) - pX);
+							centreY[ a ][ d + 1 ] = axisY[ a ] * (ValueType( d ) + ValueType( 0.5 ) - pY);
+							centreZ[ a ][ d + 1 ] = axisZ[ a ] * (ValueType( d ) + ValueType( 0.5 ) - pZ);
+						}
+					}
+
+					ValueType	ballLimit = ValueType( 2.0 ) + slack;
+					ValueType	gapX[ 3 ];
+					ValueType	gapY[ 3 ];
+					ValueType	gapZ[ 3 ];
+
+					for( int32 d = -1; d <= +1; ++d )
+					{
+						gapX[ d + 1 ] = gap( pX, ValueType( d ) );
+						gapY[ d + 1 ] = gap( pY, ValueType( d ) );
+						gapZ[ d + 1 ] = gap( pZ, ValueType( d ) );
+					}
+
+					uint32	cells = 0;
+
+					for( uint32 i = 0; i < 3; ++i )
+					{
+						for( uint32 j = 0; j < 3; ++j )
+						{
+							ValueType	ballXY = (gapX[ i ] * gapX[ i ]) + (gapY[ j ] * gapY[ j ]);
+							ValueType	normalXY = centreX[ 0 ][ i ] + centreY[ 0 ][ j ];
+							ValueType	tangent0XY = centreX[ 1 ][ i ] + centreY[ 1 ][ j ];
+							ValueType	tangent1XY = centreX[ 2 ][ i ] + centreY[ 2 ][ j ];
+
+							for( uint32 k = 0; k < 3; ++k )
+							{
+								bool	reached = ((ballXY + (gapZ[ k ] * gapZ[ k ])) < ballLimit) &
+												  (std::fabs( normalXY + centreZ[ 0 ][ k ] ) <= limit[ 0 ]) &
+												  (degenerate |
+												   ((std::fabs( tangent0XY + centreZ[ 1 ][ k ] ) <= limit[ 1 ]) &
+													(std::fabs( tangent1XY + centreZ[ 2 ][ k ] ) <= limit[ 2 ])));
+
+								cells |= uint32( reached ) << ((i * 9) + (j * 3) + k);
+							}
+						}
+					}
+
+					return cells;
+				}
+
+				static inline
+				uint32
+				cellCount( uint32 cells )
+				{
+					uint32	count = 0;
+
+					for( ; cells != 0; cells &= cells - 1 )
+					{
+						++count;
+					}
+
+					return count;
+				}
+
+
+
+
+			private:
+
+				// Distance of p from the interval [ d, d + 1 ]
+				static inline
+				ValueType
+				gap( ValueType p, ValueType d )
+				{
+					if( p < d )
+					{
+						return d - p;
+					}
+
+					if( p > d + ValueType( 1.0 ) )
+					{
+						return p - (d + ValueType( 1.0 ));
+					}
+
+					return ValueType( 0.0 );
+				}
+
+			};
+
+		}
+
+	}
+
+}
@@ -6,11 +6,18 @@
 #include <iostream>
 #include <bitset>
 
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
 
 #include <noise2/math/Math.hpp>
 #include <noise2/module/gabor/GaborBase.hpp>
 #include <noise2/module/gabor/Prng.hpp>
+#include <noise2/module/gabor/Statistics.hpp>
+#include <noise2/proto/gaborSurface/CellCulling.hpp>
 #include <noise2/proto/gaborSurface/Projection_Scalar.hpp>
+#include <noise2/proto/gaborSurface/VertexBatch.hpp>
 
 
 
@@ -37,8 +44,11 @@ namespace noise2
 
 
 			private:
-				typedef module::gabor::Prng< ValueType >	PrngType;
-				typedef math::Math< ValueType >				M;
+				typedef module::gabor::Prng< ValueType >				PrngType;
+				typedef math::Math< ValueType >							M;
+				typedef gaborSurface::CellCulling< ValueType >				CullingType;
+				typedef gaborSurface::VertexOrder< ValueType >				VertexOrderType;
+				typedef gaborSurface::NeighbourhoodImpulses< ValueType >	ImpulsesType;
 
 
 
@@ -57,6 +67,11 @@ namespace noise2
 						  ValueType nX, ValueType nY, ValueType nZ ) const
 				{
 					ValueType	noise = ValueType( 0.0 );
+
+					// The frame only depends on the normal, cells move its origin
+					Projection< ValueType >	projection( nX, nY, nZ,
+														ValueType( 1.0 ), ValueType( 0.0 ), ValueType( 0.0 ),
+														ValueType( 0.0 ), ValueType( 0.0 ), ValueType( 0.0 ) );
 					
 					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
 					{
@@ -75,17 +90,25 @@ namespace noise2
 						int32		i = int( intX );
 						int32		j = int( intY );
 						int32		k = int( intZ );
+						uint32		cells = CullingType::reachedCells( fracX, fracY, fracZ, nX, nY, nZ );
+						uint32		c = 0;
+
+						LIBNOISE2_GABOR_COUNT_CELLS( 27, 27 - CullingType::cellCount( cells ) );
 
 						for( int32 di = -1; di <= +1; ++di )
 						{
 							for( int32 dj = -1; dj <= +1; ++dj )
 							{
-								for( int32 dk = -1; dk <= +1; ++dk )
+								for( int32 dk = -1; dk <= +1; ++dk, ++c )
 								{
-									noise += cell( widget,
+									if( (cells & (1u << c)) == 0 )
+									{
+										continue;
+									}
+
+									noise += cell( widget, projection,
 												   i + di, j + dj, k + dk,
-												   fracX - di, fracY - dj, fracZ - dk,
-												   nX, nY, nZ );
+												   fracX - di, fracY - dj, fracZ - dk );
 								}
 							}
 						}
@@ -94,10 +117,105 @@ namespace noise2
 					return noise / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
 				}
 
+				// GetValue of count vertices. Positions and normals are read as three consecutive values
+				// every positionStride and normalStride values, the noise is written every outputStride
+				// values. Vertices are sorted by cell and the impulses around a cell are decoded once for
+				// all of its vertices. When built with OpenMP the cells are split between all threads.
+				void
+				GetValueArray( const ValueType* positions, const ValueType* normals, ValueType* output, size_t count,
+							   size_t positionStride = 3, size_t normalStride = 3, size_t outputStride = 1 ) const
+				{
+					VertexOrderType		order;
+
+					for( size_t v = 0; v < count; ++v )
+					{
+						output[ v * outputStride ] = ValueType( 0.0 );
+					}
+
+					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
+
+						order.build( positions, positionStride, count, widget.kernelRadius );
+
+						int32	runCount = int32( order.runs.size() );
+
+#if defined( _OPENMP )
+#pragma omp parallel
+#endif
+						{
+							ImpulsesType	impulses;
+
+#if defined( _OPENMP )
+#pragma omp for schedule( dynamic, 16 )
+#endif
+							for( int32 r = 0; r < runCount; ++r )
+							{
+								const typename VertexOrderType::Run&	run = order.runs[ r ];
+								const typename VertexOrderType::Vertex&	first = order.vertices[ run.begin ];
+
+								impulses.decode( widget, first.i, first.j, first.k );
+
+								for( uint32 v = run.begin; v < run.end; ++v )
+								{
+									const typename VertexOrderType::Vertex&	vertex = order.vertices[ v ];
+									const ValueType*						n = normals + (size_t( vertex.index ) * normalStride);
+
+									output[ size_t( vertex.index ) * outputStride ] += vertexValue( widget, impulses,
+																									vertex.fracX, vertex.fracY, vertex.fracZ,
+																									n[ 0 ], n[ 1 ], n[ 2 ] );
+								}
+							}
+						}
+					}
+
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+
+					for( size_t v = 0; v < count; ++v )
+					{
+						output[ v * outputStride ] *= scale;
+					}
+				}
+
 
 
 			private:
 
+				// All impulses around the cell of one vertex, p is relative to the cell origin
+				inline
+				ValueType
+				vertexValue( const typename BaseType::PreparedWidget& widget, const ImpulsesType& impulses,
+							 ValueType pX, ValueType pY, ValueType pZ,
+							 ValueType nX, ValueType nY, ValueType nZ ) const
+				{
+					Projection< ValueType >	projection( nX, nY, nZ,
+														ValueType( 1.0 ), ValueType( 0.0 ), ValueType( 0.0 ),
+														pX, pY, pZ );
+					ValueType				noise = ValueType( 0.0 );
+
+					for( uint32 i = 0; i < impulses.count; ++i )
+					{
+						ValueType	xi = impulses.x[ i ];
+						ValueType	yi = impulses.y[ i ];
+						ValueType	zi = impulses.z[ i ];
+
+						projection.project( xi, yi, zi );
+						zi = ValueType( 1.0 ) - fabs( zi );
+
+						if( ((xi * xi) + (yi * yi)) < ValueType( 1.0 ) &&
+							zi >= ValueType( 0.0 ) )
+						{
+							ValueType	x = xi * widget.kernelRadius;
+							ValueType	y = yi * widget.kernelRadius;
+							ValueType	gaussianEnvelop = widget.K * M::exp( -M::Pi() * (widget.a * widget.a) * ((x * x) + (y * y)) );
+
+							noise += zi * gaussianEnvelop * M::cos( (x * impulses.cx[ i ]) + (y * impulses.cy[ i ]) );
+						}
+					}
+
+					return noise;
+				}
+
 				inline
 				ValueType
 				gabor( float K, float a, float F0, float omega0, float x, float y ) const
@@ -112,10 +230,9 @@ namespace noise2
 
 				inline
 				ValueType
-				cell( const typename BaseType::PreparedWidget& widget,
+				cell( const typename BaseType::PreparedWidget& widget, Projection< ValueType >& projection,
 					  int32 i, int32 j, int32 k,
-					  ValueType pX, ValueType pY, ValueType pZ,
-					  ValueType nX, ValueType nY, ValueType nZ ) const
+					  ValueType pX, ValueType pY, ValueType pZ ) const
 				{
 					uint32	s = morton( i, j, k ) + widget.seed;
 					
@@ -128,9 +245,7 @@ namespace noise2
 					uint32		numberOfImpulses = prng.poisson( numberOfImpulsesPerCell );
 					ValueType	noise = ValueType( 0.0 );
 
-					Projection< ValueType >	projection( nX, nY, nZ,
-														ValueType( 1.0 ), ValueType( 0.0 ), ValueType( 0.0 ),
-														pX, pY, pZ );
+					projection.setOrigin( pX, pY, pZ );
 
 					for( uint32 i = 0; i < numberOfImpulses; ++i)
 					{
@@ -159,7 +274,8 @@ namespace noise2
 				{
 					uint32	m = uint32( 0x0 );
 
-					for( uint32 i = 0; i < (2 * CHAR_BIT); ++i )
+					// Higher bits would be shifted out of the code, z of bit 10 already is
+					for( uint32 i = 0; i < 11; ++i )
 					{
 						m |= ((x & (1 << i)) << (2*i)) | ((y & (1 << i)) << ((2*i) + 1)) | ((z & (1 << i)) << ((2*i) + 2));
 					}
@@ -5,11 +5,18 @@
 #include <cmath>
 #include <iostream>
 
+#if defined( _OPENMP )
+#include <omp.h>
+#endif
+
 
 #include <noise2/math/Math.hpp>
 #include <noise2/module/gabor/GaborBase.hpp>
 #include <noise2/module/gabor/PrngVector.hpp>
+#include <noise2/module/gabor/Statistics.hpp>
+#include <noise2/proto/gaborSurface/CellCulling.hpp>
 #include <noise2/proto/gaborSurface/Projection_Vector.hpp>
+#include <noise2/proto/gaborSurface/VertexBatch.hpp>
 
 #include <noise2/debug/Debug.hpp>
 
@@ -25,6 +32,7 @@ namespace noise2
 		namespace gaborSurface
 		{
 
+			// Four lanes only, on the same PrngVector as module::gabor::GaborImpl
 			template< typename ValueT >
 			class GaborSurfaceImpl< ValueT, 4 >: public module::gabor::GaborBase< ValueT >
 			{
@@ -38,8 +46,11 @@ namespace noise2
 
 
 			private:
-				typedef module::gabor::PrngVector< ValueType >		PrngVectorType;
-				typedef math::Math< ValueType >						M;
+				typedef module::gabor::PrngVector< ValueType >				PrngVectorType;
+				typedef math::Math< ValueType >								M;
+				typedef gaborSurface::CellCulling< ValueType >				CullingType;
+				typedef gaborSurface::VertexOrder< ValueType >				VertexOrderType;
+				typedef gaborSurface::NeighbourhoodImpulses< ValueType >	ImpulsesType;
 
 
 
@@ -59,6 +70,9 @@ namespace noise2
 				{
 					ValueType	noise = ValueType( 0.0 );
 
+					// The frame only depends on the normal, cells move its origin
+					ProjectionVector< ValueType >	projection( M::vectorizeOne( nX ), M::vectorizeOne( nY ), M::vectorizeOne( nZ ) );
+
 					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
 					{
 						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
@@ -70,74 +84,292 @@ namespace noise2
 						ValueType	intX = M::floor( widgetPX );
 						ValueType	intY = M::floor( widgetPY );
 						ValueType	intZ = M::floor( widgetPZ );
+						ValueType	fracX = widgetPX - intX;
+						ValueType	fracY = widgetPY - intY;
+						ValueType	fracZ = widgetPZ - intZ;
 						int32		i = int( intX );
 						int32		j = int( intY );
 						int32		k = int( intZ );
 
-						typename M::Vector4F	nxV = M::vectorizeOne( nX );
-						typename M::Vector4F	nyV = M::vectorizeOne( nY );
-						typename M::Vector4F	nzV = M::vectorizeOne( nZ );
-						typename M::Vector4F	fracXV = M::vectorizeOne( widgetPX - intX );
-						typename M::Vector4F	fracYV = M::vectorizeOne( widgetPY - intY );
-						typename M::Vector4F	fracZV = M::vectorizeOne( widgetPZ - intZ );
-
-						static VECTOR4_ALIGN( int32		diA[ 28 ] ) = { -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1,  1,  1,  1,  1,  1,  1,  1,  1,  0 };
-						static VECTOR4_ALIGN( int32		djA[ 28 ] ) = { -1, -1, -1,  0,  0,  0,  1,  1,  1, -1, -1, -1,  0,  0,  0,  1,  1,  1, -1, -1, -1,  0,  0,  0,  1,  1,  1,  0 };
-						static VECTOR4_ALIGN( int32		dkA[ 28 ] ) = { -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1, -1,  0,  1,  0 };
-
-						typename M::Vector4I		iV = M::vectorizeOne( i );
-						typename M::Vector4I		jV = M::vectorizeOne( j );
-						typename M::Vector4I		kV = M::vectorizeOne( k );
-
-						typename M::Vector4I	diV;
-						typename M::Vector4I	djV;
-						typename M::Vector4I	dkV;
-						typename M::Vector4I	diiV;
-						typename M::Vector4I	djjV;
-						typename M::Vector4I	dkkV;
-						typename M::Vector4F	xV;
-						typename M::Vector4F	yV;
-						typename M::Vector4F	zV;
-						typename M::Vector4I	mortonV;
-						for( int32 m = 0; m < 6; ++m )
+						// Offsets of the cells which survived culling, evaluated four at a time
+						uint32		cells = CullingType::reachedCells( fracX, fracY, fracZ, nX, nY, nZ );
+						uint32		cellCount = 0;
+
+						VECTOR4_ALIGN( int32	diA[ 28 ] );
+						VECTOR4_ALIGN( int32	djA[ 28 ] );
+						VECTOR4_ALIGN( int32	dkA[ 28 ] );
+
+						for( uint32 c = 0; c < 27; ++c )
+						{
+							if( (cells & (1u << c)) != 0 )
+							{
+								diA[ cellCount ] = int32( c / 9 ) - 1;
+								djA[ cellCount ] = int32( (c / 3) % 3 ) - 1;
+								dkA[ cellCount ] = int32( c % 3 ) - 1;
+								++cellCount;
+							}
+						}
+
+						for( uint32 c = cellCount; c < ((cellCount + 3) & ~3u); ++c )
 						{
-							diV = M::loadFromMemory( diA + (m * 4) );
-							djV = M::loadFromMemory( djA + (m * 4) );
-							dkV = M::loadFromMemory( dkA + (m * 4) );
-							diiV = M::add( diV, iV );
-							djjV = M::add( djV, jV );
-							dkkV = M::add( dkV, kV );
-							xV = M::subtract( fracXV, M::intToFloat( diV ) );
-							yV = M::subtract( fracYV, M::intToFloat( djV ) );
-							zV = M::subtract( fracZV, M::intToFloat( dkV ) );
-							mortonV = mortonVectorized( widget, diiV, djjV, dkkV );
-							
-							noise += cellVectorized( widget, mortonV, xV, yV, zV, nxV, nyV, nzV, M::constFullMaskI() );
+							diA[ c ] = 0;
+							djA[ c ] = 0;
+							dkA[ c ] = 0;
 						}
+
+						LIBNOISE2_GABOR_COUNT_CELLS( 27, 27 - cellCount );
+
+						typename M::Vector4F	fracXV = M::vectorizeOne( fracX );
+						typename M::Vector4F	fracYV = M::vectorizeOne( fracY );
+						typename M::Vector4F	fracZV = M::vectorizeOne( fracZ );
+
+						static VECTOR4_ALIGN( int32		laneA[ 4 ] ) = { 0, 1, 2, 3 };
+
+						typename M::Vector4I	iV = M::vectorizeOne( i );
+						typename M::Vector4I	jV = M::vectorizeOne( j );
+						typename M::Vector4I	kV = M::vectorizeOne( k );
+						typename M::Vector4I	laneV = M::loadFromMemory( laneA );
+
+						for( uint32 c = 0; c < cellCount; c += 4 )
 						{
-							diV = M::loadFromMemory( diA + (6 * 4) );
-							djV = M::loadFromMemory( djA + (6 * 4) );
-							dkV = M::loadFromMemory( dkA + (6 * 4) );
-							diiV = M::add( diV, iV );
-							djjV = M::add( djV, jV );
-							dkkV = M::add( dkV, kV );
-							xV = M::subtract( fracXV, M::intToFloat( diV ) );
-							yV = M::subtract( fracYV, M::intToFloat( djV ) );
-							zV = M::subtract( fracZV, M::intToFloat( dkV ) );
-							mortonV = mortonVectorized( widget, diiV, djjV, dkkV );
-							
-							static VECTOR4_ALIGN( uint32	cell3MaskA[ 4 ] ) = { 0xffffffff, 0xffffffff, 0xffffffff, 0x0 };
-							noise += cellVectorized( widget, mortonV, xV, yV, zV, nxV, nyV, nzV, M::loadFromMemory( cell3MaskA ) );
+							typename M::Vector4I	diV = M::loadFromMemory( diA + c );
+							typename M::Vector4I	djV = M::loadFromMemory( djA + c );
+							typename M::Vector4I	dkV = M::loadFromMemory( dkA + c );
+							typename M::Vector4F	xV = M::subtract( fracXV, M::intToFloat( diV ) );
+							typename M::Vector4F	yV = M::subtract( fracYV, M::intToFloat( djV ) );
+							typename M::Vector4F	zV = M::subtract( fracZV, M::intToFloat( dkV ) );
+							typename M::Vector4I	mortonV = mortonVectorized( widget, M::add( diV, iV ), M::add( djV, jV ), M::add( dkV, kV ) );
+							typename M::Vector4I	cellMaskV = M::greaterThan( M::vectorizeOne( int32( cellCount - c ) ), laneV );
+
+							noise += cellVectorized( widget, projection, mortonV, xV, yV, zV, cellMaskV );
 						}
 					}
 
 					return noise / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
 				}
 
+				// GetValue of count vertices. Positions and normals are read as three consecutive values
+				// every positionStride and normalStride values, the noise is written every outputStride
+				// values. Vertices are sorted by cell and the impulses around a cell are decoded once for
+				// all of its vertices. When built with OpenMP the cells are split between all threads.
+				void
+				GetValueArray( const ValueType* positions, const ValueType* normals, ValueType* output, size_t count,
+							   size_t positionStride = 3, size_t normalStride = 3, size_t outputStride = 1 ) const
+				{
+					VertexOrderType		order;
+
+					for( size_t v = 0; v < count; ++v )
+					{
+						output[ v * outputStride ] = ValueType( 0.0 );
+					}
+
+					for( size_t w = 0; w < this->preparedWidgets.size(); ++w )
+					{
+						const typename BaseType::PreparedWidget&	widget = this->preparedWidgets[ w ];
+
+						order.build( positions, positionStride, count, widget.kernelRadius );
+
+						int32	runCount = int32( order.runs.size() );
+
+#if defined( _OPENMP )
+#pragma omp parallel
+#endif
+						{
+							ImpulsesType	impulses;
+
+#if defined( _OPENMP )
+#pragma omp for schedule( dynamic, 16 )
+#endif
+							for( int32 r = 0; r < runCount; ++r )
+							{
+								const typename VertexOrderType::Run&	run = order.runs[ r ];
+								const typename VertexOrderType::Vertex&	first = order.vertices[ run.begin ];
+
+								impulses.decode( widget, first.i, first.j, first.k );
+
+								// The frames of four vertices are built at once, missing lanes repeat the first vertex
+								for( uint32 v = run.begin; v < run.end; v += 4 )
+								{
+									uint32		lanes = (run.end - v) < 4 ? (run.end - v) : 4;
+
+									VECTOR4_ALIGN( typename M::ScalarF	normalA[ 3 * 4 ] );
+									VECTOR4_ALIGN( typename M::ScalarF	frameA[ 9 * 4 ] );
+
+									for( uint32 l = 0; l < 4; ++l )
+									{
+										const ValueType*	n = normals + (size_t( order.vertices[ v + (l < lanes ? l : 0) ].index ) * normalStride);
+
+										normalA[ (0 * 4) + l ] = n[ 0 ];
+										normalA[ (1 * 4) + l ] = n[ 1 ];
+										normalA[ (2 * 4) + l ] = n[ 2 ];
+									}
+
+									ProjectionVector< ValueType >	frames( M::loadFromMemory( normalA + (0 * 4) ),
+																			M::loadFromMemory( normalA + (1 * 4) ),
+																			M::loadFromMemory( normalA + (2 * 4) ) );
+									frames.storeFrames( frameA );
+
+									for( uint32 l = 0; l < lanes; ++l )
+									{
+										const typename VertexOrderType::Vertex&	vertex = order.vertices[ v + l ];
+										ProjectionVector< ValueType >			projection( frameA, l );
+
+										output[ size_t( vertex.index ) * outputStride ] += vertexValue( widget, impulses, projection,
+																										vertex.fracX, vertex.fracY, vertex.fracZ );
+									}
+								}
+							}
+						}
+					}
+
+					ValueType	scale = ValueType( 1.0 ) / (ValueType( 3.0 ) * std::sqrt( this->combinedVariance ));
+
+					for( size_t v = 0; v < count; ++v )
+					{
+						output[ v * outputStride ] *= scale;
+					}
+				}
+
 
 
 			private:
 
+				// Impulses of GetValueArray which passed the projection tests, evaluated four at a time
+				struct
+				Batcher
+				{
+
+					VECTOR4_ALIGN( typename M::ScalarF	xA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	yA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	wiA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	cxA[ 8 ] );
+					VECTOR4_ALIGN( typename M::ScalarF	cyA[ 8 ] );
+					uint32								count;
+
+					inline
+					Batcher():
+					  count( 0 )
+					{
+						for( uint32 i = 0; i < 8; ++i )
+						{
+							xA[ i ] = ValueType( 0.0 );
+							yA[ i ] = ValueType( 0.0 );
+							wiA[ i ] = ValueType( 0.0 );
+							cxA[ i ] = ValueType( 0.0 );
+							cyA[ i ] = ValueType( 0.0 );
+						}
+					}
+
+					// Appends the lanes set in calcMaskV, returns true once a full batch is available
+					inline
+					bool
+					push( const typename M::Vector4F& xV, const typename M::Vector4F& yV, const typename M::Vector4F& wiV,
+						  const typename M::Vector4F& cxV, const typename M::Vector4F& cyV, const typename M::Vector4I& calcMaskV )
+					{
+						int32	mask = M::moveMask( calcMaskV );
+
+						if( mask == 0 )
+						{
+							return false;
+						}
+
+						M::storeToMemoryUnaligned( xA + count, M::compact( xV, mask ) );
+						M::storeToMemoryUnaligned( yA + count, M::compact( yV, mask ) );
+						M::storeToMemoryUnaligned( wiA + count, M::compact( wiV, mask ) );
+						M::storeToMemoryUnaligned( cxA + count, M::compact( cxV, mask ) );
+						M::storeToMemoryUnaligned( cyA + count, M::compact( cyV, mask ) );
+						count += M::maskLaneCount( mask );
+
+						return count >= 4;
+					}
+
+					// Evaluates the first batch, or the remaining partial batch when flushing
+					inline
+					typename M::Vector4F
+					pop( const typename BaseType::PreparedWidget& widget )
+					{
+						static VECTOR4_ALIGN( int32		laneA[ 4 ] ) = { 0, 1, 2, 3 };
+
+						typename M::Vector4I	calcMaskV = M::greaterThan( M::vectorizeOne( int32( count ) ), M::loadFromMemory( laneA ) );
+						typename M::Vector4F	kernelRadiusV = M::vectorizeOne( widget.kernelRadius );
+						typename M::Vector4F	xV = M::multiply( M::loadFromMemory( xA ), kernelRadiusV );
+						typename M::Vector4F	yV = M::multiply( M::loadFromMemory( yA ), kernelRadiusV );
+
+						typename M::Vector4F	envelopeV = M::multiply( M::constMinusPiF(), M::vectorizeOne( widget.a * widget.a ) );
+						envelopeV = M::exp( M::multiply( envelopeV, M::add( M::multiply( xV, xV ), M::multiply( yV, yV ) ) ) );
+
+						typename M::Vector4F	carrierV = M::add( M::multiply( xV, M::loadFromMemory( cxA ) ), M::multiply( yV, M::loadFromMemory( cyA ) ) );
+						carrierV = M::cos( carrierV );
+
+						typename M::Vector4F	noiseV = M::multiply( M::multiply( M::vectorizeOne( widget.K ), M::loadFromMemory( wiA ) ),
+																	  M::multiply( envelopeV, carrierV ) );
+						noiseV = M::select( noiseV, calcMaskV );
+
+						if( count > 4 )
+						{
+							M::storeToMemory( xA, M::loadFromMemory( xA + 4 ) );
+							M::storeToMemory( yA, M::loadFromMemory( yA + 4 ) );
+							M::storeToMemory( wiA, M::loadFromMemory( wiA + 4 ) );
+							M::storeToMemory( cxA, M::loadFromMemory( cxA + 4 ) );
+							M::storeToMemory( cyA, M::loadFromMemory( cyA + 4 ) );
+							count -= 4;
+						}
+						else
+						{
+							count = 0;
+						}
+
+						return noiseV;
+					}
+
+				};
+
+				// All impulses around the cell of one vertex, p is relative to the cell origin. The
+				// projection holds the frame of the vertex and four impulses are projected at a time.
+				inline
+				ValueType
+				vertexValue( const typename BaseType::PreparedWidget& widget, const ImpulsesType& impulses,
+							 ProjectionVector< ValueType > projection,
+							 ValueType pX, ValueType pY, ValueType pZ ) const
+				{
+					projection.setOrigin( M::vectorizeOne( pX ), M::vectorizeOne( pY ), M::vectorizeOne( pZ ) );
+
+					Batcher							batcher;
+					typename M::Vector4F			noiseV = M::constZeroF();
+
+					for( uint32 i = 0; i < impulses.paddedCount; i += 4 )
+					{
+						typename M::Vector4F	xiV = M::loadFromMemory( impulses.x.data() + i );
+						typename M::Vector4F	yiV = M::loadFromMemory( impulses.y.data() + i );
+						typename M::Vector4F	ziV = M::loadFromMemory( impulses.z.data() + i );
+
+						projection.project( xiV, yiV, ziV );
+						ziV = M::subtract( M::constOneF(), M::abs( ziV ) );
+
+						typename M::Vector4F	radiusV = M::add( M::multiply( xiV, xiV ), M::multiply( yiV, yiV ) );
+						typename M::Vector4I	calcMaskV = M::bitAnd( M::castToInt( M::lowerThan( radiusV, M::constOneF() ) ),
+																	   M::castToInt( M::equalGreaterThan( ziV, M::constZeroF() ) ) );
+
+						if( batcher.push( xiV, yiV, ziV,
+										  M::loadFromMemory( impulses.cx.data() + i ),
+										  M::loadFromMemory( impulses.cy.data() + i ),
+										  calcMaskV ) == true )
+						{
+							noiseV = M::add( noiseV, batcher.pop( widget ) );
+						}
+					}
+
+					if( batcher.count > 0 )
+					{
+						noiseV = M::add( noiseV, batcher.pop( widget ) );
+					}
+
+					VECTOR4_ALIGN( typename M::ScalarF		noiseA[ 4 ] );
+					M::storeToMemory( noiseA, noiseV );
+
+					return noiseA[ 0 ] + noiseA[ 1 ] + noiseA[ 2 ] + noiseA[ 3 ];
+				}
+
 				struct
 				Compacter
 				{
@@ -232,10 +464,9 @@ namespace noise2
 
 				inline
 				ValueType
-				cellVectorized( const typename BaseType::PreparedWidget& widget,
+				cellVectorized( const typename BaseType::PreparedWidget& widget, ProjectionVector< ValueType >& projection,
 								const typename M::Vector4I sV,
 								const typename M::Vector4F pxV, const typename M::Vector4F pyV, const typename M::Vector4F pzV,
-								const typename M::Vector4F nxV, const typename M::Vector4F nyV, const typename M::Vector4F nzV,
 								const typename M::Vector4I cellMaskV ) const
 				{
 					Compacter	compacter;
@@ -252,8 +483,7 @@ namespace noise2
 					M::storeToMemory( numberOfImpulsesA, numberOfImpulsesV );
 					uint32	maxNumberOfImpulses = findMax( numberOfImpulsesA );
 					
-					ProjectionVector< ValueType >	projection( nxV, nyV, nzV,
-																pxV, pyV, pzV );
+					projection.setOrigin( pxV, pyV, pzV );
 
 					typename M::Vector4F	noiseV = M::constZeroF();
 					for( uint32 i = 0; i < maxNumberOfImpulses; ++i )
@@ -336,7 +566,8 @@ namespace noise2
 					typename M::Vector4I		oneV = M::constOneI();
 					typename M::Vector4I		seedV = M::vectorizeOne( widget.seed );
 
-					for( uint32 i = 0; i < (2 * CHAR_BIT); ++i )
+					// Higher bits would be shifted out of the code
+					for( uint32 i = 0; i < 11; ++i )
 					{
 						typename M::Vector4I		xPart = M::shiftLeftLogical( oneV, i );
 						xPart = M::bitAnd( xPart, xV );
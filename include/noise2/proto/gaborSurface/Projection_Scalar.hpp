@@ -1,6 +1,9 @@
 #pragma once
 
 
+#include <cmath>
+
+
 
 
 namespace noise2
@@ -33,6 +36,12 @@ namespace noise2
 					view = -view;
 				}
 
+				void
+				setOrigin( ValueType pX, ValueType pY, ValueType pZ )
+				{
+					p = Vec3( pX, pY, pZ );
+				}
+
 				void
 				project( ValueType& projX, ValueType& projY, ValueType& projZ )
 				{
@@ -92,7 +101,7 @@ namespace noise2
 					void
 					normalize()
 					{
-						float	length = std::sqrt( (this->x * this->x) + (this->y * this->y) + (this->z * this->z) );
+						ValueType	length = std::sqrt( (this->x * this->x) + (this->y * this->y) + (this->z * this->z) );
 						
 						this->x = this->x / length;
 						this->y = this->y / length;
@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <noise2/BasicTypes.hpp>
 #include <noise2/math/Math.hpp>
 
 
@@ -15,6 +16,8 @@ namespace noise2
 		namespace gaborSurface
 		{
 
+			// Tangent frames of four views, one per lane, built together. The origin is kept
+			// apart from the frame, so one frame can project around many points.
 			template< typename ValueType >
 			class ProjectionVector
 			{
@@ -31,12 +34,44 @@ namespace noise2
 				  up( M::constOneF(), M::constZeroF(), M::constZeroF() ),
 				  p( pXV, pYV, pZV )
 				{
-					left = view.cross( up );
-					left.normalize();
+					buildFrame();
+				}
 
-					up = left.cross( view );
+				ProjectionVector( const typename M::Vector4F& viewXV, const typename M::Vector4F& viewYV, const typename M::Vector4F& viewZV ):
+				  view( viewXV, viewYV, viewZV ),
+				  up( M::constOneF(), M::constZeroF(), M::constZeroF() )
+				{
+					buildFrame();
+				}
 
-					view = -view;
+				// The frame of one lane of frameA, as stored by storeFrames, in all four lanes
+				// with the origin at zero
+				ProjectionVector( const ValueType* frameA, uint32 lane ):
+				  view( M::vectorizeOne( frameA[ (6 * 4) + lane ] ), M::vectorizeOne( frameA[ (7 * 4) + lane ] ), M::vectorizeOne( frameA[ (8 * 4) + lane ] ) ),
+				  up( M::vectorizeOne( frameA[ (3 * 4) + lane ] ), M::vectorizeOne( frameA[ (4 * 4) + lane ] ), M::vectorizeOne( frameA[ (5 * 4) + lane ] ) ),
+				  left( M::vectorizeOne( frameA[ (0 * 4) + lane ] ), M::vectorizeOne( frameA[ (1 * 4) + lane ] ), M::vectorizeOne( frameA[ (2 * 4) + lane ] ) )
+				{
+				}
+
+				// Stores left, up and view as nine aligned rows of four lanes
+				void
+				storeFrames( ValueType* frameA ) const
+				{
+					M::storeToMemory( frameA + (0 * 4), left.x );
+					M::storeToMemory( frameA + (1 * 4), left.y );
+					M::storeToMemory( frameA + (2 * 4), left.z );
+					M::storeToMemory( frameA + (3 * 4), up.x );
+					M::storeToMemory( frameA + (4 * 4), up.y );
+					M::storeToMemory( frameA + (5 * 4), up.z );
+					M::storeToMemory( frameA + (6 * 4), view.x );
+					M::storeToMemory( frameA + (7 * 4), view.y );
+					M::storeToMemory( frameA + (8 * 4), view.z );
+				}
+
+				void
+				setOrigin( const typename M::Vector4F& pXV, const typename M::Vector4F& pYV, const typename M::Vector4F& pZV )
+				{
+					p = Vec3( pXV, pYV, pZV );
 				}
 
 				void
@@ -52,6 +87,22 @@ namespace noise2
 
 
 
+			private:
+
+				inline
+				void
+				buildFrame()
+				{
+					left = view.cross( up );
+					left.normalize();
+
+					up = left.cross( view );
+
+					view = -view;
+				}
+
+
+
 			private:
 
 				struct Vec3
@@ -116,11 +167,11 @@ namespace noise2
 					void
 					normalize()
 					{
-						typename M::Vector4F	length = M::sqrtRecip( this->dot( *this ) );
-						
-						this->x = M::divide( this->x, length );
-						this->y = M::divide( this->y, length );
-						this->z = M::divide( this->z, length );
+						typename M::Vector4F	lengthRecip = M::reciprocalSqrt( this->dot( *this ) );
+
+						this->x = M::multiply( this->x, lengthRecip );
+						this->y = M::multiply( this->y, lengthRecip );
+						this->z = M::multiply( this->z, lengthRecip );
 					}
 
 					typename M::Vector4F x;
@@ -0,0 +1,285 @@
+#pragma once
+
+
+// Std C++
+#include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <vector>
+
+
+// libnoise2
+#include <noise2/BasicTypes.hpp>
+#include <noise2/math/Math.hpp>
+#include <noise2/memory/AlignedArray.hpp>
+#include <noise2/module/gabor/Prng.hpp>
+
+
+
+
+namespace noise2
+{
+
+	namespace proto
+	{
+
+		namespace gaborSurface
+		{
+
+			// Vertices of a batch sorted by the kernel-radius sized cell they fall into, so that
+			// every run of vertices sharing a cell can share its neighbourhood impulses
+			template< typename ValueT >
+			class VertexOrder
+			{
+
+			public:
+
+				typedef ValueT		ValueType;
+
+				struct Vertex
+				{
+					int32		i;
+					int32		j;
+					int32		k;
+					uint32		index;
+					// Position inside the cell, in cell units
+					ValueType	fracX;
+					ValueType	fracY;
+					ValueType	fracZ;
+
+					inline
+					bool
+					operator < ( const Vertex& other ) const
+					{
+						if( i != other.i )
+						{
+							return i < other.i;
+						}
+
+						if( j != other.j )
+						{
+							return j < other.j;
+						}
+
+						return k < other.k;
+					}
+
+					inline
+					bool
+					sameCell( const Vertex& other ) const
+					{
+						return i == other.i && j == other.j && k == other.k;
+					}
+				};
+
+				struct Run
+				{
+					uint32	begin;
+					uint32	end;
+				};
+
+
+
+			public:
+
+				std::vector< Vertex >	vertices;
+				std::vector< Run >		runs;
+
+
+
+			private:
+
+				typedef math::Math< ValueType >		M;
+
+
+
+			public:
+
+				void
+				build( const ValueType* positions, size_t positionStride, size_t count, ValueType kernelRadius )
+				{
+					vertices.resize( count );
+					runs.clear();
+
+					for( size_t v = 0; v < count; ++v )
+					{
+						const ValueType*	p = positions + (v * positionStride);
+						ValueType			cellX = p[ 0 ] / kernelRadius;
+						ValueType			cellY = p[ 1 ] / kernelRadius;
+						ValueType			cellZ = p[ 2 ] / kernelRadius;
+						ValueType			intX = M::floor( cellX );
+						ValueType			intY = M::floor( cellY );
+						ValueType			intZ = M::floor( cellZ );
+
+						vertices[ v ].i = int32( intX );
+						vertices[ v ].j = int32( intY );
+						vertices[ v ].k = int32( intZ );
+						vertices[ v ].index = uint32( v );
+						vertices[ v ].fracX = cellX - intX;
+						vertices[ v ].fracY = cellY - intY;
+						vertices[ v ].fracZ = cellZ - intZ;
+					}
+
+					std::sort( vertices.begin(), vertices.end() );
+
+					for( size_t v = 0; v < count; )
+					{
+						size_t	e = v + 1;
+						while( e < count && vertices[ e ].sameCell( vertices[ v ] ) )
+						{
+							++e;
+						}
+
+						Run		run;
+						run.begin = uint32( v );
+						run.end = uint32( e );
+						runs.push_back( run );
+
+						v = e;
+					}
+				}
+
+			};
+
+
+			// Impulses of the 27 cells around one cell, decoded with the same draws as
+			// GaborSurfaceImpl::cell. Positions are relative to the origin of the centre cell,
+			// the carrier is stored as 2 * pi * F0 * ( cos( omega0 ), sin( omega0 ) ). Arrays
+			// are padded to a multiple of four with impulses far outside of any kernel.
+			template< typename ValueT >
+			class NeighbourhoodImpulses
+			{
+
+			public:
+
+				typedef ValueT		ValueType;
+
+
+
+			public:
+
+				memory::AlignedArray< ValueType >	x;
+				memory::AlignedArray< ValueType >	y;
+				memory::AlignedArray< ValueType >	z;
+				memory::AlignedArray< ValueType >	cx;
+				memory::AlignedArray< ValueType >	cy;
+				uint32								count;
+				uint32								paddedCount;
+
+
+
+			private:
+
+				typedef module::gabor::Prng< ValueType >	PrngType;
+				typedef math::Math< ValueType >				M;
+
+
+
+			public:
+
+				inline
+				NeighbourhoodImpulses():
+				  count( 0 ),
+				  paddedCount( 0 )
+				{
+				}
+
+				template< typename WidgetType >
+				void
+				decode( const WidgetType& widget, int32 i, int32 j, int32 k )
+				{
+					ValueType	numberOfImpulsesPerCell = widget.impulseDensity * widget.kernelRadius * widget.kernelRadius / ValueType( 2.0 );
+
+					count = 0;
+
+					for( int32 di = -1; di <= +1; ++di )
+					{
+						for( int32 dj = -1; dj <= +1; ++dj )
+						{
+							for( int32 dk = -1; dk <= +1; ++dk )
+							{
+								uint32	s = morton( i + di, j + dj, k + dk ) + widget.seed;
+
+								if( s == 0 )
+									s = 1;
+
+								PrngType	prng( s );
+								uint32		numberOfImpulses = prng.poisson( numberOfImpulsesPerCell );
+
+								reserve( count + numberOfImpulses );
+
+								for( uint32 n = 0; n < numberOfImpulses; ++n, ++count )
+								{
+									x[ count ] = prng.uniformNormalized() + ValueType( di );
+									y[ count ] = prng.uniformNormalized() + ValueType( dj );
+									z[ count ] = prng.uniformNormalized() + ValueType( dk );
+
+									ValueType	F0 = prng.uniformRange( widget.frequencyRangeStart, widget.frequencyRangeEnd );
+									ValueType	omega0 = prng.uniformRange( widget.angularRangeStart, widget.angularRangeEnd );
+									ValueType	omega0Sin;
+									ValueType	omega0Cos;
+									M::sinCos( omega0, omega0Sin, omega0Cos );
+
+									cx[ count ] = ValueType( 2.0 ) * M::Pi() * F0 * omega0Cos;
+									cy[ count ] = ValueType( 2.0 ) * M::Pi() * F0 * omega0Sin;
+								}
+							}
+						}
+					}
+
+					paddedCount = (count + 3) & ~3u;
+					reserve( paddedCount );
+
+					for( uint32 n = count; n < paddedCount; ++n )
+					{
+						x[ n ] = ValueType( 1000.0 );
+						y[ n ] = ValueType( 1000.0 );
+						z[ n ] = ValueType( 1000.0 );
+						cx[ n ] = ValueType( 0.0 );
+						cy[ n ] = ValueType( 0.0 );
+					}
+				}
+
+
+
+			private:
+
+				inline
+				void
+				reserve( uint32 size )
+				{
+					if( size > x.size() )
+					{
+						size_t	grown = size * 2;
+
+						x.resize( grown );
+						y.resize( grown );
+						z.resize( grown );
+						cx.resize( grown );
+						cy.resize( grown );
+					}
+				}
+
+				// Same cell code as GaborSurfaceImpl::morton
+				static inline
+				uint32
+				morton( uint32 x, uint32 y, uint32 z )
+				{
+					uint32	m = uint32( 0x0 );
+
+					// Higher bits would be shifted out of the code, z of bit 10 already is
+					for( uint32 i = 0; i < 11; ++i )
+					{
+						m |= ((x & (1 << i)) << (2*i)) | ((y & (1 << i)) << ((2*i) + 1)) | ((z & (1 << i)) << ((2*i) + 2));
+					}
+
+					return m;
+				}
+
+			};
+
+		}
+
+	}
+
+}